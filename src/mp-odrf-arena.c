@@ -0,0 +1,251 @@
+/*
+  Part of: Multiple Precision One-Dimensional Root-Finding
+  Contents: bump arenas for GMP and MPFR allocations
+  Date: Fri Oct 16, 2026
+
+  Abstract
+
+	This module implements arenas from which GMP, MPFR and the user
+	callbacks  allocate their  temporary  memory while  a solver  is
+	iterating.   An arena  is a  single  memory block:  allocating is
+	bumping an offset, releasing the last block lowers it back, every
+	other release is a no-op; the whole arena is emptied when a solve
+	completes.
+
+	GMP  has a single  set of  memory functions  for the  process, so
+	the first time an arena is allocated we install trampolines which
+	look at a thread-local pointer to the active arena: when there is
+	none, or the arena is full, or the block does not belong to it,
+	they forward the request to the  functions that were installed
+	before.  Threads without an active arena are not affected.
+
+  Copyright (C) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+  This program is  free software: you can redistribute  it and/or modify
+  it under the  terms of the GNU General Public  License as published by
+  the Free Software Foundation, either version  3 of the License, or (at
+  your option) any later version.
+
+  This program  is distributed in the  hope that it will  be useful, but
+  WITHOUT   ANY  WARRANTY;   without  even   the  implied   warranty  of
+  MERCHANTABILITY  or FITNESS  FOR A  PARTICULAR  PURPOSE.   See the  GNU
+  General Public License for more details.
+
+  You should  have received  a copy  of the  GNU General  Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#include "mp-odrf-internals.h"
+#include <string.h>
+
+struct mp_odrf_arena_t {
+  const mp_odrf_allocator_t *	allocator;
+  size_t			capacity;
+  /* Offset of the first free byte. */
+  size_t			top;
+  /* Number of requests forwarded because the arena was full. */
+  size_t			overflows;
+  /* The memory of the arena; it is in the same block of the struct. */
+  char *			base;
+};
+
+/* The arena active in this thread, or NULL. */
+static __thread mp_odrf_arena_t *	current_arena = NULL;
+
+/* The GMP memory functions installed before the trampolines. */
+static void *	(*next_alloc)	(size_t size);
+static void *	(*next_realloc)	(void * ptr, size_t old_size, size_t new_size);
+static void	(*next_free)	(void * ptr, size_t size);
+
+
+/** --------------------------------------------------------------------
+ ** Helpers: bump allocation.
+ ** ----------------------------------------------------------------- */
+
+static int
+arena_owns (const mp_odrf_arena_t * arena, const void * ptr)
+{
+  const char *	p = ptr;
+  return (arena->base <= p) && (p < arena->base + arena->capacity);
+}
+static void *
+arena_bump (mp_odrf_arena_t * arena, size_t size)
+/* Return a block of SIZE bytes, or NULL if the arena is full. */
+{
+  size_t	aligned = MP_ODRF_ALIGN(size);
+  if (aligned <= arena->capacity - arena->top) {
+    void *	ptr = arena->base + arena->top;
+    arena->top += aligned;
+    return ptr;
+  } else {
+    ++(arena->overflows);
+    return NULL;
+  }
+}
+static int
+arena_is_last (const mp_odrf_arena_t * arena, const void * ptr, size_t size)
+/* Return true if PTR, of SIZE bytes, is the last block bumped. */
+{
+  return ((const char *)ptr + MP_ODRF_ALIGN(size) == arena->base + arena->top);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Helpers: GMP memory functions.
+ ** ----------------------------------------------------------------- */
+
+static void *
+trampoline_alloc (size_t size)
+{
+  mp_odrf_arena_t *	arena = current_arena;
+  void *		ptr   = (arena)? arena_bump(arena, size) : NULL;
+  return (ptr)? ptr : next_alloc(size);
+}
+static void *
+trampoline_realloc (void * ptr, size_t old_size, size_t new_size)
+{
+  mp_odrf_arena_t *	arena = current_arena;
+  if (arena && arena_owns(arena, ptr)) {
+    void *	new_ptr;
+    if (arena_is_last(arena, ptr, old_size)) {
+      /* Resize in place. */
+      size_t	offset = (char *)ptr - arena->base;
+      if (MP_ODRF_ALIGN(new_size) <= arena->capacity - offset) {
+	arena->top = offset + MP_ODRF_ALIGN(new_size);
+	return ptr;
+      }
+    }
+    new_ptr = trampoline_alloc(new_size);
+    if (NULL != new_ptr)
+      memcpy(new_ptr, ptr, (old_size < new_size)? old_size : new_size);
+    return new_ptr;
+  } else
+    return next_realloc(ptr, old_size, new_size);
+}
+static void
+trampoline_free (void * ptr, size_t size)
+{
+  mp_odrf_arena_t *	arena = current_arena;
+  if (arena && arena_owns(arena, ptr)) {
+    /* Only the last block can be given back. */
+    if (arena_is_last(arena, ptr, size))
+      arena->top = (char *)ptr - arena->base;
+  } else
+    next_free(ptr, size);
+}
+static void
+install_trampolines (void)
+/* Install the trampolines once  for the whole process; concurrent callers
+   wait for the first one to finish. */
+{
+  static int	state = 0;	/* 0 = none, 1 = installing, 2 = installed */
+  int		expected = 0;
+  if (2 == __atomic_load_n(&state, __ATOMIC_ACQUIRE))
+    return;
+  if (__atomic_compare_exchange_n(&state, &expected, 1, 0,
+				  __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    /* MPFR  caches memory obtained  with the current  functions; it is
+       still released by them through the trampolines, but we do not keep
+       it around. */
+    mpfr_free_cache();
+    mp_get_memory_functions(&next_alloc, &next_realloc, &next_free);
+    mp_set_memory_functions(trampoline_alloc, trampoline_realloc, trampoline_free);
+    __atomic_store_n(&state, 2, __ATOMIC_RELEASE);
+  } else {
+    while (2 != __atomic_load_n(&state, __ATOMIC_ACQUIRE))
+      ;
+  }
+}
+static void
+flush_mpfr_caches (void)
+/* Release the  constants cached by MPFR in this thread and  its pool of
+   small limb blocks: they may reference memory in the arena. */
+{
+#if (MPFR_VERSION_MAJOR >= 4)
+  mpfr_free_cache2(MPFR_FREE_LOCAL_CACHE);
+#else
+  mpfr_free_cache();
+#endif
+}
+
+
+/** --------------------------------------------------------------------
+ ** Arena construction.
+ ** ----------------------------------------------------------------- */
+
+mp_odrf_arena_t *
+mp_odrf_arena_alloc (size_t capacity)
+/* Allocate a new arena of CAPACITY bytes using the current allocator. */
+{
+  const mp_odrf_allocator_t *	A = mp_odrf_get_allocator();
+  size_t		base_offset = MP_ODRF_ALIGN(sizeof(mp_odrf_arena_t));
+  char *		block	= MP_ODRF_ALLOC(A, base_offset + capacity);
+  mp_odrf_arena_t *	arena	= (mp_odrf_arena_t *)block;
+  if (NULL != arena) {
+    install_trampolines();
+    arena->allocator	= A;
+    arena->capacity	= capacity;
+    arena->top		= 0;
+    arena->overflows	= 0;
+    arena->base		= block + base_offset;
+  }
+  return arena;
+}
+void
+mp_odrf_arena_free (mp_odrf_arena_t * arena)
+/* Release an arena; it must not be used by a solver anymore. */
+{
+  MP_ODRF_FREE(arena->allocator, arena);
+}
+void
+mp_odrf_arena_reset (mp_odrf_arena_t * arena)
+/* Empty the arena; it must not be active in any thread. */
+{
+  arena->top		= 0;
+  arena->overflows	= 0;
+}
+size_t
+mp_odrf_arena_used (const mp_odrf_arena_t * arena)
+/* Return the number of bytes bumped since the last reset. */
+{
+  return arena->top;
+}
+size_t
+mp_odrf_arena_overflows (const mp_odrf_arena_t * arena)
+/* Return the number of allocations forwarded since the last reset because
+   the arena was full. */
+{
+  return arena->overflows;
+}
+
+
+/** --------------------------------------------------------------------
+ ** Activation.
+ ** ----------------------------------------------------------------- */
+
+void
+mp_odrf_arena_enter (mp_odrf_arena_t * arena, mp_odrf_arena_frame_t * frame)
+/* Make ARENA the active one in this thread, saving in FRAME the state to
+   be restored by "mp_odrf_arena_leave()". */
+{
+  frame->previous	= current_arena;
+  frame->top		= arena->top;
+  current_arena		= arena;
+}
+void
+mp_odrf_arena_leave (mp_odrf_arena_t * arena, const mp_odrf_arena_frame_t * frame)
+/* Restore the arena that was active before "mp_odrf_arena_enter()".  If
+   some block  bumped in the meantime  was not given back:  MPFR may be
+   holding it in a cache, so we flush them while ARENA is still active. */
+{
+  if (arena->top > frame->top)
+    flush_mpfr_caches();
+  current_arena = frame->previous;
+}
+
+/* end of file */
@@ -0,0 +1,244 @@
+/*
+   Part of: Multiple Precision One Dimensional Root Finding
+   Contents: double precision front end
+   Date: Fri Oct 16, 2026
+
+   Abstract
+
+	This module implements the  "set_hybrid" functions: when the math
+	function  has  a  double  precision  version,  the  first  bits of the
+	root are computed in hardware with Brent's  or Newton's method, then
+	the MPFR solver  is set with the resulting  bracket or guess; only
+	the iterations beyond the precision of "double" are left to MPFR.
+
+	The double  precision function can be  less accurate than the MPFR
+	one: a  narrowed bracket is  checked by the  "set" function of the
+	driver, and it is widened until the MPFR signs straddle zero.
+
+   Copyright (c) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+   Copyright (C) 1996, 1997, 1998, 1999, 2000, 2007 Reid Priedhorsky,
+   Brian Gough.
+
+   This program is free software:  you can redistribute it and/or modify
+   it under the terms of the  GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at
+   your option) any later version.
+
+   This program is  distributed in the hope that it  will be useful, but
+   WITHOUT  ANY   WARRANTY;  without   even  the  implied   warranty  of
+   MERCHANTABILITY  or FITNESS FOR  A PARTICULAR  PURPOSE.  See  the GNU
+   General Public License for more details.
+
+   You should  have received  a copy of  the GNU General  Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#include "mp-odrf-internals.h"
+
+/* Iteration limits of the native solvers; they are never reached by a
+   sane function, which converges in a few dozens of steps. */
+#define BRENT_MAX_ITERATIONS	100
+#define NEWTON_MAX_ITERATIONS	50
+
+/* Width of the  bracket, in units of the  relative spacing of doubles,
+   below which the native Brent solver stops; the same for the last step
+   of the native Newton solver. */
+#define DOUBLE_TOLERANCE	4
+
+/* Each time the MPFR signs do not straddle zero, the bracket is widened
+   by a factor of 2^WIDENING_BITS on both sides. */
+#define WIDENING_BITS		4
+
+
+/** --------------------------------------------------------------------
+ ** Double precision front end: root bracketing.
+ ** ----------------------------------------------------------------- */
+
+static int
+double_brent (mp_odrf_mpfr_function_t * F, double * lower, double * upper)
+/* Narrow the bracket [*LOWER, *UPPER] with Brent's method in double
+   precision.  Return false if the function is not finite or its signs at
+   the bounds do not straddle zero. */
+{
+  double	a = *lower, b = *upper, c, d, e;
+  double	fa, fb, fc;
+  double	m, p, q, r, s, t, tol;
+  int		i;
+  fa = (F->double_f)(a, F->params);
+  fb = (F->double_f)(b, F->params);
+  if ((! isfinite(fa)) || (! isfinite(fb)) ||
+      ((fa < 0.0) && (fb < 0.0)) || ((fa > 0.0) && (fb > 0.0)))
+    return 0;
+  c  = a;
+  fc = fa;
+  d  = e = b - a;
+  for (i=0; i<BRENT_MAX_ITERATIONS; ++i) {
+    if (((fb < 0.0) && (fc < 0.0)) || ((fb > 0.0) && (fc > 0.0))) {
+      c  = a;
+      fc = fa;
+      d  = e = b - a;
+    }
+    if (fabs(fc) < fabs(fb)) {
+      a = b;  b = c;  c = a;
+      fa = fb; fb = fc; fc = fa;
+    }
+    tol = 0.5 * DOUBLE_TOLERANCE * GSL_DBL_EPSILON * fabs(b);
+    m   = 0.5 * (c - b);
+    if ((0.0 == fb) || (fabs(m) <= tol))
+      break;
+    if ((fabs(e) < tol) || (fabs(fa) <= fabs(fb))) {
+      d = e = m;			/* use bisection */
+    } else {
+      /* use inverse cubic interpolation */
+      s = fb / fa;
+      if (a == c) {
+	p = 2.0 * m * s;
+	q = 1.0 - s;
+      } else {
+	q = fa / fc;
+	r = fb / fc;
+	p = s * (2.0 * m * q * (q - r) - (b - a) * (r - 1.0));
+	q = (q - 1.0) * (r - 1.0) * (s - 1.0);
+      }
+      if (p > 0.0)
+	q = -q;
+      else
+	p = -p;
+      /* t = min(3*m*q - fabs(tol*q), fabs(e*q)) */
+      t = 3.0 * m * q - fabs(tol * q);
+      if (t > fabs(e * q))
+	t = fabs(e * q);
+      if (2.0 * p < t) {
+	e = d;
+	d = p / q;
+      } else {
+	/* interpolation failed, fall back to bisection */
+	d = e = m;
+      }
+    }
+    a  = b;
+    fa = fb;
+    if (fabs(d) > tol)
+      b += d;
+    else
+      b += (m > 0.0)? tol : -tol;
+    fb = (F->double_f)(b, F->params);
+    if (! isfinite(fb))
+      return 0;
+  }
+  if (0.0 == fb) {
+    *lower = *upper = b;
+  } else if (b < c) {
+    *lower = b;
+    *upper = c;
+  } else {
+    *lower = c;
+    *upper = b;
+  }
+  return 1;
+}
+mp_odrf_code_t
+mp_odrf_mpfr_root_fsolver_set_hybrid (mp_odrf_mpfr_root_fsolver_t * S,
+				      mp_odrf_mpfr_function_t * F,
+				      mpfr_t x_lower, mpfr_t x_upper)
+/* Like "mp_odrf_mpfr_root_fsolver_set()", narrowing the bracket first
+   with the double precision version of F, if any. */
+{
+  mp_odrf_code_t	retval;
+  double		lower, upper, widening;
+  mpfr_t		lo, up;
+  if ((NULL == F->double_f) || mpfr_greater_p(x_lower, x_upper))
+    return mp_odrf_mpfr_root_fsolver_set(S, F, x_lower, x_upper);
+  lower = mpfr_get_d(x_lower, GMP_RNDU);
+  upper = mpfr_get_d(x_upper, GMP_RNDD);
+  if ((! isfinite(lower)) || (! isfinite(upper)) || (lower > upper) ||
+      (! double_brent(F, &lower, &upper)))
+    return mp_odrf_mpfr_root_fsolver_set(S, F, x_lower, x_upper);
+  /* The bounds are rounded outwards to the precision of the solver. */
+  mpfr_inits2(S->prec, lo, up, (mpfr_ptr)0);
+  widening = DOUBLE_TOLERANCE * GSL_DBL_EPSILON *
+    ((fabs(lower) > fabs(upper))? fabs(lower) : fabs(upper));
+  if (widening < DBL_MIN)
+    widening = DBL_MIN;
+  for (;;) {
+    mpfr_set_d(lo, lower, GMP_RNDD);
+    mpfr_set_d(up, upper, GMP_RNDU);
+    if (mpfr_less_p(lo, x_lower))
+      mpfr_set(lo, x_lower, GMP_RNDD);
+    if (mpfr_greater_p(up, x_upper))
+      mpfr_set(up, x_upper, GMP_RNDU);
+    retval = mp_odrf_mpfr_root_fsolver_set(S, F, lo, up);
+    if (((MP_ODRF_ERROR_ENDPOINTS_DO_NOT_STRADDLE != retval) &&
+	 (MP_ODRF_ERROR_SIGN_IS_UNCERTAIN != retval)) ||
+	(mpfr_lessequal_p(lo, x_lower) && mpfr_greaterequal_p(up, x_upper)))
+      break;
+    /* The double precision  function disagrees with the MPFR one near
+       the root, or the latter cannot decide the signs. */
+    lower    -= widening;
+    upper    += widening;
+    widening *= 1 << WIDENING_BITS;
+    if (isinf(widening)) {
+      retval = mp_odrf_mpfr_root_fsolver_set(S, F, x_lower, x_upper);
+      break;
+    }
+  }
+  mpfr_clears(lo, up, (mpfr_ptr)0);
+  return retval;
+}
+
+
+/** --------------------------------------------------------------------
+ ** Double precision front end: root polishing.
+ ** ----------------------------------------------------------------- */
+
+static int
+double_newton (mp_odrf_mpfr_function_fdf_t * FDF, double * x)
+/* Refine *X with Newton's  method in double precision.  Return false if
+   the iteration does not converge. */
+{
+  double	f, df, dx;
+  int		i;
+  for (i=0; i<NEWTON_MAX_ITERATIONS; ++i) {
+    (FDF->double_fdf)(*x, FDF->params, &f, &df);
+    if (0.0 == f)
+      return 1;
+    if ((! isfinite(f)) || (! isfinite(df)) || (0.0 == df))
+      return 0;
+    dx  = f / df;
+    *x -= dx;
+    if (! isfinite(*x))
+      return 0;
+    if (fabs(dx) <= DOUBLE_TOLERANCE * GSL_DBL_EPSILON * fabs(*x))
+      return 1;
+  }
+  return 0;
+}
+mp_odrf_code_t
+mp_odrf_mpfr_root_fdfsolver_set_hybrid (mp_odrf_mpfr_root_fdfsolver_t * S,
+					mp_odrf_mpfr_function_fdf_t * FDF,
+					mpfr_t root)
+/* Like "mp_odrf_mpfr_root_fdfsolver_set()", refining the guess first with
+   the double precision version of FDF, if any.  If the native iteration
+   does not converge the guess is used as it is. */
+{
+  mp_odrf_code_t	retval;
+  double		x;
+  mpfr_t		guess;
+  if (NULL == FDF->double_fdf)
+    return mp_odrf_mpfr_root_fdfsolver_set(S, FDF, root);
+  x = mpfr_get_d(root, GMP_RNDN);
+  if ((! isfinite(x)) || (! double_newton(FDF, &x)))
+    return mp_odrf_mpfr_root_fdfsolver_set(S, FDF, root);
+  mpfr_init2(guess, DBL_MANT_DIG);
+  mpfr_set_d(guess, x, GMP_RNDN);
+  retval = mp_odrf_mpfr_root_fdfsolver_set(S, FDF, guess);
+  mpfr_clear(guess);
+  return retval;
+}
+
+/* end of file */
@@ -42,6 +42,8 @@ mp_odrf_strerror (mp_odrf_code_t code)
   switch (code) {
   case MP_ODRF_OK:
     return "no error";
+  case MP_ODRF_BRACKET_EXHAUSTED:
+    return "bracket cannot be split at the working precision";
   case MP_ODRF_ERROR_NO_MEMORY_FOR_STATE_STRUCT:
     return "failed to allocate space for root solver state";
   case MP_ODRF_ERROR_INVALID_BRACKET_INTERVAL:
@@ -60,6 +62,18 @@ mp_odrf_strerror (mp_odrf_code_t code)
     return "derivative is zero";
   case MP_ODRF_ERROR_FUNCTION_OR_DERIVATIVE_VALUE_INVALID:
     return "function or derivative value is not finite or not a number";
+  case MP_ODRF_ERROR_MAX_ITERATIONS_REACHED:
+    return "maximum number of iterations reached";
+  case MP_ODRF_ERROR_INVALID_PRECISION:
+    return "invalid precision";
+  case MP_ODRF_ERROR_UNSUPPORTED_BY_DRIVER:
+    return "operation not supported by the solver's driver";
+  case MP_ODRF_ERROR_SIGN_IS_UNCERTAIN:
+    return "sign of the function uncertain at the solver's precision";
+  case MP_ODRF_ERROR_ROUNDING_IS_UNDECIDED:
+    return "rounding of the root undecided at the solver's precision";
+  case MP_ODRF_ERROR_INVALID_DRIVER_PARAMETER:
+    return "parameter of the solver's driver out of range";
   default:
     return "unknown or invalid error code";
   }
@@ -42,9 +42,19 @@
  ** Preprocessor macros.
  ** ----------------------------------------------------------------- */
 
-#define SAFE_FUNC_CALL(RETVAL, F, X, Y)				\
-  do {								\
-    RETVAL = MP_ODRF_MPFR_FN_EVAL(F, Y, X);			\
+/* Evaluate F at X into Y requesting BITS correct bits, see
+   "mp_odrf_hint_bits()".  If F has a ball function Y is its midpoint, and
+   the evaluation fails when the ball contains zero. */
+#define SAFE_FUNC_CALL(RETVAL, F, X, Y, BITS)				\
+  do {									\
+    if ((F)->ball) {							\
+      MPFR_DECL_INIT(mp_odrf_radius, MP_ODRF_BALL_RADIUS_PREC);		\
+      RETVAL = ((F)->ball)((Y), mp_odrf_radius, (X), (F)->params);	\
+      if ((MP_ODRF_OK == RETVAL) && mpfr_number_p(Y) &&			\
+	  (! mp_odrf_ball_sign_is_certain((Y), mp_odrf_radius)))	\
+	RETVAL = MP_ODRF_ERROR_SIGN_IS_UNCERTAIN;			\
+    } else								\
+      RETVAL = MP_ODRF_MPFR_FN_EVAL_HINTED(F, Y, X, BITS);		\
     if (MP_ODRF_ERROR == RETVAL) {				\
       ;								\
     } else if (! mpfr_number_p(Y)) {				\
@@ -52,11 +62,32 @@
     }								\
   } while (0);
 
+/* Use the allocator A, of type "mp_odrf_allocator_t", to allocate and
+   release memory blocks. */
+#define MP_ODRF_ALLOC(A,SIZE)		(((A)->alloc)((A)->context, (SIZE)))
+#define MP_ODRF_REALLOC(A,PTR,SIZE)	(((A)->realloc)((A)->context, (PTR), (SIZE)))
+#define MP_ODRF_FREE(A,PTR)		(((A)->free)((A)->context, (PTR)))
+
+/* Round SIZE up  to a multiple of "MP_ODRF_ALIGNMENT"; it  is used to
+   lay out multiple structs in a single memory block. */
+#define MP_ODRF_ALIGNMENT	MP_ODRF_SOLVER_ALIGNMENT
+#define MP_ODRF_ALIGN(SIZE)	\
+  (((SIZE) + MP_ODRF_ALIGNMENT - 1) & ~((size_t)MP_ODRF_ALIGNMENT - 1))
+
 
 /** --------------------------------------------------------------------
  ** Constants.
  ** ----------------------------------------------------------------- */
 
+/* Correct bits requested to the hinted functions when only the sign of
+   the result is  used, and the least number requested  for a value used
+   in an interpolation. */
+#define MP_ODRF_HINT_SIGN_BITS		1
+#define MP_ODRF_HINT_MIN_BITS		16
+
+/* Precision of the radii handed to the ball functions. */
+#define MP_ODRF_BALL_RADIUS_PREC	64
+
 #define GSL_DBL_EPSILON        2.2204460492503131e-16
 
 
@@ -64,6 +95,71 @@
  ** Functions.
  ** ----------------------------------------------------------------- */
 
+/* Allocate from  A a solver whose  struct, driver state and  limbs are
+   laid out in a single block; all the numbers have precision PREC. */
+mp_odrf_private_decl mp_odrf_mpfr_root_fsolver_t * \
+  mp_odrf_fsolver_alloc_contiguous (const mp_odrf_mpfr_root_fsolver_driver_t * T,
+				    const mp_odrf_allocator_t * A, mp_prec_t prec);
+mp_odrf_private_decl mp_odrf_mpfr_root_fdfsolver_t * \
+  mp_odrf_fdfsolver_alloc_contiguous (const mp_odrf_mpfr_root_fdfsolver_driver_t * T,
+				      const mp_odrf_allocator_t * A, mp_prec_t prec);
+
+/* Change  to PREC  the precision  of X through  the custom interface of
+   MPFR, reusing its limbs: PREC must not exceed the precision they were
+   laid out for.  The "set" function makes X NaN, the "raise" function
+   keeps its value and requires PREC not lower than the current
+   precision. */
+mp_odrf_private_decl void mp_odrf_mpfr_custom_set_prec   (mpfr_ptr x, mp_prec_t prec);
+mp_odrf_private_decl void mp_odrf_mpfr_custom_raise_prec (mpfr_ptr x, mp_prec_t prec);
+
+/* Like the functions above for a member X of the driver state of a solver
+   with the given "MP_ODRF_SOLVER_FLAG_*" bits: the custom interface is
+   used only if the library laid out the limbs, else X is changed with the
+   MPFR functions, which do not reallocate below the allocated precision. */
+mp_odrf_private_decl void mp_odrf_mpfr_state_set_prec   (mpfr_ptr x, mp_prec_t prec, unsigned flags);
+mp_odrf_private_decl void mp_odrf_mpfr_state_raise_prec (mpfr_ptr x, mp_prec_t prec, unsigned flags);
+
+/* Return the number of correct bits of Y needed to compute a step from X
+   of size about STEP, or the  least number for an interpolation if STEP
+   is NULL; the result is never above the precision of Y. */
+mp_odrf_private_decl mp_prec_t mp_odrf_hint_bits (mpfr_srcptr x, mpfr_srcptr step, mpfr_srcptr y);
+
+/* Return true if the ball of midpoint MID and radius RAD does not contain
+   zero, or is zero itself. */
+mp_odrf_private_decl int mp_odrf_ball_sign_is_certain (mpfr_srcptr mid, mpfr_srcptr rad);
+
+/* Store in MID the midpoint of the bracket [LO, UP] rounded to the nearest
+   and return true if it is equal to one of the bounds: the bracket cannot
+   be split anymore at the precision of MID.  A bracket reduced to a point
+   holds an exact root, so it is not reported as exhausted. */
+mp_odrf_private_decl int mp_odrf_bracket_is_exhausted (mpfr_ptr mid, mpfr_srcptr lo, mpfr_srcptr up);
+
+/* Store in ROOT the bound of an exhausted bracket [LO, UP] with the least
+   residual, given the function values F_LO and F_UP; the lower one wins
+   a tie.  Return "MP_ODRF_BRACKET_EXHAUSTED". */
+mp_odrf_private_decl mp_odrf_code_t \
+  mp_odrf_bracket_exhausted_root (mpfr_ptr root, mpfr_srcptr lo, mpfr_srcptr up,
+				  mpfr_srcptr f_lo, mpfr_srcptr f_up);
+
+/* Move X at least |LO| * 2^(1-prec) above LO and |UP| * 2^(1-prec) below
+   UP, one or two units in the last place, where prec is the precision of
+   the scratch  variable TMP.  Return  true if X is then  strictly inside
+   the bracket, false if the bracket is too narrow for this. */
+mp_odrf_private_decl int mp_odrf_clamp_inside (mpfr_ptr x, mpfr_srcptr lo, mpfr_srcptr up,
+					       mpfr_ptr tmp);
+
+/* State saved when an arena is made active in the current thread. */
+typedef struct {
+  mp_odrf_arena_t *	previous;
+  size_t		top;
+} mp_odrf_arena_frame_t;
+
+/* Make ARENA  the active  one in the  current thread around  a call to
+   a driver function, then restore the previous one. */
+mp_odrf_private_decl void mp_odrf_arena_enter (mp_odrf_arena_t * arena,
+					       mp_odrf_arena_frame_t * frame);
+mp_odrf_private_decl void mp_odrf_arena_leave (mp_odrf_arena_t * arena,
+					       const mp_odrf_arena_frame_t * frame);
 
 
 
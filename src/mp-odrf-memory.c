@@ -0,0 +1,85 @@
+/*
+  Part of: Multiple Precision One-Dimensional Root-Finding
+  Contents: memory allocation
+  Date: Fri Oct 16, 2026
+
+  Abstract
+
+	This  module implements  the pluggable  memory allocator  used to
+	allocate solvers.
+
+  Copyright (C) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+  This program is  free software: you can redistribute  it and/or modify
+  it under the  terms of the GNU General Public  License as published by
+  the Free Software Foundation, either version  3 of the License, or (at
+  your option) any later version.
+
+  This program  is distributed in the  hope that it will  be useful, but
+  WITHOUT   ANY  WARRANTY;   without  even   the  implied   warranty  of
+  MERCHANTABILITY  or FITNESS  FOR A  PARTICULAR PURPOSE.   See the  GNU
+  General Public License for more details.
+
+  You should  have received  a copy  of the  GNU General  Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#include "mp-odrf-internals.h"
+
+
+/** --------------------------------------------------------------------
+ ** Default allocator.
+ ** ----------------------------------------------------------------- */
+
+static void *
+default_alloc (void * context MP_ODRF_UNUSED, size_t size)
+{
+  return malloc(size);
+}
+static void *
+default_realloc (void * context MP_ODRF_UNUSED, void * ptr, size_t size)
+{
+  return realloc(ptr, size);
+}
+static void
+default_free (void * context MP_ODRF_UNUSED, void * ptr)
+{
+  free(ptr);
+}
+
+static const mp_odrf_allocator_t default_allocator = {
+  .alloc	= default_alloc,
+  .realloc	= default_realloc,
+  .free		= default_free,
+  .context	= NULL
+};
+
+/* The allocator used by the solver constructors which do not take one
+   as argument. */
+static const mp_odrf_allocator_t * current_allocator = &default_allocator;
+
+
+/** --------------------------------------------------------------------
+ ** Public API.
+ ** ----------------------------------------------------------------- */
+
+void
+mp_odrf_set_allocator (const mp_odrf_allocator_t * A)
+/* Select the  allocator used by  the solver constructors; if  A is NULL:
+   restore the default allocator. */
+{
+  current_allocator = (A)? A : &default_allocator;
+}
+const mp_odrf_allocator_t *
+mp_odrf_get_allocator (void)
+/* Return the allocator currently used by the solver constructors. */
+{
+  return current_allocator;
+}
+
+/* end of file */
@@ -0,0 +1,195 @@
+/*
+  Part of: Multiple Precision One-Dimensional Root-Finding
+  Contents: pools of solvers
+  Date: Fri Oct 16, 2026
+
+  Abstract
+
+	This module implements pools of  ready to use solvers.  A pool is
+	a fixed  number of  slots, each of  which either is  empty or
+	references a released  solver; threads take and  put solvers with
+	atomic operations, so acquiring and releasing never lock.
+
+	A thread takes a solver by exchanging its slot with NULL: after the
+	exchange the solver belongs  to that thread alone, so no other
+	thread can observe it half-way and the ABA problem does not arise.
+
+  Copyright (C) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+  This program is  free software: you can redistribute  it and/or modify
+  it under the  terms of the GNU General Public  License as published by
+  the Free Software Foundation, either version  3 of the License, or (at
+  your option) any later version.
+
+  This program  is distributed in the  hope that it will  be useful, but
+  WITHOUT   ANY  WARRANTY;   without  even   the  implied   warranty  of
+  MERCHANTABILITY  or FITNESS  FOR A  PARTICULAR PURPOSE.   See the  GNU
+  General Public License for more details.
+
+  You should  have received  a copy  of the  GNU General  Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#include "mp-odrf-internals.h"
+#include <string.h>
+
+struct mp_odrf_pool_t {
+  const mp_odrf_allocator_t *	allocator;
+  size_t			capacity;
+  /* Arrays of CAPACITY slots each; they are in the same memory block of
+     the struct. */
+  mp_odrf_mpfr_root_fsolver_t **	fsolvers;
+  mp_odrf_mpfr_root_fdfsolver_t **	fdfsolvers;
+};
+
+
+/** --------------------------------------------------------------------
+ ** Helpers: atomic slots.
+ ** ----------------------------------------------------------------- */
+
+static void *
+slot_take (void ** slot)
+/* Take ownership of the solver in SLOT, if any. */
+{
+  if (NULL == __atomic_load_n(slot, __ATOMIC_ACQUIRE))
+    return NULL;
+  else
+    return __atomic_exchange_n(slot, NULL, __ATOMIC_ACQ_REL);
+}
+static int
+slots_put (void ** slots, size_t capacity, void * S)
+/* Store S  in  the first empty  slot; return true  if successful, false
+   if all the slots are full. */
+{
+  size_t	i;
+  for (i=0; i<capacity; ++i) {
+    void *	expected = NULL;
+    if (__atomic_compare_exchange_n(&slots[i], &expected, S, 0,
+				    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+      return 1;
+  }
+  return 0;
+}
+
+
+/** --------------------------------------------------------------------
+ ** Pool construction.
+ ** ----------------------------------------------------------------- */
+
+mp_odrf_pool_t *
+mp_odrf_pool_alloc (size_t capacity)
+/* Allocate a new pool able  to cache CAPACITY released solvers of each
+   kind; the pool and its solvers use the current allocator. */
+{
+  const mp_odrf_allocator_t *	A = mp_odrf_get_allocator();
+  size_t	slots_offset	= MP_ODRF_ALIGN(sizeof(mp_odrf_pool_t));
+  size_t	slots_size	= capacity * sizeof(void *);
+  char *	block		= MP_ODRF_ALLOC(A, slots_offset + 2 * slots_size);
+  mp_odrf_pool_t *	P	= (mp_odrf_pool_t *)block;
+  if (NULL != P) {
+    P->allocator	= A;
+    P->capacity		= capacity;
+    P->fsolvers		= (mp_odrf_mpfr_root_fsolver_t   **)(block + slots_offset);
+    P->fdfsolvers	= (mp_odrf_mpfr_root_fdfsolver_t **)(block + slots_offset + slots_size);
+    memset(block + slots_offset, 0, 2 * slots_size);
+  }
+  return P;
+}
+void
+mp_odrf_pool_free (mp_odrf_pool_t * P)
+/* Release the pool and all the solvers cached in it.  It must not be
+   called while other threads are using the pool. */
+{
+  size_t	i;
+  for (i=0; i<P->capacity; ++i) {
+    if (P->fsolvers[i])
+      mp_odrf_mpfr_root_fsolver_free(P->fsolvers[i]);
+    if (P->fdfsolvers[i])
+      mp_odrf_mpfr_root_fdfsolver_free(P->fdfsolvers[i]);
+  }
+  MP_ODRF_FREE(P->allocator, P);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Root bracketing solvers.
+ ** ----------------------------------------------------------------- */
+
+mp_odrf_mpfr_root_fsolver_t *
+mp_odrf_pool_fsolver_acquire (mp_odrf_pool_t * P,
+			      const mp_odrf_mpfr_root_fsolver_driver_t * T,
+			      mp_prec_t prec)
+/* Return a solver using the driver T and numbers with precision PREC;
+   reuse a released solver if possible, else allocate a new one. */
+{
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  size_t			i;
+  for (i=0; i<P->capacity; ++i) {
+    S = slot_take((void **)&P->fsolvers[i]);
+    if (NULL != S) {
+      if ((T == S->driver) && (prec == S->prec))
+	return S;
+      /* Not the one we are looking for: put it back. */
+      if (! slots_put((void **)P->fsolvers, P->capacity, S))
+	mp_odrf_mpfr_root_fsolver_free(S);
+    }
+  }
+  return mp_odrf_fsolver_alloc_contiguous(T, P->allocator, prec);
+}
+void
+mp_odrf_pool_fsolver_release (mp_odrf_pool_t * P, mp_odrf_mpfr_root_fsolver_t * S)
+/* Hand back to the pool a  solver returned by the acquire function; if
+   the pool is full: release the solver. */
+{
+  mp_odrf_mpfr_root_fsolver_reset(S);
+  mp_odrf_mpfr_root_fsolver_set_arena(S, NULL);
+  /* The acquire function matches the precision of the solver only. */
+  mp_odrf_mpfr_root_fsolver_set_ordinate_prec(S, S->prec);
+  mp_odrf_mpfr_root_fsolver_set_adaptive_prec(S, 0);
+  if (! slots_put((void **)P->fsolvers, P->capacity, S))
+    mp_odrf_mpfr_root_fsolver_free(S);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Root polishing solvers.
+ ** ----------------------------------------------------------------- */
+
+mp_odrf_mpfr_root_fdfsolver_t *
+mp_odrf_pool_fdfsolver_acquire (mp_odrf_pool_t * P,
+				const mp_odrf_mpfr_root_fdfsolver_driver_t * T,
+				mp_prec_t prec)
+/* Return a solver using the driver T and numbers with precision PREC;
+   reuse a released solver if possible, else allocate a new one. */
+{
+  mp_odrf_mpfr_root_fdfsolver_t *	S;
+  size_t				i;
+  for (i=0; i<P->capacity; ++i) {
+    S = slot_take((void **)&P->fdfsolvers[i]);
+    if (NULL != S) {
+      if ((T == S->driver) && (prec == mpfr_get_prec(S->root)))
+	return S;
+      /* Not the one we are looking for: put it back. */
+      if (! slots_put((void **)P->fdfsolvers, P->capacity, S))
+	mp_odrf_mpfr_root_fdfsolver_free(S);
+    }
+  }
+  return mp_odrf_fdfsolver_alloc_contiguous(T, P->allocator, prec);
+}
+void
+mp_odrf_pool_fdfsolver_release (mp_odrf_pool_t * P, mp_odrf_mpfr_root_fdfsolver_t * S)
+/* Hand back to the pool a  solver returned by the acquire function; if
+   the pool is full: release the solver. */
+{
+  mp_odrf_mpfr_root_fdfsolver_reset(S);
+  mp_odrf_mpfr_root_fdfsolver_set_arena(S, NULL);
+  if (! slots_put((void **)P->fdfsolvers, P->capacity, S))
+    mp_odrf_mpfr_root_fdfsolver_free(S);
+}
+
+/* end of file */
@@ -33,79 +33,725 @@
  ** ----------------------------------------------------------------- */
 
 #include "mp-odrf-internals.h"
+#include <string.h>
+
+
+/** --------------------------------------------------------------------
+ ** Helpers: precision of MPFR numbers.
+ ** ----------------------------------------------------------------- */
+
+void
+mp_odrf_mpfr_custom_set_prec (mpfr_ptr x, mp_prec_t prec)
+{
+  void *	limbs = mpfr_custom_get_significand(x);
+  mpfr_custom_init(limbs, prec);
+  mpfr_custom_init_set(x, MPFR_NAN_KIND, 0, prec, limbs);
+}
+void
+mp_odrf_mpfr_custom_raise_prec (mpfr_ptr x, mp_prec_t prec)
+/* The  significand is  moved to the  most significant limbs and  the
+   others are zeroed, as "mpfr_prec_round()" does when it reallocates. */
+{
+  mp_limb_t *	limbs	  = mpfr_custom_get_significand(x);
+  int		kind	  = mpfr_custom_get_kind(x);
+  mp_exp_t	exp	  = mpfr_custom_get_exp(x);
+  size_t	old_count = (mpfr_get_prec(x) - 1) / GMP_NUMB_BITS + 1;
+  size_t	new_count = (prec - 1) / GMP_NUMB_BITS + 1;
+  memmove(limbs + (new_count - old_count), limbs, old_count * sizeof(mp_limb_t));
+  memset(limbs, 0, (new_count - old_count) * sizeof(mp_limb_t));
+  mpfr_custom_init_set(x, kind, exp, prec, limbs);
+}
+void
+mp_odrf_mpfr_state_set_prec (mpfr_ptr x, mp_prec_t prec, unsigned flags)
+{
+  if (MP_ODRF_SOLVER_FLAG_CONTIGUOUS & flags)
+    mp_odrf_mpfr_custom_set_prec(x, prec);
+  else
+    mpfr_set_prec(x, prec);
+}
+void
+mp_odrf_mpfr_state_raise_prec (mpfr_ptr x, mp_prec_t prec, unsigned flags)
+{
+  if (MP_ODRF_SOLVER_FLAG_CONTIGUOUS & flags)
+    mp_odrf_mpfr_custom_raise_prec(x, prec);
+  else
+    mpfr_prec_round(x, prec, GMP_RNDN);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Helpers: accuracy hints and bracket splitting.
+ ** ----------------------------------------------------------------- */
+
+/* Guard bits requested beyond the ones resolved by a step. */
+#define HINT_GUARD_BITS		8
+
+mp_prec_t
+mp_odrf_hint_bits (mpfr_srcptr x, mpfr_srcptr step, mpfr_srcptr y)
+/* A step of size  STEP from X moves the estimate only  in the bits below
+   EXP(X)-EXP(STEP): the function value needs to be correct to about that
+   many bits, plus some guard, for the next step to be as good.  When the
+   step is zero or not finite we ask for the full precision of Y. */
+{
+  mp_prec_t	prec = mpfr_get_prec(y);
+  mp_prec_t	bits;
+  if (NULL == step)
+    bits = MP_ODRF_HINT_MIN_BITS;
+  else if (mpfr_regular_p(x) && mpfr_regular_p(step)) {
+    mp_exp_t	resolved = mpfr_get_exp(x) - mpfr_get_exp(step);
+    bits = ((0 < resolved)? (mp_prec_t)resolved : 0) + HINT_GUARD_BITS;
+    if (bits < MP_ODRF_HINT_MIN_BITS)
+      bits = MP_ODRF_HINT_MIN_BITS;
+  } else
+    bits = prec;
+  return (bits < prec)? bits : prec;
+}
+int
+mp_odrf_ball_sign_is_certain (mpfr_srcptr mid, mpfr_srcptr rad)
+{
+  if (mpfr_zero_p(rad))
+    return 1;
+  else
+    return (mpfr_number_p(rad) && (mpfr_cmpabs(mid, rad) > 0));
+}
+int
+mp_odrf_bracket_is_exhausted (mpfr_ptr mid, mpfr_srcptr lo, mpfr_srcptr up)
+{
+  mpfr_add(mid, lo, up, GMP_RNDN);
+  mpfr_div_2ui(mid, mid, 1, GMP_RNDN);
+  return ((! mpfr_equal_p(lo, up)) &&
+	  (mpfr_equal_p(mid, lo) || mpfr_equal_p(mid, up)));
+}
+mp_odrf_code_t
+mp_odrf_bracket_exhausted_root (mpfr_ptr root, mpfr_srcptr lo, mpfr_srcptr up,
+				mpfr_srcptr f_lo, mpfr_srcptr f_up)
+/* No more evaluations are needed: the bounds are the best roots at the
+   working precision. */
+{
+  mpfr_set(root, (mpfr_cmpabs(f_lo, f_up) <= 0)? lo : up, GMP_RNDN);
+  return MP_ODRF_BRACKET_EXHAUSTED;
+}
+int
+mp_odrf_clamp_inside (mpfr_ptr x, mpfr_srcptr lo, mpfr_srcptr up, mpfr_ptr tmp)
+/* Close to the root the interpolation points of the superlinear drivers
+   fall on the same side, within the rounding error: without this guard
+   the far bound would move only by bisection. */
+{
+  unsigned long	shift = (unsigned long)mpfr_get_prec(tmp) - 1;
+  mpfr_div_2ui(tmp, lo, shift, GMP_RNDN);
+  mpfr_abs(tmp, tmp, GMP_RNDN);
+  mpfr_add(tmp, lo, tmp, GMP_RNDN);
+  if (mpfr_less_p(x, tmp))
+    mpfr_set(x, tmp, GMP_RNDN);
+  mpfr_div_2ui(tmp, up, shift, GMP_RNDN);
+  mpfr_abs(tmp, tmp, GMP_RNDN);
+  mpfr_sub(tmp, up, tmp, GMP_RNDN);
+  if (mpfr_greater_p(x, tmp))
+    mpfr_set(x, tmp, GMP_RNDN);
+  return (mpfr_greater_p(x, lo) && mpfr_less_p(x, up));
+}
+
+
+/** --------------------------------------------------------------------
+ ** Helpers: arrays of MPFR numbers.
+ ** ----------------------------------------------------------------- */
+
+/* The first "driver_state_mpfr_count" members of a driver state struct
+   are  of type  "mpfr_t",  so  we  can handle  them  as  an array  of
+   "__mpfr_struct". */
+
+#ifndef MP_ODRF_INLINE_LIMBS
+static void
+mpfr_vars_init (void * vars, size_t count, mp_prec_t prec)
+{
+  mpfr_ptr	V = vars;
+  size_t	i;
+  for (i=0; i<count; ++i)
+    mpfr_init2(&V[i], prec);
+}
+#endif
+static void
+mpfr_vars_custom_init (void * vars, size_t count, mp_prec_t prec, char * limbs)
+/* Initialise COUNT numbers with precision PREC using the custom interface
+   of  MPFR; the limbs  are stored  in the  memory block  referenced by
+   LIMBS, which must be large enough. */
+{
+  mpfr_ptr	V = vars;
+  size_t	limbs_size = mpfr_custom_get_size(prec);
+  size_t	i;
+  for (i=0; i<count; ++i, limbs += limbs_size) {
+    mpfr_custom_init(limbs, prec);
+    mpfr_custom_init_set(&V[i], MPFR_NAN_KIND, 0, prec, limbs);
+  }
+}
+static void
+mpfr_vars_custom_raise_prec (void * vars, size_t count, mp_prec_t prec)
+/* Like "mpfr_vars_custom_set_prec()", but the values are preserved and
+   PREC must not be lower than the current precision. */
+{
+  mpfr_ptr	V = vars;
+  size_t	i;
+  for (i=0; i<count; ++i)
+    mp_odrf_mpfr_custom_raise_prec(&V[i], prec);
+}
+static void
+mpfr_vars_raise_prec (void * vars, size_t count, mp_prec_t prec)
+/* Raise to PREC the precision of COUNT numbers, preserving their values. */
+{
+  mpfr_ptr	V = vars;
+  size_t	i;
+  for (i=0; i<count; ++i)
+    mpfr_prec_round(&V[i], prec, GMP_RNDN);
+}
+static void
+mpfr_vars_set_nan (void * vars, size_t count)
+{
+  mpfr_ptr	V = vars;
+  size_t	i;
+  for (i=0; i<count; ++i)
+    mpfr_set_nan(&V[i]);
+}
+static void
+mpfr_vars_clear (void * vars, size_t count)
+{
+  mpfr_ptr	V = vars;
+  size_t	i;
+  for (i=0; i<count; ++i)
+    mpfr_clear(&V[i]);
+}
+static void
+mpfr_vars_set_prec (void * vars, size_t count, mp_prec_t prec)
+/* Reinitialise COUNT numbers  with precision PREC; their  value becomes
+   NaN.  The  old limbs are  released, so the memory shrinks when  the
+   precision is lowered. */
+{
+  mpfr_ptr	V = vars;
+  size_t	i;
+  for (i=0; i<count; ++i) {
+    mpfr_clear(&V[i]);
+    mpfr_init2(&V[i], prec);
+  }
+}
+static void
+mpfr_vars_custom_set_prec (void * vars, size_t count, mp_prec_t prec)
+/* Like "mpfr_vars_set_prec()" for numbers initialised with the custom
+   interface: the limbs are reused, so PREC must not exceed the precision
+   they were laid out for. */
+{
+  mpfr_ptr	V = vars;
+  size_t	i;
+  for (i=0; i<count; ++i)
+    mp_odrf_mpfr_custom_set_prec(&V[i], prec);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Root bracketing solver: working precision.
+ ** ----------------------------------------------------------------- */
+
+/* In adaptive mode  the precision is raised when the bracket  is at most
+   2^ESCALATION_GUARD_BITS units in the last place wide. */
+#define ESCALATION_GUARD_BITS	8
+
+/* When the  signs at the bounds  do not straddle zero  after the working
+   precision is raised, the bracket is widened by a factor of
+   2^ESCALATION_WIDENING_BITS on both sides, until they do. */
+#define ESCALATION_WIDENING_BITS	4
+
+static void
+fsolver_vars_set_prec (mp_odrf_mpfr_root_fsolver_t * S, void * vars, size_t count, mp_prec_t prec)
+{
+  if (MP_ODRF_SOLVER_FLAG_CONTIGUOUS & S->flags)
+    mpfr_vars_custom_set_prec(vars, count, prec);
+  else
+    mpfr_vars_set_prec(vars, count, prec);
+}
+static void
+fsolver_set_state_prec (mp_odrf_mpfr_root_fsolver_t * S, mp_prec_t prec)
+/* Reinitialise the driver state: the abscissae get precision PREC, the
+   ordinates the lower between PREC and the one selected for them. */
+{
+  const mp_odrf_mpfr_root_fsolver_driver_t *	T = S->driver;
+  mpfr_ptr	V = S->driver_state;
+  fsolver_vars_set_prec(S, V, T->driver_state_ordinate_count,
+			(prec < S->ordinate_prec)? prec : S->ordinate_prec);
+  fsolver_vars_set_prec(S, V + T->driver_state_ordinate_count,
+			T->driver_state_mpfr_count - T->driver_state_ordinate_count, prec);
+}
+static void
+fsolver_set_working_prec (mp_odrf_mpfr_root_fsolver_t * S, mp_prec_t prec)
+/* Reinitialise all the numbers of the solver with working precision PREC;
+   their value becomes NaN. */
+{
+  fsolver_vars_set_prec(S, S->root,    1, prec);
+  fsolver_vars_set_prec(S, S->x_lower, 1, prec);
+  fsolver_vars_set_prec(S, S->x_upper, 1, prec);
+  fsolver_set_state_prec(S, prec);
+}
+static int
+fsolver_bracket_is_narrow (const mp_odrf_mpfr_root_fsolver_t * S)
+/* Return true if the bracket is only a few units in the last place wide
+   at the working precision.  Only the exponent of the width matters, so
+   it is computed with a few bits. */
+{
+  MPFR_DECL_INIT(width, 32);
+  mp_exp_t	bound_exp;
+  if (mpfr_equal_p(S->x_lower, S->x_upper))
+    return 1;
+  mpfr_sub(width, S->x_upper, S->x_lower, GMP_RNDU);
+  bound_exp = mpfr_get_exp((mpfr_cmpabs(S->x_lower, S->x_upper) > 0)? S->x_lower : S->x_upper);
+  return (mpfr_get_exp(width) <=
+	  bound_exp - (mp_exp_t)mpfr_get_prec(S->root) + ESCALATION_GUARD_BITS);
+}
+static mp_odrf_code_t
+fsolver_driver_set (mp_odrf_mpfr_root_fsolver_t * S, mpfr_ptr x_lower, mpfr_ptr x_upper)
+/* Call the "set" function of the driver, inside the arena if any.  The
+   precision of the numbers of the solver must be changed outside of it:
+   MPFR would bump the new limbs from the arena, and later release them
+   with the default allocator. */
+{
+  mp_odrf_arena_frame_t	frame;
+  mp_odrf_code_t	retval;
+  if (S->arena)
+    mp_odrf_arena_enter(S->arena, &frame);
+  retval = (S->driver->set)(S->driver_state, S->function, S->root, x_lower, x_upper);
+  if (S->arena)
+    mp_odrf_arena_leave(S->arena, &frame);
+  return retval;
+}
+static mp_odrf_code_t
+fsolver_widen_bracket (mp_odrf_mpfr_root_fsolver_t * S, mp_prec_t old_prec)
+/* The  signs at the bounds  were wrong at  the working  precision OLD_PREC,
+   which is  possible only  a  few  units in the  last place  away from the
+   root:  widen the bracket geometrically  starting from one such unit and
+   set the driver again, up to the magnitude of the bounds. */
+{
+  mp_odrf_code_t	retval = MP_ODRF_ERROR_ENDPOINTS_DO_NOT_STRADDLE;
+  mpfr_ptr		bound = (mpfr_cmpabs(S->x_lower, S->x_upper) > 0)? S->x_lower : S->x_upper;
+  mp_exp_t		bound_exp;
+  MPFR_DECL_INIT(widening, 2);
+  if (! mpfr_regular_p(bound))
+    return retval;
+  bound_exp = mpfr_get_exp(bound);
+  mpfr_set_ui_2exp(widening, 1, bound_exp - (mp_exp_t)old_prec, GMP_RNDN);
+  while (mpfr_get_exp(widening) <= bound_exp) {
+    mpfr_sub(S->x_lower, S->x_lower, widening, GMP_RNDD);
+    mpfr_add(S->x_upper, S->x_upper, widening, GMP_RNDU);
+    retval = fsolver_driver_set(S, S->x_lower, S->x_upper);
+    if ((MP_ODRF_ERROR_ENDPOINTS_DO_NOT_STRADDLE != retval) &&
+	(MP_ODRF_ERROR_SIGN_IS_UNCERTAIN != retval))
+      break;
+    mpfr_mul_2ui(widening, widening, ESCALATION_WIDENING_BITS, GMP_RNDN);
+  }
+  return retval;
+}
+static mp_odrf_code_t
+fsolver_raise_working_prec (mp_odrf_mpfr_root_fsolver_t * S, mp_prec_t prec)
+/* Raise the working precision to PREC,  not above the one of the solver.
+   The bounds are exact at the  new precision; the function is evaluated
+   again at them by the "set" function of the driver, which also
+   reinitialises its state. */
+{
+  mp_prec_t		old_prec = mpfr_get_prec(S->root);
+  mp_odrf_code_t	retval;
+  if (MP_ODRF_SOLVER_FLAG_CONTIGUOUS & S->flags) {
+    mpfr_vars_custom_raise_prec(S->x_lower, 1, prec);
+    mpfr_vars_custom_raise_prec(S->x_upper, 1, prec);
+  } else {
+    mpfr_vars_raise_prec(S->x_lower, 1, prec);
+    mpfr_vars_raise_prec(S->x_upper, 1, prec);
+  }
+  fsolver_vars_set_prec(S, S->root, 1, prec);
+  fsolver_set_state_prec(S, prec);
+  retval = fsolver_driver_set(S, S->x_lower, S->x_upper);
+  if ((MP_ODRF_ERROR_ENDPOINTS_DO_NOT_STRADDLE == retval) ||
+      (MP_ODRF_ERROR_SIGN_IS_UNCERTAIN == retval))
+    retval = fsolver_widen_bracket(S, old_prec);
+  return retval;
+}
+static mp_odrf_code_t
+fsolver_escalate (mp_odrf_mpfr_root_fsolver_t * S)
+/* Double the working precision, up to the one of the solver. */
+{
+  mp_prec_t	prec = mpfr_get_prec(S->root);
+  return fsolver_raise_working_prec(S, (prec < S->prec / 2)? 2 * prec : S->prec);
+}
+static mp_odrf_code_t
+fsolver_ball_sign (mp_odrf_mpfr_root_fsolver_t * S, mpfr_ptr x, int * sign)
+/* Store in SIGN the  sign of the ball function at X.   The driver state
+   is not used anymore, so its first number holds the midpoint. */
+{
+  mp_odrf_mpfr_function_t *	F = S->function;
+  mpfr_ptr			y = S->driver_state;
+  mp_odrf_code_t		retval;
+  MPFR_DECL_INIT(radius, MP_ODRF_BALL_RADIUS_PREC);
+  retval = (F->ball)(y, radius, x, F->params);
+  if (MP_ODRF_OK != retval)
+    return retval;
+  else if (! mpfr_number_p(y))
+    return MP_ODRF_ERROR_FUNCTION_VALUE_IS_NOT_FINITE;
+  else if (! mp_odrf_ball_sign_is_certain(y, radius))
+    return MP_ODRF_ERROR_SIGN_IS_UNCERTAIN;
+  *sign = mpfr_sgn(y);
+  return MP_ODRF_OK;
+}
+static mp_odrf_code_t
+fsolver_ball_bisect (mp_odrf_mpfr_root_fsolver_t * S)
+/* Halve the bracket deciding the signs with the ball function. */
+{
+  mp_odrf_code_t	retval = MP_ODRF_OK;
+  int			sign;
+  if (mpfr_equal_p(S->x_lower, S->x_upper))
+    return retval;		/* the root is exact */
+  if (0 == S->ball_lower_sign) {
+    retval = fsolver_ball_sign(S, S->x_lower, &S->ball_lower_sign);
+    if ((MP_ODRF_OK == retval) && (0 == S->ball_lower_sign)) {
+      mpfr_set(S->root,    S->x_lower, GMP_RNDN);
+      mpfr_set(S->x_upper, S->x_lower, GMP_RNDN);
+      return retval;
+    }
+  }
+  if (MP_ODRF_OK == retval) {
+    if (mp_odrf_bracket_is_exhausted(S->root, S->x_lower, S->x_upper))
+      return MP_ODRF_BRACKET_EXHAUSTED;
+    retval = fsolver_ball_sign(S, S->root, &sign);
+    if (MP_ODRF_OK == retval) {
+      if (0 == sign) {
+	mpfr_set(S->x_lower, S->root, GMP_RNDN);
+	mpfr_set(S->x_upper, S->root, GMP_RNDN);
+      } else if (sign == S->ball_lower_sign)
+	mpfr_set(S->x_lower, S->root, GMP_RNDN);
+      else
+	mpfr_set(S->x_upper, S->root, GMP_RNDN);
+    }
+  }
+  return retval;
+}
+static int
+fsolver_step (mp_odrf_mpfr_root_fsolver_t * S, int bisect)
+/* Perform an iteration of the driver, or a ball bisection if BISECT is
+   true, inside the arena if any. */
+{
+  mp_odrf_arena_frame_t	frame;
+  int			retval;
+  if (S->arena)
+    mp_odrf_arena_enter(S->arena, &frame);
+  if (bisect)
+    retval = fsolver_ball_bisect(S);
+  else
+    retval = (S->driver->iterate) (S->driver_state, S->function, S->root,
+				   S->x_lower, S->x_upper);
+  if (S->arena)
+    mp_odrf_arena_leave(S->arena, &frame);
+  return retval;
+}
+static int
+fsolver_iterate (mp_odrf_mpfr_root_fsolver_t * S)
+/* Perform an iteration; in adaptive mode raise the working precision
+   when the bracket is narrow at the current one. */
+{
+  int	retval;
+  if (S->ball_lower_sign)
+    return fsolver_step(S, 1);
+  retval = fsolver_step(S, 0);
+  if ((MP_ODRF_OK == retval) && S->start_prec &&
+      (mpfr_get_prec(S->root) < S->prec) && fsolver_bracket_is_narrow(S))
+    retval = fsolver_escalate(S);
+  else if (MP_ODRF_BRACKET_EXHAUSTED == retval) {
+    /* In adaptive  mode the bracket is  exhausted only at  the  working
+       precision: we go on with more bits. */
+    if (S->start_prec && (mpfr_get_prec(S->root) < S->prec))
+      retval = fsolver_escalate(S);
+  }
+  else if (MP_ODRF_ERROR_SIGN_IS_UNCERTAIN == retval) {
+    /* A ball function could not decide the sign at the point chosen by
+       the driver, but the  bounds are untouched: in adaptive mode we try
+       again with more bits, else the root is close to that point and
+       the bracket can still be narrowed by bisection. */
+    if (S->start_prec && (mpfr_get_prec(S->root) < S->prec))
+      retval = fsolver_escalate(S);
+    else if (S->function->ball)
+      retval = fsolver_step(S, 1);
+  }
+  return retval;
+}
 
 
 /** --------------------------------------------------------------------
  ** Root bracketing solver API.
  ** ----------------------------------------------------------------- */
 
-mp_odrf_mpfr_root_fsolver_t *
-mp_odrf_mpfr_root_fsolver_alloc (const mp_odrf_mpfr_root_fsolver_driver_t * T)
-/* Allocate and initialise a new root bracketing state struct to use the
-   selected algorithm driver. */
+/* With inline limbs the default constructors use the contiguous layout,
+   so the heap one is not needed. */
+#ifndef MP_ODRF_INLINE_LIMBS
+static mp_odrf_mpfr_root_fsolver_t *
+fsolver_alloc_heap (const mp_odrf_mpfr_root_fsolver_driver_t * T,
+		    const mp_odrf_allocator_t * A, mp_prec_t prec)
+/* Allocate the solver  struct and the driver state  as separate blocks
+   obtained from A; the limbs of  the MPFR numbers, with precision PREC,
+   are allocated by MPFR itself. */
 {
-  mp_odrf_mpfr_root_fsolver_t * S = malloc(sizeof(mp_odrf_mpfr_root_fsolver_t));
+  mp_odrf_mpfr_root_fsolver_t * S = MP_ODRF_ALLOC(A, sizeof(mp_odrf_mpfr_root_fsolver_t));
   if (NULL != S) {
-    S->driver_state = malloc(T->driver_state_size);
+    S->driver_state = MP_ODRF_ALLOC(A, T->driver_state_size);
     if (NULL != S->driver_state) {
-      T->init(S->driver_state);
       S->driver		= T;
       S->function	= NULL;
-      mpfr_init(S->root);
-      mpfr_init(S->x_lower);
-      mpfr_init(S->x_upper);
+      S->arena		= NULL;
+      S->allocator	= A;
+      S->flags		= 0;
+      S->prec		= prec;
+      S->ordinate_prec	= prec;
+      S->start_prec	= 0;
+      S->ball_lower_sign = 0;
+      mpfr_init2(S->root,    prec);
+      mpfr_init2(S->x_lower, prec);
+      mpfr_init2(S->x_upper, prec);
+      mpfr_vars_init(S->driver_state, T->driver_state_mpfr_count, prec);
+      if (T->init)
+	T->init(S->driver_state, S->flags);
     } else {
-      free(S);
+      MP_ODRF_FREE(A, S);
       S = NULL;
     }
   }
   return S;
 }
+#endif
+static size_t
+fsolver_limbs_offset (const mp_odrf_mpfr_root_fsolver_driver_t * T)
+/* Return the offset of the limbs from the beginning of the block. */
+{
+  return MP_ODRF_ALIGN(sizeof(mp_odrf_mpfr_root_fsolver_t)) + MP_ODRF_ALIGN(T->driver_state_size);
+}
+static mp_odrf_mpfr_root_fsolver_t *
+fsolver_init_block (void * buffer, const mp_odrf_mpfr_root_fsolver_driver_t * T,
+		    const mp_odrf_allocator_t * A, mp_prec_t prec, unsigned flags)
+/* Lay out in BUFFER the solver struct, the driver state and the limbs of
+   all the MPFR numbers, with precision PREC.  BUFFER must be at least
+   "mp_odrf_mpfr_root_fsolver_sizeof(T, PREC)" bytes wide. */
+{
+  char *	block		= buffer;
+  size_t	limbs_size	= mpfr_custom_get_size(prec);
+  char *	limbs		= block + fsolver_limbs_offset(T);
+  mp_odrf_mpfr_root_fsolver_t * S = buffer;
+  S->driver_state	= block + MP_ODRF_ALIGN(sizeof(mp_odrf_mpfr_root_fsolver_t));
+  S->driver		= T;
+  S->function		= NULL;
+  S->arena		= NULL;
+  S->allocator	= A;
+  S->flags		= flags;
+  S->prec		= prec;
+  S->ordinate_prec	= prec;
+  S->start_prec		= 0;
+  S->ball_lower_sign	= 0;
+  mpfr_vars_custom_init(S->root,    1, prec, limbs);
+  limbs += limbs_size;
+  mpfr_vars_custom_init(S->x_lower, 1, prec, limbs);
+  limbs += limbs_size;
+  mpfr_vars_custom_init(S->x_upper, 1, prec, limbs);
+  limbs += limbs_size;
+  mpfr_vars_custom_init(S->driver_state, T->driver_state_mpfr_count, prec, limbs);
+  if (T->init)
+    T->init(S->driver_state, S->flags);
+  return S;
+}
+size_t
+mp_odrf_mpfr_root_fsolver_sizeof (const mp_odrf_mpfr_root_fsolver_driver_t * T, mp_prec_t prec)
+/* Return the number  of bytes needed to store  a solver with driver T
+   and precision PREC in a single block. */
+{
+  size_t	nvars	= 3 + T->driver_state_mpfr_count;
+  return MP_ODRF_ALIGN(fsolver_limbs_offset(T) + nvars * mpfr_custom_get_size(prec));
+}
+mp_odrf_mpfr_root_fsolver_t *
+mp_odrf_fsolver_alloc_contiguous (const mp_odrf_mpfr_root_fsolver_driver_t * T,
+				  const mp_odrf_allocator_t * A, mp_prec_t prec)
+/* Allocate the solver struct, the  driver state and the limbs of all the
+   MPFR numbers, with precision PREC, in a single block obtained from A. */
+{
+  void *	block = MP_ODRF_ALLOC(A, mp_odrf_mpfr_root_fsolver_sizeof(T, prec));
+  if (NULL != block)
+    return fsolver_init_block(block, T, A, prec, MP_ODRF_SOLVER_FLAG_CONTIGUOUS);
+  else
+    return NULL;
+}
+mp_odrf_mpfr_root_fsolver_t *
+mp_odrf_mpfr_root_fsolver_init_in_place (void * buffer,
+					 const mp_odrf_mpfr_root_fsolver_driver_t * T,
+					 mp_prec_t prec)
+/* Initialise  a solver  in  the caller-provided  BUFFER,  which must  be
+   "mp_odrf_mpfr_root_fsolver_sizeof(T, PREC)" bytes wide. */
+{
+  return fsolver_init_block(buffer, T, NULL, prec,
+			    (MP_ODRF_SOLVER_FLAG_CONTIGUOUS | MP_ODRF_SOLVER_FLAG_IN_PLACE));
+}
+void
+mp_odrf_mpfr_root_fsolver_fini_in_place (mp_odrf_mpfr_root_fsolver_t * S)
+/* Finalise  a solver initialised in place;  the buffer is not released. */
+{
+  if (S->driver->final)
+    S->driver->final(S->driver_state);
+}
+mp_odrf_mpfr_root_fsolver_t *
+mp_odrf_mpfr_root_fsolver_alloc (const mp_odrf_mpfr_root_fsolver_driver_t * T)
+/* Allocate and initialise a new root bracketing state struct to use the
+   selected algorithm driver and the current default precision. */
+{
+  return mp_odrf_mpfr_root_fsolver_alloc2(T, mpfr_get_default_prec());
+}
+mp_odrf_mpfr_root_fsolver_t *
+mp_odrf_mpfr_root_fsolver_alloc2 (const mp_odrf_mpfr_root_fsolver_driver_t * T, mp_prec_t prec)
+/* Allocate and  initialise a new  root bracketing state struct to use the
+   selected algorithm driver; all the MPFR numbers have precision PREC,
+   regardless of the default one. */
+{
+  if ((prec < MPFR_PREC_MIN) || (prec > MPFR_PREC_MAX))
+    return NULL;
+#ifdef MP_ODRF_INLINE_LIMBS
+  return mp_odrf_fsolver_alloc_contiguous(T, mp_odrf_get_allocator(), prec);
+#else
+  return fsolver_alloc_heap(T, mp_odrf_get_allocator(), prec);
+#endif
+}
+mp_odrf_mpfr_root_fsolver_t *
+mp_odrf_mpfr_root_fsolver_alloc_contiguous (const mp_odrf_mpfr_root_fsolver_driver_t * T)
+/* Allocate and initialise a new root bracketing state struct to use the
+   selected algorithm driver.  The  solver struct, the driver state and
+   the limbs of all the MPFR numbers are laid out in a single block. */
+{
+  return mp_odrf_fsolver_alloc_contiguous(T, mp_odrf_get_allocator(), mpfr_get_default_prec());
+}
+mp_odrf_mpfr_root_fsolver_t *
+mp_odrf_mpfr_root_fsolver_alloc_with_allocator (const mp_odrf_mpfr_root_fsolver_driver_t * T,
+						const mp_odrf_allocator_t * A)
+/* Like "mp_odrf_mpfr_root_fsolver_alloc_contiguous()", but obtain the
+   memory block from A. */
+{
+  return mp_odrf_fsolver_alloc_contiguous(T, A, mpfr_get_default_prec());
+}
 void
 mp_odrf_mpfr_root_fsolver_free (mp_odrf_mpfr_root_fsolver_t * S)
 /* Finalise and release a root bracketing state struct. */
 {
-  mpfr_clear(S->root);
-  mpfr_clear(S->x_lower);
-  mpfr_clear(S->x_upper);
-  S->driver->final(S->driver_state);
-  free(S->driver_state);
-  free(S);
+  const mp_odrf_allocator_t *	A = S->allocator;
+  if (S->driver->final)
+    S->driver->final(S->driver_state);
+  if (MP_ODRF_SOLVER_FLAG_IN_PLACE & S->flags) {
+    /* The caller owns the memory. */
+    ;
+  } else if (MP_ODRF_SOLVER_FLAG_CONTIGUOUS & S->flags) {
+    /* The limbs live in the same block of the struct. */
+    MP_ODRF_FREE(A, S);
+  } else {
+    mpfr_clear(S->root);
+    mpfr_clear(S->x_lower);
+    mpfr_clear(S->x_upper);
+    mpfr_vars_clear(S->driver_state, S->driver->driver_state_mpfr_count);
+    MP_ODRF_FREE(A, S->driver_state);
+    MP_ODRF_FREE(A, S);
+  }
+}
+void
+mp_odrf_mpfr_root_fsolver_reset (mp_odrf_mpfr_root_fsolver_t * S)
+/* Forget the  current problem, but keep  the storage of all  the MPFR
+   numbers; the solver must be set again before iterating.  The driver
+   parameters are restored to their defaults. */
+{
+  S->function = NULL;
+  if (S->arena)
+    mp_odrf_arena_reset(S->arena);
+  mpfr_set_nan(S->root);
+  mpfr_set_nan(S->x_lower);
+  mpfr_set_nan(S->x_upper);
+  mpfr_vars_set_nan(S->driver_state, S->driver->driver_state_mpfr_count);
+  if (S->driver->final)
+    S->driver->final(S->driver_state);
+  if (S->driver->init)
+    S->driver->init(S->driver_state, S->flags);
 }
 mp_odrf_code_t
-mp_odrf_mpfr_root_fsolver_set (mp_odrf_mpfr_root_fsolver_t * S,
-			       mp_odrf_mpfr_function_t * F,
-			       mpfr_t x_lower, mpfr_t x_upper)
-/* Select the  math function to be  searched for roots for  a given root
-   bracketing state struct.  Also selects the search bracket. */
+mp_odrf_mpfr_root_fsolver_set_ordinate_prec (mp_odrf_mpfr_root_fsolver_t * S, mp_prec_t prec)
+/* Set  to PREC the  precision of the  ordinates in the  driver state.
+   The limbs  of a contiguous  solver were laid  out for the precision
+   of the abscissae, which is the one of the root. */
+{
+  if ((prec < MPFR_PREC_MIN) || (prec > MPFR_PREC_MAX))
+    return MP_ODRF_ERROR_INVALID_PRECISION;
+  if ((MP_ODRF_SOLVER_FLAG_CONTIGUOUS & S->flags) && (prec > S->prec))
+    return MP_ODRF_ERROR_INVALID_PRECISION;
+  S->ordinate_prec = prec;
+  fsolver_vars_set_prec(S, S->driver_state, S->driver->driver_state_ordinate_count, prec);
+  return MP_ODRF_OK;
+}
+mp_odrf_code_t
+mp_odrf_mpfr_root_fsolver_set_adaptive_prec (mp_odrf_mpfr_root_fsolver_t * S, mp_prec_t prec)
+/* Select the starting precision of the adaptive mode, or the fixed mode
+   if PREC is zero; in the latter case all the numbers get back the
+   precision of the solver. */
+{
+  if (0 == prec) {
+    S->start_prec = 0;
+    fsolver_set_working_prec(S, S->prec);
+  } else if ((prec < MPFR_PREC_MIN) || (prec > MPFR_PREC_MAX)) {
+    return MP_ODRF_ERROR_INVALID_PRECISION;
+  } else
+    S->start_prec = prec;
+  return MP_ODRF_OK;
+}
+static mp_odrf_code_t
+fsolver_set (mp_odrf_mpfr_root_fsolver_t * S, mp_odrf_mpfr_function_t * F,
+	     mpfr_t x_lower, mpfr_t x_upper, mp_prec_t prec)
+/* Select the function and the bracket, starting at working precision
+   PREC. */
 {
   mp_odrf_code_t	retval = MP_ODRF_OK;
   if (mpfr_greater_p(x_lower, x_upper)) {
     retval = MP_ODRF_ERROR_INVALID_BRACKET_INTERVAL;
   } else {
     S->function = F;
-    {
-      mpfr_t	tmp;
-      mpfr_init(tmp);
-      {
-	/* s->root = 0.5 * (x_lower + x_upper); */
-	mpfr_add(tmp, x_lower, x_upper, GMP_RNDN);
-	mpfr_mul_d(S->root, tmp, 0.5, GMP_RNDN);
-      }
-      mpfr_clear(tmp);
-    }
+    S->ball_lower_sign = 0;
+    if (S->start_prec || (mpfr_get_prec(S->root) != prec))
+      fsolver_set_working_prec(S, prec);
+    /* s->root = 0.5 * (x_lower + x_upper); */
+    mpfr_add(S->root, x_lower, x_upper, GMP_RNDN);
+    mpfr_div_2ui(S->root, S->root, 1, GMP_RNDN);
     mpfr_set(S->x_lower, x_lower, GMP_RNDD);
     mpfr_set(S->x_upper, x_upper, GMP_RNDU);
-    retval = (S->driver->set)(S->driver_state, S->function, S->root, x_lower, x_upper);
+    if (S->start_prec || (prec < S->prec)) {
+      /* The driver sees the bounds rounded outwards to the starting
+	 precision. */
+      x_lower = S->x_lower;
+      x_upper = S->x_upper;
+    }
+    /* A new solve begins: the memory of the previous one is garbage. */
+    if (S->arena)
+      mp_odrf_arena_reset(S->arena);
+    retval = fsolver_driver_set(S, x_lower, x_upper);
   }
   return retval;
 }
+mp_odrf_code_t
+mp_odrf_mpfr_root_fsolver_set (mp_odrf_mpfr_root_fsolver_t * S,
+			       mp_odrf_mpfr_function_t * F,
+			       mpfr_t x_lower, mpfr_t x_upper)
+/* Select the  math function to be  searched for roots for  a given root
+   bracketing state struct.  Also selects the search bracket. */
+{
+  return fsolver_set(S, F, x_lower, x_upper,
+		     (S->start_prec && (S->start_prec < S->prec))? S->start_prec : S->prec);
+}
+void
+mp_odrf_mpfr_root_fsolver_set_arena (mp_odrf_mpfr_root_fsolver_t * S, mp_odrf_arena_t * arena)
+/* Select the arena used while calling the driver functions. */
+{
+  S->arena = arena;
+}
 int
 mp_odrf_mpfr_root_fsolver_iterate (mp_odrf_mpfr_root_fsolver_t * S)
 /* Perform a search iteration for a root bracketing state struct. */
 {
-  return (S->driver->iterate) (S->driver_state, S->function, S->root,
-			       S->x_lower, S->x_upper);
+  return fsolver_iterate(S);
 }
 const char *
 mp_odrf_mpfr_root_fsolver_name (const mp_odrf_mpfr_root_fsolver_t * S)
@@ -113,6 +759,12 @@ mp_odrf_mpfr_root_fsolver_name (const mp_odrf_mpfr_root_fsolver_t * S)
 {
   return S->driver->name;
 }
+mp_prec_t
+mp_odrf_mpfr_root_fsolver_prec (const mp_odrf_mpfr_root_fsolver_t * S)
+/* Return the precision the solver was allocated with. */
+{
+  return S->prec;
+}
 mpfr_ptr
 mp_odrf_mpfr_root_fsolver_root (const mp_odrf_mpfr_root_fsolver_t * S)
 /* Return the current estimate solution. */
@@ -132,39 +784,282 @@ mp_odrf_mpfr_root_fsolver_x_upper (const mp_odrf_mpfr_root_fsolver_t * S)
   return (mpfr_ptr)S->x_upper;
 }
 
+
+/** --------------------------------------------------------------------
+ ** Root bracketing solver: correctly rounded roots.
+ ** ----------------------------------------------------------------- */
+
+/* The first  pass of a correctly rounded  solve works with this  many bits
+   above the target precision; they are doubled at each escalation. */
+#define ROUNDING_GUARD_BITS	8
+
+static int
+fsolver_rounding_is_decided (mp_odrf_mpfr_root_fsolver_t * S, mpfr_ptr rop, mpfr_ptr tmp,
+			     mp_rnd_t rnd, int * ternary)
+/* Return true if both  the bounds round to the same number  and it is not
+   strictly inside the bracket; store it in ROP and the sign of its error
+   in TERNARY.  After an iteration the function is not zero at the bounds,
+   unless the bracket is reduced to an exact root. */
+{
+  if (mpfr_equal_p(S->x_lower, S->x_upper)) {
+    *ternary = mpfr_set(rop, S->x_lower, rnd);
+    return 1;
+  }
+  mpfr_set(rop, S->x_lower, rnd);
+  mpfr_set(tmp, S->x_upper, rnd);
+  if (! mpfr_equal_p(rop, tmp))
+    return 0;
+  else if (mpfr_lessequal_p(rop, S->x_lower))
+    *ternary = -1;
+  else if (mpfr_greaterequal_p(rop, S->x_upper))
+    *ternary = +1;
+  else
+    return 0;
+  return 1;
+}
+static mp_odrf_code_t
+fsolver_solve_rounded (mp_odrf_mpfr_root_fsolver_t * S, mpfr_ptr rop, mpfr_ptr tmp,
+		       mpfr_ptr lower, mpfr_ptr upper, mp_rnd_t rnd, int * ternary)
+/* LOWER and UPPER hold the bracket before each iteration: they must have
+   the precision of the solver. */
+{
+  mp_prec_t		target = mpfr_get_prec(rop);
+  mp_prec_t		guard  = ROUNDING_GUARD_BITS;
+  mp_odrf_code_t	retval;
+  for (;;) {
+    mpfr_set(lower, S->x_lower, GMP_RNDN);
+    mpfr_set(upper, S->x_upper, GMP_RNDN);
+    retval = fsolver_iterate(S);
+    if (MP_ODRF_OK == retval) {
+      if (fsolver_rounding_is_decided(S, rop, tmp, rnd, ternary))
+	break;
+      /* A driver with  a minimum step, like Brent's  with a tolerance,
+	 stops narrowing the bracket before the precision is exhausted. */
+      if ((! mpfr_equal_p(lower, S->x_lower)) || (! mpfr_equal_p(upper, S->x_upper)))
+	continue;
+    } else if ((MP_ODRF_BRACKET_EXHAUSTED != retval) &&
+	       (MP_ODRF_ERROR_SIGN_IS_UNCERTAIN != retval))
+      break;
+    /* The bracket is as narrow as the working precision allows. */
+    if (fsolver_rounding_is_decided(S, rop, tmp, rnd, ternary)) {
+      retval = MP_ODRF_OK;
+      break;
+    } else if (mpfr_get_prec(S->root) == S->prec) {
+      retval = MP_ODRF_ERROR_ROUNDING_IS_UNDECIDED;
+      break;
+    }
+    guard *= 2;
+    S->ball_lower_sign = 0;
+    retval = fsolver_raise_working_prec(S, (target + guard < S->prec)? target + guard : S->prec);
+    if (MP_ODRF_OK != retval)
+      break;
+  }
+  return retval;
+}
+mp_odrf_code_t
+mp_odrf_mpfr_root_fsolver_solve_rounded (mp_odrf_mpfr_root_fsolver_t * S,
+					 mp_odrf_mpfr_function_t * F,
+					 mpfr_t x_lower, mpfr_t x_upper,
+					 mpfr_ptr rop, int * ternary, mp_rnd_t rnd)
+/* Search  the root  in  the bracket  and  store it  in ROP  correctly
+   rounded, Ziv-style: the working  precision starts a few bits above the
+   one of ROP and it is raised only when the bounds of the narrowest
+   bracket do not round to the same number. */
+{
+  mp_prec_t		target = mpfr_get_prec(rop);
+  mp_prec_t		start_prec = S->start_prec;
+  mp_odrf_code_t	retval;
+  if (target >= S->prec)
+    return MP_ODRF_ERROR_INVALID_PRECISION;
+  /* The adaptive mode would raise the precision before it is needed. */
+  S->start_prec = 0;
+  retval = fsolver_set(S, F, x_lower, x_upper,
+		       (target + ROUNDING_GUARD_BITS < S->prec)? target + ROUNDING_GUARD_BITS : S->prec);
+  if (MP_ODRF_OK == retval) {
+    mpfr_t	tmp, lower, upper;
+    mpfr_init2(tmp, target);
+    mpfr_inits2(S->prec, lower, upper, (mpfr_ptr)0);
+    /* The driver calls enter the arena by themselves: the precision is
+       raised outside of it. */
+    retval = fsolver_solve_rounded(S, rop, tmp, lower, upper, rnd, ternary);
+    mpfr_clears(tmp, lower, upper, (mpfr_ptr)0);
+  }
+  S->start_prec = start_prec;
+  return retval;
+}
+
 
 /** --------------------------------------------------------------------
  ** Root polishing solver API.
  ** ----------------------------------------------------------------- */
 
-mp_odrf_mpfr_root_fdfsolver_t *
-mp_odrf_mpfr_root_fdfsolver_alloc (const mp_odrf_mpfr_root_fdfsolver_driver_t * T)
-/* Allocate and initialise a new root  polishing state struct to use the
-   selected algorithm driver. */
+#ifndef MP_ODRF_INLINE_LIMBS
+static mp_odrf_mpfr_root_fdfsolver_t *
+fdfsolver_alloc_heap (const mp_odrf_mpfr_root_fdfsolver_driver_t * T,
+		      const mp_odrf_allocator_t * A, mp_prec_t prec)
+/* Allocate the solver  struct and the driver state  as separate blocks
+   obtained from A; the limbs of  the MPFR numbers, with precision PREC,
+   are allocated by MPFR itself. */
 {
-  mp_odrf_mpfr_root_fdfsolver_t * S = malloc(sizeof(mp_odrf_mpfr_root_fdfsolver_t));
+  mp_odrf_mpfr_root_fdfsolver_t * S = MP_ODRF_ALLOC(A, sizeof(mp_odrf_mpfr_root_fdfsolver_t));
   if (NULL != S) {
-    S->driver_state = malloc(T->driver_state_size);
+    S->driver_state = MP_ODRF_ALLOC(A, T->driver_state_size);
     if (NULL != S->driver_state) {
-      T->init(S->driver_state);
-      S->driver	= T;
-      S->fdf	= NULL;
-      mpfr_init(S->root);
+      S->driver		= T;
+      S->fdf		= NULL;
+      S->arena		= NULL;
+      S->allocator	= A;
+      S->flags		= 0;
+      mpfr_init2(S->root, prec);
+      mpfr_vars_init(S->driver_state, T->driver_state_mpfr_count, prec);
+      if (T->init)
+	T->init(S->driver_state, S->flags);
     } else {
-      free(S);
+      MP_ODRF_FREE(A, S);
       S = NULL;
     }
   }
   return S;
 }
+#endif
+static size_t
+fdfsolver_limbs_offset (const mp_odrf_mpfr_root_fdfsolver_driver_t * T)
+/* Return the offset of the limbs from the beginning of the block. */
+{
+  return MP_ODRF_ALIGN(sizeof(mp_odrf_mpfr_root_fdfsolver_t)) + MP_ODRF_ALIGN(T->driver_state_size);
+}
+static mp_odrf_mpfr_root_fdfsolver_t *
+fdfsolver_init_block (void * buffer, const mp_odrf_mpfr_root_fdfsolver_driver_t * T,
+		      const mp_odrf_allocator_t * A, mp_prec_t prec, unsigned flags)
+/* Lay out in BUFFER the solver struct, the driver state and the limbs of
+   all the MPFR numbers, with precision PREC.  BUFFER must be at least
+   "mp_odrf_mpfr_root_fdfsolver_sizeof(T, PREC)" bytes wide. */
+{
+  char *	block		= buffer;
+  size_t	limbs_size	= mpfr_custom_get_size(prec);
+  char *	limbs		= block + fdfsolver_limbs_offset(T);
+  mp_odrf_mpfr_root_fdfsolver_t * S = buffer;
+  S->driver_state	= block + MP_ODRF_ALIGN(sizeof(mp_odrf_mpfr_root_fdfsolver_t));
+  S->driver		= T;
+  S->fdf		= NULL;
+  S->arena		= NULL;
+  S->allocator	= A;
+  S->flags		= flags;
+  mpfr_vars_custom_init(S->root, 1, prec, limbs);
+  limbs += limbs_size;
+  mpfr_vars_custom_init(S->driver_state, T->driver_state_mpfr_count, prec, limbs);
+  if (T->init)
+    T->init(S->driver_state, S->flags);
+  return S;
+}
+size_t
+mp_odrf_mpfr_root_fdfsolver_sizeof (const mp_odrf_mpfr_root_fdfsolver_driver_t * T, mp_prec_t prec)
+/* Return the number  of bytes needed to store  a solver with driver T
+   and precision PREC in a single block. */
+{
+  size_t	nvars	= 1 + T->driver_state_mpfr_count;
+  return MP_ODRF_ALIGN(fdfsolver_limbs_offset(T) + nvars * mpfr_custom_get_size(prec));
+}
+mp_odrf_mpfr_root_fdfsolver_t *
+mp_odrf_fdfsolver_alloc_contiguous (const mp_odrf_mpfr_root_fdfsolver_driver_t * T,
+				    const mp_odrf_allocator_t * A, mp_prec_t prec)
+/* Allocate the solver struct, the  driver state and the limbs of all the
+   MPFR numbers, with precision PREC, in a single block obtained from A. */
+{
+  void *	block = MP_ODRF_ALLOC(A, mp_odrf_mpfr_root_fdfsolver_sizeof(T, prec));
+  if (NULL != block)
+    return fdfsolver_init_block(block, T, A, prec, MP_ODRF_SOLVER_FLAG_CONTIGUOUS);
+  else
+    return NULL;
+}
+mp_odrf_mpfr_root_fdfsolver_t *
+mp_odrf_mpfr_root_fdfsolver_init_in_place (void * buffer,
+					   const mp_odrf_mpfr_root_fdfsolver_driver_t * T,
+					   mp_prec_t prec)
+/* Initialise  a solver  in  the caller-provided  BUFFER,  which must  be
+   "mp_odrf_mpfr_root_fdfsolver_sizeof(T, PREC)" bytes wide. */
+{
+  return fdfsolver_init_block(buffer, T, NULL, prec,
+			      (MP_ODRF_SOLVER_FLAG_CONTIGUOUS | MP_ODRF_SOLVER_FLAG_IN_PLACE));
+}
+void
+mp_odrf_mpfr_root_fdfsolver_fini_in_place (mp_odrf_mpfr_root_fdfsolver_t * S)
+/* Finalise  a solver initialised in place;  the buffer is not released. */
+{
+  if (S->driver->final)
+    S->driver->final(S->driver_state);
+}
+mp_odrf_mpfr_root_fdfsolver_t *
+mp_odrf_mpfr_root_fdfsolver_alloc (const mp_odrf_mpfr_root_fdfsolver_driver_t * T)
+/* Allocate and initialise a new root  polishing state struct to use the
+   selected algorithm driver and the current default precision. */
+{
+  return mp_odrf_mpfr_root_fdfsolver_alloc2(T, mpfr_get_default_prec());
+}
+mp_odrf_mpfr_root_fdfsolver_t *
+mp_odrf_mpfr_root_fdfsolver_alloc2 (const mp_odrf_mpfr_root_fdfsolver_driver_t * T, mp_prec_t prec)
+/* Allocate and  initialise a new  root  polishing state struct to use the
+   selected algorithm driver; all the MPFR numbers have precision PREC,
+   regardless of the default one. */
+{
+  if ((prec < MPFR_PREC_MIN) || (prec > MPFR_PREC_MAX))
+    return NULL;
+#ifdef MP_ODRF_INLINE_LIMBS
+  return mp_odrf_fdfsolver_alloc_contiguous(T, mp_odrf_get_allocator(), prec);
+#else
+  return fdfsolver_alloc_heap(T, mp_odrf_get_allocator(), prec);
+#endif
+}
+mp_odrf_mpfr_root_fdfsolver_t *
+mp_odrf_mpfr_root_fdfsolver_alloc_contiguous (const mp_odrf_mpfr_root_fdfsolver_driver_t * T)
+/* Allocate and initialise a new root  polishing state struct to use the
+   selected algorithm driver.  The  solver struct, the driver state and
+   the limbs of all the MPFR numbers are laid out in a single block. */
+{
+  return mp_odrf_fdfsolver_alloc_contiguous(T, mp_odrf_get_allocator(), mpfr_get_default_prec());
+}
+mp_odrf_mpfr_root_fdfsolver_t *
+mp_odrf_mpfr_root_fdfsolver_alloc_with_allocator (const mp_odrf_mpfr_root_fdfsolver_driver_t * T,
+						  const mp_odrf_allocator_t * A)
+/* Like "mp_odrf_mpfr_root_fdfsolver_alloc_contiguous()", but obtain the
+   memory block from A. */
+{
+  return mp_odrf_fdfsolver_alloc_contiguous(T, A, mpfr_get_default_prec());
+}
 void
 mp_odrf_mpfr_root_fdfsolver_free (mp_odrf_mpfr_root_fdfsolver_t * S)
 /* Finalise and release a root polishing state struct. */
 {
-  mpfr_clear(S->root);
-  S->driver->final(S->driver_state);
-  free(S->driver_state);
-  free(S);
+  const mp_odrf_allocator_t *	A = S->allocator;
+  if (S->driver->final)
+    S->driver->final(S->driver_state);
+  if (MP_ODRF_SOLVER_FLAG_IN_PLACE & S->flags) {
+    /* The caller owns the memory. */
+    ;
+  } else if (MP_ODRF_SOLVER_FLAG_CONTIGUOUS & S->flags) {
+    /* The limbs live in the same block of the struct. */
+    MP_ODRF_FREE(A, S);
+  } else {
+    mpfr_clear(S->root);
+    mpfr_vars_clear(S->driver_state, S->driver->driver_state_mpfr_count);
+    MP_ODRF_FREE(A, S->driver_state);
+    MP_ODRF_FREE(A, S);
+  }
+}
+void
+mp_odrf_mpfr_root_fdfsolver_reset (mp_odrf_mpfr_root_fdfsolver_t * S)
+/* Forget the  current problem, but keep  the storage of all  the MPFR
+   numbers; the solver must be set again before iterating. */
+{
+  S->fdf = NULL;
+  if (S->arena)
+    mp_odrf_arena_reset(S->arena);
+  mpfr_set_nan(S->root);
+  mpfr_vars_set_nan(S->driver_state, S->driver->driver_state_mpfr_count);
+  if (S->driver->final)
+    S->driver->final(S->driver_state);
+  if (S->driver->init)
+    S->driver->init(S->driver_state, S->flags);
 }
 mp_odrf_code_t
 mp_odrf_mpfr_root_fdfsolver_set (mp_odrf_mpfr_root_fdfsolver_t * S,
@@ -175,13 +1070,37 @@ mp_odrf_mpfr_root_fdfsolver_set (mp_odrf_mpfr_root_fdfsolver_t * S,
 {
   S->fdf = F;
   mpfr_set(S->root, root, GMP_RNDN);
-  return (S->driver->set)(S->driver_state, S->fdf, S->root);
+  if (S->arena) {
+    /* A new solve begins: the memory of the previous one is garbage. */
+    mp_odrf_arena_frame_t	frame;
+    mp_odrf_code_t		retval;
+    mp_odrf_arena_reset(S->arena);
+    mp_odrf_arena_enter(S->arena, &frame);
+    retval = (S->driver->set)(S->driver_state, S->fdf, S->root);
+    mp_odrf_arena_leave(S->arena, &frame);
+    return retval;
+  } else
+    return (S->driver->set)(S->driver_state, S->fdf, S->root);
+}
+void
+mp_odrf_mpfr_root_fdfsolver_set_arena (mp_odrf_mpfr_root_fdfsolver_t * S, mp_odrf_arena_t * arena)
+/* Select the arena used while calling the driver functions. */
+{
+  S->arena = arena;
 }
 int
 mp_odrf_mpfr_root_fdfsolver_iterate (mp_odrf_mpfr_root_fdfsolver_t * S)
 /* Perform a search iteration for a root polishing state struct. */
 {
-  return (S->driver->iterate) (S->driver_state, S->fdf, S->root);
+  if (S->arena) {
+    mp_odrf_arena_frame_t	frame;
+    int				retval;
+    mp_odrf_arena_enter(S->arena, &frame);
+    retval = (S->driver->iterate) (S->driver_state, S->fdf, S->root);
+    mp_odrf_arena_leave(S->arena, &frame);
+    return retval;
+  } else
+    return (S->driver->iterate) (S->driver_state, S->fdf, S->root);
 }
 const char *
 mp_odrf_mpfr_root_fdfsolver_name (const mp_odrf_mpfr_root_fdfsolver_t * S)
@@ -189,6 +1108,12 @@ mp_odrf_mpfr_root_fdfsolver_name (const mp_odrf_mpfr_root_fdfsolver_t * S)
 {
   return S->driver->name;
 }
+mp_prec_t
+mp_odrf_mpfr_root_fdfsolver_prec (const mp_odrf_mpfr_root_fdfsolver_t * S)
+/* Return the working precision. */
+{
+  return mpfr_get_prec(S->root);
+}
 mpfr_ptr
 mp_odrf_mpfr_root_fdfsolver_root (const mp_odrf_mpfr_root_fdfsolver_t * S)
 /* Return the current estimate solution. */
@@ -196,109 +1121,6 @@ mp_odrf_mpfr_root_fdfsolver_root (const mp_odrf_mpfr_root_fdfsolver_t * S)
   return (mpfr_ptr)S->root;
 }
 
-
-/** --------------------------------------------------------------------
- ** Convergence tests API.
- ** ----------------------------------------------------------------- */
-
-mp_odrf_code_t
-mp_odrf_mpfr_root_test_interval (mpfr_ptr x_lower, mpfr_ptr x_upper,
-				 mpfr_ptr epsabs,  mpfr_ptr epsrel)
-{
-  mp_odrf_code_t	retval = MP_ODRF_CONTINUE;
-  mpfr_t		abs_lower;
-  mpfr_t		abs_upper;
-  mpfr_t		min_abs;
-  mpfr_t		tolerance;
-  mpfr_t		tmp;
-  int			clo, cup;
-  if (mpfr_cmp_si(epsrel, 0) < 0) {
-    retval	= MP_ODRF_ERROR_RELATIVE_TOLERANCE_IS_NEGATIVE;
-  } else if (mpfr_cmp_si(epsabs, 0) < 0) {
-    retval	= MP_ODRF_ERROR_ABSOLUTE_TOLERANCE_IS_NEGATIVE;
-  } else if (mpfr_greater_p(x_lower, x_upper)) {
-    retval	= MP_ODRF_ERROR_LOWER_BOUND_LARGER_THAN_UPPER_BOUND;
-  } else {
-    mpfr_init(tmp);
-    mpfr_init(abs_lower);
-    mpfr_init(abs_upper);
-    mpfr_init(min_abs);
-    mpfr_init(tolerance);
-    {
-      mpfr_abs(abs_lower, x_lower, GMP_RNDN);
-      mpfr_abs(abs_upper, x_upper, GMP_RNDN);
-      clo = mpfr_cmp_si(x_lower, 0);
-      cup = mpfr_cmp_si(x_upper, 0);
-      if (((clo > 0) && (cup > 0)) ||
-	  ((clo < 0) && (cup < 0))) {
-	mpfr_min(tmp, abs_lower, abs_upper, GMP_RNDN);
-	mpfr_set(min_abs, tmp, GMP_RNDN);
-      } else {
-	mpfr_set_d(min_abs, 0.0, GMP_RNDN);
-      }
-      mpfr_mul(tmp, epsrel, min_abs, GMP_RNDN);
-      mpfr_add(tolerance, epsabs, tmp, GMP_RNDN);
-      mpfr_sub(tmp, x_upper, x_lower, GMP_RNDN);
-      mpfr_abs(tmp, tmp, GMP_RNDN);
-      if (mpfr_less_p(tmp, tolerance))
-	retval = MP_ODRF_OK;
-    }
-    mpfr_clear(tmp);
-    mpfr_clear(abs_lower);
-    mpfr_clear(abs_upper);
-    mpfr_clear(min_abs);
-    mpfr_clear(tolerance);
-  }
-  return retval;
-}
-mp_odrf_code_t
-mp_odrf_mpfr_root_test_delta (mpfr_ptr x1, mpfr_ptr x0,
-			      mpfr_ptr epsabs, mpfr_ptr epsrel)
-{
-  mp_odrf_code_t	retval = MP_ODRF_CONTINUE;
-  if (mpfr_cmp_si(epsrel, 0) < 0) {
-    retval	= MP_ODRF_ERROR_RELATIVE_TOLERANCE_IS_NEGATIVE;
-  } else if (mpfr_cmp_si(epsabs, 0) < 0) {
-    retval	= MP_ODRF_ERROR_ABSOLUTE_TOLERANCE_IS_NEGATIVE;
-  } else if (0 == mpfr_cmp(x1, x0)) {
-    retval	= MP_ODRF_OK;
-  } else {
-    mpfr_t			tolerance, tmp, tmp1;
-    mpfr_init(tmp);
-    mpfr_init(tmp1);
-    mpfr_init(tolerance);
-    {
-      mpfr_abs(tmp, x1, GMP_RNDN);
-      mpfr_mul(tmp1, epsrel, tmp, GMP_RNDN);
-      mpfr_add(tolerance, epsabs, tmp1, GMP_RNDN);
-      mpfr_sub(tmp, x1, x0, GMP_RNDN);
-      mpfr_abs(tmp, tmp, GMP_RNDN);
-      if (mpfr_less_p(tmp, tolerance))
-	retval = MP_ODRF_OK;
-    }
-    mpfr_clear(tmp);
-    mpfr_clear(tmp1);
-    mpfr_clear(tolerance);
-  }
-  return retval;
-}
-mp_odrf_code_t
-mp_odrf_mpfr_root_test_residual (mpfr_ptr f, mpfr_ptr epsabs)
-{
-  mp_odrf_code_t	retval = MP_ODRF_CONTINUE;
-  if (mpfr_cmp_si(epsabs, 0) < 0) {
-    retval	= MP_ODRF_ERROR_ABSOLUTE_TOLERANCE_IS_NEGATIVE;
-  } else {
-    mpfr_t	tmp;
-    mpfr_init(tmp);
-    mpfr_abs(tmp, f, GMP_RNDN);
-    if (mpfr_less_p(tmp, epsabs)) {
-      retval = MP_ODRF_OK;
-    }
-  }
-  return retval;
-}
-
 
 /** --------------------------------------------------------------------
  ** Comparison API.
@@ -361,7 +1183,7 @@ mp_odrf_mpfr_absdiff_equal_p (mpfr_srcptr a, mpfr_srcptr b, mpfr_srcptr epsilon)
 {
   mpfr_t	x;
   int		retval=1;
-  mpfr_init(x);
+  mpfr_init2(x, (mpfr_get_prec(a) > mpfr_get_prec(b))? mpfr_get_prec(a) : mpfr_get_prec(b));
   {
     mpfr_sub(x, a, b, mpfr_greater_p(a, b)? GMP_RNDU : GMP_RNDD);
     if (0 <= mpfr_cmpabs(x, epsilon))
@@ -375,7 +1197,7 @@ mp_odrf_mpfr_reldiff_equal_p (mpfr_srcptr a, mpfr_srcptr b, mpfr_srcptr epsilon)
 {
   mpfr_t	x;
   int		retval=1;
-  mpfr_init(x);
+  mpfr_init2(x, (mpfr_get_prec(a) > mpfr_get_prec(b))? mpfr_get_prec(a) : mpfr_get_prec(b));
   {
     mpfr_reldiff(x, a, b, GMP_RNDN);
     if (0 <= mpfr_cmpabs(x, epsilon))
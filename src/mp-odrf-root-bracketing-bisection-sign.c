@@ -0,0 +1,176 @@
+/*
+   Part of: Multiple Precision One Dimensional Root Finding
+   Contents: root bracketing bisection algorithm with a sign oracle
+   Date: Fri Oct 16, 2026
+
+   Abstract
+
+	This module  implements a variant of the  bisection root bracketing
+	algorithm driver which only asks for the sign of the function.
+
+	When the function  has a sign oracle: the sign  is requested at a
+	low working precision,  which is doubled only when  the oracle
+	reports it  as uncertain, up to the precision of the solver.  The
+	sign is  usually obvious far from  the root,  so most of the steps
+	cost a fraction of a full evaluation.  Without an oracle the driver
+	behaves like the plain bisection one.
+
+   Copyright (c) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+   This program is free software:  you can redistribute it and/or modify
+   it under the terms of the  GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at
+   your option) any later version.
+
+   This program is  distributed in the hope that it  will be useful, but
+   WITHOUT  ANY   WARRANTY;  without   even  the  implied   warranty  of
+   MERCHANTABILITY  or FITNESS FOR  A PARTICULAR  PURPOSE.  See  the GNU
+   General Public License for more details.
+
+   You should  have received  a copy of  the GNU General  Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#include "mp-odrf-internals.h"
+
+/* The working precision of the first request to the oracle. */
+#define START_PREC	32
+
+/* The ordinates come first, see "driver_state_ordinate_count". */
+typedef struct {
+  /* Scratch variable for "sign_of()", used only without an oracle. */
+  mpfr_t	y_bisect;
+  /* Scratch variable for "bisection_sign_iterate()". */
+  mpfr_t	x_bisect;
+  int		sign_lower;
+  int		sign_upper;
+  /* The working precision at which the oracle decided the last sign. */
+  mp_prec_t	sign_prec;
+} bisection_sign_state_t;
+
+
+/** --------------------------------------------------------------------
+ ** Bisection sign root bracketing driver: functions.
+ ** ----------------------------------------------------------------- */
+
+static mp_odrf_code_t
+sign_of (bisection_sign_state_t * state, mp_odrf_mpfr_function_t * f,
+	 mpfr_ptr x, int * sign)
+/* Store in  SIGN the sign of  the function at  X.  The oracle is asked
+   first  at the precision which decided  the last sign: near the root
+   more bits are needed, so we rarely have to start over. */
+{
+  mp_odrf_code_t	retval;
+  if (NULL == f->sign) {
+    SAFE_FUNC_CALL(retval, f, x, state->y_bisect, MP_ODRF_HINT_SIGN_BITS);
+    if (MP_ODRF_OK == retval)
+      *sign = mpfr_sgn(state->y_bisect);
+  } else {
+    mp_prec_t	final = mpfr_get_prec(x);
+    mp_prec_t	prec  = (state->sign_prec < final)? state->sign_prec : final;
+    for (;;) {
+      retval = f->sign(sign, x, prec, f->params);
+      if ((MP_ODRF_OK != retval) || (MP_ODRF_SIGN_UNCERTAIN != *sign))
+	break;
+      if (prec == final) {
+	retval = MP_ODRF_ERROR_SIGN_IS_UNCERTAIN;
+	break;
+      }
+      prec = (prec < final / 2)? 2 * prec : final;
+    }
+    state->sign_prec = prec;
+  }
+  return retval;
+}
+static mp_odrf_code_t
+bisection_sign_set (void * driver_state, mp_odrf_mpfr_function_t * f,
+		    mpfr_ptr root, mpfr_ptr x_lower, mpfr_ptr x_upper)
+{
+  mp_odrf_code_t		retval = MP_ODRF_OK;
+  bisection_sign_state_t *	state  = driver_state;
+  /* root = (x_lower + x_upper) / 2 */
+  mpfr_add(root, x_lower, x_upper, GMP_RNDN);
+  mpfr_div_2ui(root, root, 1, GMP_RNDN);
+  state->sign_prec = START_PREC;
+  retval = sign_of(state, f, x_lower, &state->sign_lower);
+  if (MP_ODRF_OK == retval) {
+    retval = sign_of(state, f, x_upper, &state->sign_upper);
+    if (MP_ODRF_OK == retval) {
+      if (((state->sign_lower < 0) && (state->sign_upper < 0)) ||
+	  ((state->sign_lower > 0) && (state->sign_upper > 0))) {
+	retval = MP_ODRF_ERROR_ENDPOINTS_DO_NOT_STRADDLE;
+      }
+    }
+  }
+  return retval;
+}
+static mp_odrf_code_t
+bisection_sign_iterate (void * driver_state, mp_odrf_mpfr_function_t * f,
+			mpfr_t root, mpfr_t x_lower, mpfr_t x_upper)
+{
+  mp_odrf_code_t		retval	= MP_ODRF_OK;
+  bisection_sign_state_t *	state	= driver_state;
+  if (0 == state->sign_lower) {
+    mpfr_set(root,    x_lower, GMP_RNDN);
+    mpfr_set(x_upper, x_lower, GMP_RNDN);
+  } else if (0 == state->sign_upper) {
+    mpfr_set(root,    x_upper, GMP_RNDN);
+    mpfr_set(x_lower, x_upper, GMP_RNDN);
+  } else {
+    mpfr_ptr	x_bisect = state->x_bisect;
+    int		sbi;
+    /* x_bisect = (x_lower + x_upper) / 2; when it is one of the bounds
+       the root is already the nearest number to the true one. */
+    if (mp_odrf_bracket_is_exhausted(x_bisect, x_lower, x_upper))
+      return MP_ODRF_BRACKET_EXHAUSTED;
+    retval = sign_of(state, f, x_bisect, &sbi);
+    if (MP_ODRF_OK == retval) {
+      if (0 == sbi) {
+	mpfr_set(root,    x_bisect, GMP_RNDN);
+	mpfr_set(x_lower, x_bisect, GMP_RNDN);
+	mpfr_set(x_upper, x_bisect, GMP_RNDN);
+	state->sign_lower = 0;
+      } else if (((state->sign_lower > 0) && (sbi < 0)) ||
+		 ((state->sign_lower < 0) && (sbi > 0))) {
+	/* Discard the  half of the interval  which doesn't contain the
+	   root. */
+	mpfr_add(root, x_lower, x_bisect, GMP_RNDN);
+	mpfr_div_2ui(root, root, 1, GMP_RNDN);
+	mpfr_swap(x_upper, x_bisect);
+	state->sign_upper = sbi;
+      } else {
+	mpfr_add(root, x_bisect, x_upper, GMP_RNDN);
+	mpfr_div_2ui(root, root, 1, GMP_RNDN);
+	mpfr_swap(x_lower, x_bisect);
+	state->sign_lower = sbi;
+      }
+    }
+  }
+  return retval;
+}
+
+
+/** --------------------------------------------------------------------
+ ** Bisection sign root bracketing driver: struct definition.
+ ** ----------------------------------------------------------------- */
+
+static const mp_odrf_mpfr_root_fsolver_driver_t bisection_sign_driver = {
+  .name			= "bisection-sign",
+  .driver_state_size	= sizeof(bisection_sign_state_t),
+  .driver_state_mpfr_count = offsetof(bisection_sign_state_t, sign_lower) / sizeof(mpfr_t),
+  .driver_state_ordinate_count = offsetof(bisection_sign_state_t, x_bisect) / sizeof(mpfr_t),
+  .init			= NULL,
+  .final		= NULL,
+  .set			= bisection_sign_set,
+  .iterate		= bisection_sign_iterate
+};
+
+const mp_odrf_mpfr_root_fsolver_driver_t * \
+  mp_odrf_mpfr_root_fsolver_bisection_sign = &bisection_sign_driver;
+
+/* end of file */
@@ -33,9 +33,13 @@
 
 #include "mp-odrf-internals.h"
 
+/* The ordinates come first, see "driver_state_ordinate_count". */
 typedef struct {
   mpfr_t	y_lower;
   mpfr_t	y_upper;
+  /* Scratch variables for "bisection_iterate()". */
+  mpfr_t	y_bisect;
+  mpfr_t	x_bisect;
 } bisection_state_t;
 
 
@@ -43,41 +47,20 @@ typedef struct {
  ** Bisection root bracketing driver: functions.
  ** ----------------------------------------------------------------- */
 
-static void
-bisection_init (void * driver_state)
-{
-  bisection_state_t *	state = driver_state;
-  mpfr_init(state->y_lower);
-  mpfr_init(state->y_upper);
-}
-static void
-bisection_final (void * driver_state)
-{
-  bisection_state_t *	state = driver_state;
-  mpfr_clear(state->y_lower);
-  mpfr_clear(state->y_upper);
-}
 static mp_odrf_code_t
 bisection_set (void * driver_state, mp_odrf_mpfr_function_t * f,
 	       mpfr_ptr root, mpfr_ptr x_lower, mpfr_ptr x_upper)
 {
   mp_odrf_code_t	retval = MP_ODRF_OK;
-  {
-    mpfr_t	tmp;
-    mpfr_init(tmp);
-    {
-      /* tmp = (x_lower + x_upper) / 2 */
-      mpfr_add(tmp, x_lower, x_upper, GMP_RNDN);
-      mpfr_mul_d(root, tmp, 0.5, GMP_RNDN);
-    }
-    mpfr_clear(tmp);
-  }
+  /* root = (x_lower + x_upper) / 2 */
+  mpfr_add(root, x_lower, x_upper, GMP_RNDN);
+  mpfr_div_2ui(root, root, 1, GMP_RNDN);
   {
     bisection_state_t *	state = driver_state;
     int			clo, cup;
-    SAFE_FUNC_CALL(retval, f, x_lower, state->y_lower);
+    SAFE_FUNC_CALL(retval, f, x_lower, state->y_lower, MP_ODRF_HINT_SIGN_BITS);
     if (MP_ODRF_OK == retval) {
-      SAFE_FUNC_CALL(retval, f, x_upper, state->y_upper);
+      SAFE_FUNC_CALL(retval, f, x_upper, state->y_upper, MP_ODRF_HINT_SIGN_BITS);
       if (MP_ODRF_OK == retval) {
 	clo = mpfr_cmp_si(state->y_lower, 0);
 	cup = mpfr_cmp_si(state->y_upper, 0);
@@ -103,43 +86,42 @@ bisection_iterate (void * driver_state, mp_odrf_mpfr_function_t * f,
     mpfr_set(root,    x_upper, GMP_RNDN);
     mpfr_set(x_lower, x_upper, GMP_RNDN);
   } else {
-    mpfr_t	x_bisect, y_bisect, tmp;
+    mpfr_ptr	x_bisect = state->x_bisect;
+    mpfr_ptr	y_bisect = state->y_bisect;
     int		clo, cbi;
-    mpfr_init(y_bisect);
-    mpfr_init(x_bisect);
-    mpfr_init(tmp);
-    {
-      mpfr_add(tmp, x_lower, x_upper, GMP_RNDN);
-      mpfr_mul_d(x_bisect, tmp, 0.5, GMP_RNDN);
-      SAFE_FUNC_CALL(retval, f, x_bisect, y_bisect);
-      if (MP_ODRF_OK == retval) {
-	if (mpfr_zero_p(y_bisect)) {
-	  mpfr_set(root,    x_bisect, GMP_RNDN);
-	  mpfr_set(x_lower, x_bisect, GMP_RNDN);
-	  mpfr_set(x_upper, x_bisect, GMP_RNDN);
+    /* x_bisect = (x_lower + x_upper) / 2 */
+    if (mp_odrf_bracket_is_exhausted(x_bisect, x_lower, x_upper)) {
+      return mp_odrf_bracket_exhausted_root(root, x_lower, x_upper,
+					    state->y_lower, state->y_upper);
+    }
+    SAFE_FUNC_CALL(retval, f, x_bisect, y_bisect, MP_ODRF_HINT_SIGN_BITS);
+    if (MP_ODRF_OK == retval) {
+      if (mpfr_zero_p(y_bisect)) {
+	/* The next iterations must not evaluate the function again. */
+	mpfr_set(root,    x_bisect, GMP_RNDN);
+	mpfr_set(x_lower, x_bisect, GMP_RNDN);
+	mpfr_set(x_upper, x_bisect, GMP_RNDN);
+	mpfr_set_si(state->y_lower, 0, GMP_RNDN);
+      } else {
+	/* Discard the  half of the interval  which doesn't contain the
+	   root.  The  scratch variables are  swapped into the  state: the
+	   discarded values are garbage from now on. */
+	clo = mpfr_cmp_si(state->y_lower, 0);
+	cbi = mpfr_cmp_si(y_bisect,       0);
+	if (((clo > 0) && (cbi < 0)) ||
+	    ((clo < 0) && (cbi > 0))) {
+	  mpfr_add(root, x_lower, x_bisect, GMP_RNDN);
+	  mpfr_div_2ui(root, root, 1, GMP_RNDN);
+	  mpfr_swap(x_upper,        x_bisect);
+	  mpfr_swap(state->y_upper, y_bisect);
 	} else {
-	  /* Discard the half of the  interval which doesn't contain the
-	     root. */
-	  clo = mpfr_cmp_si(state->y_lower, 0);
-	  cbi = mpfr_cmp_si(y_bisect,       0);
-	  if (((clo > 0) && (cbi < 0)) ||
-	      ((clo < 0) && (cbi > 0))) {
-	    mpfr_add(tmp, x_lower, x_bisect, GMP_RNDN);
-	    mpfr_mul_d(root, tmp, 0.5, GMP_RNDN);
-	    mpfr_set(x_upper, x_bisect, GMP_RNDN);
-	    mpfr_set(state->y_upper, y_bisect, GMP_RNDN);
-	  } else {
-	    mpfr_add(tmp, x_bisect, x_upper, GMP_RNDN);
-	    mpfr_mul_d(root, tmp, 0.5, GMP_RNDN);
-	    mpfr_set(x_lower, x_bisect, GMP_RNDN);
-	    mpfr_set(state->y_lower, y_bisect, GMP_RNDN);
-	  }
+	  mpfr_add(root, x_bisect, x_upper, GMP_RNDN);
+	  mpfr_div_2ui(root, root, 1, GMP_RNDN);
+	  mpfr_swap(x_lower,        x_bisect);
+	  mpfr_swap(state->y_lower, y_bisect);
 	}
       }
     }
-    mpfr_clear(tmp);
-    mpfr_clear(x_bisect);
-    mpfr_clear(y_bisect);
   }
   return retval;
 }
@@ -152,8 +134,10 @@ bisection_iterate (void * driver_state, mp_odrf_mpfr_function_t * f,
 static const mp_odrf_mpfr_root_fsolver_driver_t bisection_driver = {
   .name			= "bisection",
   .driver_state_size	= sizeof(bisection_state_t),
-  .init			= bisection_init,
-  .final		= bisection_final,
+  .driver_state_mpfr_count = sizeof(bisection_state_t) / sizeof(mpfr_t),
+  .driver_state_ordinate_count = offsetof(bisection_state_t, x_bisect) / sizeof(mpfr_t),
+  .init			= NULL,
+  .final		= NULL,
   .set			= bisection_set,
   .iterate		= bisection_iterate
 };
@@ -32,9 +32,23 @@
 
 #include "mp-odrf-internals.h"
 
+/* The  ordinates  come first,  see "driver_state_ordinate_count": the
+   function values and the ratios "q", "r", "s" computed from them. */
 typedef struct {
-  mpfr_t	a, b, c, d, e;
   mpfr_t	fa, fb, fc;
+  mpfr_t	q, r, s;
+  mpfr_t	a, b, c, d, e;
+  /* Scratch variables  for "brent_iterate()"; they  are initialised once
+     when the solver is allocated so that iterating does not allocate. */
+  mpfr_t	tol, m;
+  mpfr_t	p;
+  mpfr_t	tmp1, tmp2, tmp3, tmp4;
+  /* The  minimum step  selected  with "mp_odrf_mpfr_root_fsolver_brent_set_tolerance()",
+     as "user_tol * 2^user_tol_exp", or zero to use only the one derived
+     from the precision of "b".  It is not an "mpfr_t": the library sets
+     the MPFR members to NaN whenever it changes the working precision. */
+  double	user_tol;
+  long		user_tol_exp;
 } brent_state_t;
 
 
@@ -43,30 +57,11 @@ typedef struct {
  ** ----------------------------------------------------------------- */
 
 static void
-brent_init (void * driver_state)
+brent_init (void * driver_state, unsigned flags MP_ODRF_UNUSED)
 {
   brent_state_t *	state = driver_state;
-  mpfr_init(state->a);
-  mpfr_init(state->b);
-  mpfr_init(state->c);
-  mpfr_init(state->d);
-  mpfr_init(state->e);
-  mpfr_init(state->fa);
-  mpfr_init(state->fb);
-  mpfr_init(state->fc);
-}
-static void
-brent_final (void * driver_state)
-{
-  brent_state_t *	state = driver_state;
-  mpfr_clear(state->a);
-  mpfr_clear(state->b);
-  mpfr_clear(state->c);
-  mpfr_clear(state->d);
-  mpfr_clear(state->e);
-  mpfr_clear(state->fa);
-  mpfr_clear(state->fb);
-  mpfr_clear(state->fc);
+  state->user_tol	= 0.0;
+  state->user_tol_exp	= 0;
 }
 static mp_odrf_code_t
 brent_set (void * driver_state, mp_odrf_mpfr_function_t * f,
@@ -74,39 +69,28 @@ brent_set (void * driver_state, mp_odrf_mpfr_function_t * f,
 {
   mp_odrf_code_t	retval = MP_ODRF_OK;
   brent_state_t *	state = driver_state;
-  mpfr_t		y_lower, y_upper;
-  mpfr_t		tmp1;
   int			clo, cup;
-  mpfr_init(y_lower);
-  mpfr_init(y_upper);
-  mpfr_init(tmp1);
-  {
-    mpfr_add(tmp1, x_lower, x_upper, GMP_RNDN);
-    mpfr_mul_d(root, tmp1, 0.5, GMP_RNDN);
-    SAFE_FUNC_CALL(retval, f, x_lower, y_lower);
+  /* root = (x_lower + x_upper) / 2 */
+  mpfr_add(root, x_lower, x_upper, GMP_RNDN);
+  mpfr_div_2ui(root, root, 1, GMP_RNDN);
+  SAFE_FUNC_CALL(retval, f, x_lower, state->fa, MP_ODRF_HINT_MIN_BITS);
+  if (MP_ODRF_OK == retval) {
+    SAFE_FUNC_CALL(retval, f, x_upper, state->fb, MP_ODRF_HINT_MIN_BITS);
     if (MP_ODRF_OK == retval) {
-      SAFE_FUNC_CALL(retval, f, x_upper, y_upper);
-      if (MP_ODRF_OK == retval) {
-	mpfr_set(state->a,  x_lower, GMP_RNDN);
-	mpfr_set(state->fa, y_lower, GMP_RNDN);
-	mpfr_set(state->b,  x_upper, GMP_RNDN);
-	mpfr_set(state->fb, y_upper, GMP_RNDN);
-	mpfr_set(state->c,  x_upper, GMP_RNDN);
-	mpfr_set(state->fc, y_upper, GMP_RNDN);
-	mpfr_sub(state->d, x_upper, x_lower, GMP_RNDN);
-	mpfr_sub(state->e, x_upper, x_lower, GMP_RNDN);
-	clo = mpfr_cmp_si(y_lower, 0);
-	cup = mpfr_cmp_si(y_upper, 0);
-	if (((clo < 0) && (cup < 0)) ||
-	    ((clo > 0) && (cup > 0))) {
-	  retval = MP_ODRF_ERROR_ENDPOINTS_DO_NOT_STRADDLE;
-	}
+      mpfr_set(state->a,  x_lower,   GMP_RNDN);
+      mpfr_set(state->b,  x_upper,   GMP_RNDN);
+      mpfr_set(state->c,  x_upper,   GMP_RNDN);
+      mpfr_set(state->fc, state->fb, GMP_RNDN);
+      mpfr_sub(state->d, x_upper, x_lower, GMP_RNDN);
+      mpfr_sub(state->e, x_upper, x_lower, GMP_RNDN);
+      clo = mpfr_cmp_si(state->fa, 0);
+      cup = mpfr_cmp_si(state->fb, 0);
+      if (((clo < 0) && (cup < 0)) ||
+	  ((clo > 0) && (cup > 0))) {
+	retval = MP_ODRF_ERROR_ENDPOINTS_DO_NOT_STRADDLE;
       }
     }
   }
-  mpfr_clear(y_lower);
-  mpfr_clear(y_upper);
-  mpfr_clear(tmp1);
   return retval;
 }
 static mp_odrf_code_t
@@ -115,8 +99,6 @@ brent_iterate (void * driver_state, mp_odrf_mpfr_function_t * f,
 {
   mp_odrf_code_t	retval	= MP_ODRF_OK;
   brent_state_t *	state = driver_state;
-  mpfr_t		tol, m;
-  mpfr_t		tmp1, tmp2, tmp3;
   int			ac_equal = 0;
 #define A	state->a
 #define B	state->b
@@ -126,172 +108,185 @@ brent_iterate (void * driver_state, mp_odrf_mpfr_function_t * f,
 #define FA	state->fa
 #define FB	state->fb
 #define FC	state->fc
-  mpfr_init(tol);
-  mpfr_init(m);
-  mpfr_init(tmp1);
-  mpfr_init(tmp2);
-  mpfr_init(tmp3);
-  {
-    if (((mpfr_cmp_si(FB, 0) < 0) && (mpfr_cmp_si(FC, 0) < 0)) ||
-	((mpfr_cmp_si(FB, 0) > 0) && (mpfr_cmp_si(FC, 0) > 0))) {
-      ac_equal = 1;
-      mpfr_set(C,    A, GMP_RNDN);
-      mpfr_set(FC,  FA, GMP_RNDN);
-      mpfr_sub(D, B, A, GMP_RNDN);
-      mpfr_sub(E, B, A, GMP_RNDN);
-    }
-    mpfr_abs(tmp1, FC, GMP_RNDN);
-    mpfr_abs(tmp2, FB, GMP_RNDN);
-    if (mpfr_less_p(tmp1, tmp2)) {
-      ac_equal = 1;
-      mpfr_set(A,   B, GMP_RNDN);
-      mpfr_set(B,   C, GMP_RNDN);
-      mpfr_set(C,   A, GMP_RNDN);
-      mpfr_set(FA, FB, GMP_RNDN);
-      mpfr_set(FB, FC, GMP_RNDN);
-      mpfr_set(FC, FA, GMP_RNDN);
-    }
-    if (mpfr_zero_p(FB)) {
-      mpfr_set(root,    B, GMP_RNDN);
+#define TOL	state->tol
+#define M	state->m
+#define P	state->p
+#define Q	state->q
+#define R	state->r
+#define S	state->s
+#define TMP1	state->tmp1
+#define TMP2	state->tmp2
+#define TMP3	state->tmp3
+#define TMP4	state->tmp4
+  if (((mpfr_cmp_si(FB, 0) < 0) && (mpfr_cmp_si(FC, 0) < 0)) ||
+      ((mpfr_cmp_si(FB, 0) > 0) && (mpfr_cmp_si(FC, 0) > 0))) {
+    /* c = a; with "ac_equal" set A is not read again before being
+       overwritten, so its limbs are swapped rather than copied. */
+    ac_equal = 1;
+    mpfr_swap(C, A);
+    mpfr_set(FC, FA, GMP_RNDN);
+    mpfr_sub(D, B, C, GMP_RNDN);
+    mpfr_set(E, D, GMP_RNDN);
+  }
+  if (mpfr_cmpabs(FC, FB) < 0) {
+    /* a = b; b = c; c = a; */
+    ac_equal = 1;
+    mpfr_swap(B, C);
+    mpfr_swap(FB, FC);
+    mpfr_set(A,  C,  GMP_RNDN);
+    mpfr_set(FA, FC, GMP_RNDN);
+  }
+  if (mpfr_zero_p(FB)) {
+    mpfr_set(root,    B, GMP_RNDN);
+    mpfr_set(x_lower, B, GMP_RNDN);
+    mpfr_set(x_upper, B, GMP_RNDN);
+    goto end;
+  }
+  /* tol = |b| * 2^(-prec), half the  relative spacing of the numbers
+     near "b"; it is "0.5 * GSL_DBL_EPSILON * fabs(b)" at 53 bits.  It
+     is exact, and it keeps the interpolation steps alive down to the
+     last bits of the working precision. */
+  mpfr_div_2ui(TOL, B, (unsigned long)mpfr_get_prec(B), GMP_RNDN);
+  mpfr_abs(TOL, TOL, GMP_RNDN);
+  if (0.0 != state->user_tol) {
+    mpfr_set_d(TMP1, state->user_tol, GMP_RNDU);
+    mpfr_mul_2si(TMP1, TMP1, state->user_tol_exp, GMP_RNDU);
+    if (mpfr_less_p(TOL, TMP1))
+      mpfr_set(TOL, TMP1, GMP_RNDN);
+  }
+  /* B and C are adjacent: stepping from B would evaluate C again. */
+  if (mp_odrf_bracket_is_exhausted(TMP1, B, C)) {
+    retval = mp_odrf_bracket_exhausted_root(root, B, C, FB, FC);
+    if (mpfr_less_p(B, C)) {
       mpfr_set(x_lower, B, GMP_RNDN);
+      mpfr_set(x_upper, C, GMP_RNDN);
+    } else {
+      mpfr_set(x_lower, C, GMP_RNDN);
       mpfr_set(x_upper, B, GMP_RNDN);
-      goto end;
     }
-    mpfr_abs(tmp1, B, GMP_RNDN);
-    mpfr_mul_d(tol, tmp1, 0.5 * GSL_DBL_EPSILON, GMP_RNDN); /* FIXME usage of GSL_DBL_EPSILON */
-    mpfr_sub(tmp1, C, B, GMP_RNDN);
-    mpfr_mul_d(m, tmp1, 0.5, GMP_RNDN);
-    mpfr_abs(tmp1, m, GMP_RNDN);
-    if (mpfr_lessequal_p(tmp1, tol)) {
-      mpfr_set(root, B, GMP_RNDN);
-      if (mpfr_less_p(B, C)) {
-	mpfr_set(x_lower, B, GMP_RNDN);
-	mpfr_set(x_upper, C, GMP_RNDN);
-      } else {
-	mpfr_set(x_lower, C, GMP_RNDN);
-	mpfr_set(x_upper, B, GMP_RNDN);
-      }
-      goto end;
+    goto end;
+  }
+  mpfr_sub(M, C, B, GMP_RNDN);
+  mpfr_div_2ui(M, M, 1, GMP_RNDN);
+  if (mpfr_cmpabs(M, TOL) <= 0) {
+    mpfr_set(root, B, GMP_RNDN);
+    if (mpfr_less_p(B, C)) {
+      mpfr_set(x_lower, B, GMP_RNDN);
+      mpfr_set(x_upper, C, GMP_RNDN);
+    } else {
+      mpfr_set(x_lower, C, GMP_RNDN);
+      mpfr_set(x_upper, B, GMP_RNDN);
     }
-    mpfr_abs(tmp1,  E, GMP_RNDN);
-    mpfr_abs(tmp2, FA, GMP_RNDN);
-    mpfr_abs(tmp3, FB, GMP_RNDN);
-    if (mpfr_less_p(tmp1, tol) || mpfr_lessequal_p(tmp2, tmp3)) {
-      mpfr_set(D, m, GMP_RNDN);            /* use bisection */
-      mpfr_set(E, m, GMP_RNDN);
+    goto end;
+  }
+  if ((mpfr_cmpabs(E, TOL) < 0) || (mpfr_cmpabs(FA, FB) <= 0)) {
+    mpfr_set(D, M, GMP_RNDN);            /* use bisection */
+    mpfr_set(E, M, GMP_RNDN);
+  } else {
+    /* use inverse cubic interpolation */
+    mpfr_div(S, FB, FA, GMP_RNDN);
+    if (ac_equal) {
+      mpfr_mul(P, M, S, GMP_RNDN);
+      mpfr_div_2ui(P, P, 1, GMP_RNDN);
+      mpfr_ui_sub(Q, 1, S, GMP_RNDN);
     } else {
-      mpfr_t p, q, r, s;   /* use inverse cubic interpolation */
-      mpfr_init(p);
-      mpfr_init(q);
-      mpfr_init(r);
-      mpfr_init(s);
-      {
-	mpfr_div(s, FB, FA, GMP_RNDN);
-	if (ac_equal) {
-	  mpfr_mul(tmp1, m, s, GMP_RNDN);
-	  mpfr_mul_d(p, tmp1, 0.5, GMP_RNDN);
-	  mpfr_sub_si(tmp1, s, 1, GMP_RNDN);
-	  mpfr_neg(q, tmp1, GMP_RNDN);
-	} else {
-	  mpfr_div(q, FA, FC, GMP_RNDN);
-	  mpfr_div(r, FB, FC, GMP_RNDN);
+      mpfr_div(Q, FA, FC, GMP_RNDN);
+      mpfr_div(R, FB, FC, GMP_RNDN);
 
-	  mpfr_sub(tmp1, B, A, GMP_RNDN);	/* tmp1 = b - a */
-	  mpfr_sub_si(tmp2, r, 1, GMP_RNDN);	/* tmp2 = r - 1 */
-	  mpfr_mul(tmp3, tmp1, tmp2, GMP_RNDN);	/* tmp3 = (b - a) * (r - 1) */
-	  mpfr_sub(tmp1, q, r, GMP_RNDN);	/* tmp1 = q - r */
-	  mpfr_mul(tmp2, q, tmp1, GMP_RNDN);	/* tmp2 = q * (q - r) */
-	  mpfr_mul(tmp1, tmp2, m, GMP_RNDN);	/* tmp1 = m * q * (q - r) */
-	  mpfr_mul_si(tmp2, tmp1, 2, GMP_RNDN);	/* tmp2 = 2 * m * q * (q - r) */
-	  mpfr_sub(tmp1, tmp2, tmp3, GMP_RNDN); /* tmp1 = [2 * m * q * (q - r)] -
+      mpfr_sub(TMP1, B, A, GMP_RNDN);		/* tmp1 = b - a */
+      mpfr_sub_si(TMP2, R, 1, GMP_RNDN);	/* tmp2 = r - 1 */
+      mpfr_mul(TMP3, TMP1, TMP2, GMP_RNDN);	/* tmp3 = (b - a) * (r - 1) */
+      mpfr_sub(TMP1, Q, R, GMP_RNDN);		/* tmp1 = q - r */
+      mpfr_mul(TMP2, Q, TMP1, GMP_RNDN);	/* tmp2 = q * (q - r) */
+      mpfr_mul(TMP1, TMP2, M, GMP_RNDN);	/* tmp1 = m * q * (q - r) */
+      mpfr_mul_2ui(TMP2, TMP1, 1, GMP_RNDN);	/* tmp2 = 2 * m * q * (q - r) */
+      mpfr_sub(TMP1, TMP2, TMP3, GMP_RNDN);	/* tmp1 = [2 * m * q * (q - r)] -
 						   [(b - a) * (r - 1)] */
-	  mpfr_mul(p, tmp1, s, GMP_RNDN);	/* p = s * {[2 * m * q * (q - r)] -
+      mpfr_mul(P, TMP1, S, GMP_RNDN);		/* p = s * {[2 * m * q * (q - r)] -
 						   [(b - a) * (r - 1)]} */
 
-	  mpfr_sub_si(tmp1, q, 1, GMP_RNDN);	/* tmp1 = q - 1 */
-	  mpfr_sub_si(tmp2, r, 1, GMP_RNDN);	/* tmp2 = r - 1 */
-	  mpfr_mul(tmp3, tmp1, tmp2, GMP_RNDN); /* tmp3 = (q - 1) * (r - 1) */
-	  mpfr_sub_si(tmp1, s, 1, GMP_RNDN);	/* tmp1 = (s - 1) */
-	  mpfr_mul(q, tmp3, tmp1, GMP_RNDN);	/* q = (q - 1) * (r - 1) * (s - 1) */
-	}
-	if (mpfr_cmp_si(p, 0) > 0) {
-	  mpfr_neg(q, q, GMP_RNDN);
-	} else {
-	  mpfr_neg(p, p, GMP_RNDN);
-	}
-	mpfr_mul_si(tmp1, p, 2, GMP_RNDN);
-	{
-	  mpfr_t	tmp4;
-	  mpfr_init(tmp4);
-	  {
-	    mpfr_mul(tmp2, tol, q, GMP_RNDN);		/* tmp2 = tol * q */
-	    mpfr_abs(tmp3, tmp2, GMP_RNDN);		/* tmp3 = fabs(tol * q) */
-	    mpfr_mul(tmp2, m, q, GMP_RNDN);		/* tmp2 = m * q */
-	    mpfr_mul_si(tmp4, tmp2, 3, GMP_RNDN);	/* tmp4 = 3 * m * q */
-	    mpfr_sub(tmp2, tmp4, tmp3, GMP_RNDN);	/* tmp2 = 3*m*1 - fabs(tol*q) */
-	    mpfr_mul(tmp3, E, q, GMP_RNDN);		/* tmp3 = e * q */
-	    mpfr_abs(tmp4, tmp3, GMP_RNDN);		/* tmp4 = fabs(e * q) */
-	    mpfr_min(tmp3, tmp2, tmp4, GMP_RNDN);	/* tmp3 = min(3*m*1 - fabs(tol*q),
-							   fabs(e * q)) */
-	  }
-	  mpfr_clear(tmp4);
-	}
-	if (mpfr_less_p(tmp1, tmp3)) {
-	  mpfr_set(E, D, GMP_RNDN);
-	  mpfr_div(D, p, q, GMP_RNDN);
-	} else {
-	  /* interpolation failed, fall back to bisection */
-	  mpfr_set(D, m, GMP_RNDN);
-	  mpfr_set(E, m, GMP_RNDN);
-	}
-      }
-      mpfr_clear(p);
-      mpfr_clear(q);
-      mpfr_clear(r);
-      mpfr_clear(s);
+      mpfr_sub_si(TMP1, Q, 1, GMP_RNDN);	/* tmp1 = q - 1 */
+      mpfr_sub_si(TMP2, R, 1, GMP_RNDN);	/* tmp2 = r - 1 */
+      mpfr_mul(TMP3, TMP1, TMP2, GMP_RNDN);	/* tmp3 = (q - 1) * (r - 1) */
+      mpfr_sub_si(TMP1, S, 1, GMP_RNDN);	/* tmp1 = (s - 1) */
+      mpfr_mul(Q, TMP3, TMP1, GMP_RNDN);	/* q = (q - 1) * (r - 1) * (s - 1) */
     }
-    mpfr_set(A,   B, GMP_RNDN);
-    mpfr_set(FA, FB, GMP_RNDN);
-    mpfr_abs(tmp1, D, GMP_RNDN);
-    if (mpfr_greater_p(tmp1, tol)) {
-      mpfr_add(tmp1, B, D, GMP_RNDN);
-      mpfr_set(B, tmp1, GMP_RNDN);
+    if (mpfr_cmp_si(P, 0) > 0) {
+      mpfr_neg(Q, Q, GMP_RNDN);
     } else {
-      if (mpfr_cmp_si(m, 0) > 0) {
-	mpfr_add(tmp1, B, tol, GMP_RNDN);
-	mpfr_set(B, tmp1, GMP_RNDN);
-      } else {
-	mpfr_sub(tmp1, B, tol, GMP_RNDN);
-	mpfr_set(B, tmp1, GMP_RNDN);
-      }
-    }
-    SAFE_FUNC_CALL(retval, f, B, FB);
-    if (MP_ODRF_OK != retval) {
-      goto end;
+      mpfr_neg(P, P, GMP_RNDN);
     }
-    /* Update  the  best  estimate  of  the  root  and  bounds  on  each
-       iteration */
-    mpfr_set(root, B, GMP_RNDN);
-
-    if (((mpfr_cmp_si(FB, 0) < 0) && (mpfr_cmp_si(FC, 0) < 0)) ||
-	((mpfr_cmp_si(FB, 0) > 0) && (mpfr_cmp_si(FC, 0) > 0))) {
-      mpfr_set(C, A, GMP_RNDN);
+    mpfr_mul_2ui(TMP1, P, 1, GMP_RNDN);
+    mpfr_mul(TMP2, TOL, Q, GMP_RNDN);		/* tmp2 = tol * q */
+    mpfr_abs(TMP3, TMP2, GMP_RNDN);		/* tmp3 = fabs(tol * q) */
+    mpfr_mul(TMP2, M, Q, GMP_RNDN);		/* tmp2 = m * q */
+    mpfr_mul_si(TMP4, TMP2, 3, GMP_RNDN);	/* tmp4 = 3 * m * q */
+    mpfr_sub(TMP2, TMP4, TMP3, GMP_RNDN);	/* tmp2 = 3*m*1 - fabs(tol*q) */
+    mpfr_mul(TMP3, E, Q, GMP_RNDN);		/* tmp3 = e * q */
+    mpfr_abs(TMP4, TMP3, GMP_RNDN);		/* tmp4 = fabs(e * q) */
+    mpfr_min(TMP3, TMP2, TMP4, GMP_RNDN);	/* tmp3 = min(3*m*1 - fabs(tol*q),
+						   fabs(e * q)) */
+    if (mpfr_less_p(TMP1, TMP3)) {
+      mpfr_swap(E, D);				/* e = d */
+      mpfr_div(D, P, Q, GMP_RNDN);
+    } else {
+      /* interpolation failed, fall back to bisection */
+      mpfr_set(D, M, GMP_RNDN);
+      mpfr_set(E, M, GMP_RNDN);
     }
-    if (mpfr_less_p(B, C)) {
-      mpfr_set(x_lower, B, GMP_RNDN);
-      mpfr_set(x_upper, C, GMP_RNDN);
+  }
+  /* a = b; fa = fb; then B and FB receive the new values: swapping
+     avoids copying the limbs. */
+  mpfr_swap(A,   B);
+  mpfr_swap(FA, FB);
+  if (mpfr_cmpabs(D, TOL) > 0) {
+    mpfr_add(B, A, D, GMP_RNDN);
+  } else {
+    if (mpfr_cmp_si(M, 0) > 0) {
+      mpfr_add(B, A, TOL, GMP_RNDN);
     } else {
-      mpfr_set(x_lower, C, GMP_RNDN);
-      mpfr_set(x_upper, B, GMP_RNDN);
+      mpfr_sub(B, A, TOL, GMP_RNDN);
     }
   }
+  SAFE_FUNC_CALL(retval, f, B, FB, mp_odrf_hint_bits(B, D, FB));
+  if (MP_ODRF_OK != retval) {
+    goto end;
+  }
+  /* Update  the  best  estimate  of  the  root  and  bounds  on  each
+     iteration */
+  mpfr_set(root, B, GMP_RNDN);
+
+  if (((mpfr_cmp_si(FB, 0) < 0) && (mpfr_cmp_si(FC, 0) < 0)) ||
+      ((mpfr_cmp_si(FB, 0) > 0) && (mpfr_cmp_si(FC, 0) > 0))) {
+    mpfr_set(C, A, GMP_RNDN);
+  }
+  if (mpfr_less_p(B, C)) {
+    mpfr_set(x_lower, B, GMP_RNDN);
+    mpfr_set(x_upper, C, GMP_RNDN);
+  } else {
+    mpfr_set(x_lower, C, GMP_RNDN);
+    mpfr_set(x_upper, B, GMP_RNDN);
+  }
  end:
-  mpfr_clear(tol);
-  mpfr_clear(m);
-  mpfr_clear(tmp1);
-  mpfr_clear(tmp2);
-  mpfr_clear(tmp3);
   return retval;
+#undef A
+#undef B
+#undef C
+#undef D
+#undef E
+#undef FA
+#undef FB
+#undef FC
+#undef TOL
+#undef M
+#undef P
+#undef Q
+#undef R
+#undef S
+#undef TMP1
+#undef TMP2
+#undef TMP3
+#undef TMP4
 }
 
 
@@ -302,12 +297,43 @@ brent_iterate (void * driver_state, mp_odrf_mpfr_function_t * f,
 static const mp_odrf_mpfr_root_fsolver_driver_t brent_driver = {
   .name			= "brent",
   .driver_state_size	= sizeof(brent_state_t),
+  .driver_state_mpfr_count = offsetof(brent_state_t, user_tol) / sizeof(mpfr_t),
+  .driver_state_ordinate_count = offsetof(brent_state_t, a) / sizeof(mpfr_t),
   .init			= brent_init,
-  .final		= brent_final,
+  .final		= NULL,
   .set			= brent_set,
   .iterate		= brent_iterate
 };
 
 const mp_odrf_mpfr_root_fsolver_driver_t * mp_odrf_mpfr_root_fsolver_brent = &brent_driver;
 
+
+/** --------------------------------------------------------------------
+ ** Brent root bracketing driver: configuration.
+ ** ----------------------------------------------------------------- */
+
+mp_odrf_code_t
+mp_odrf_mpfr_root_fsolver_brent_set_tolerance (mp_odrf_mpfr_root_fsolver_t * S,
+					       mpfr_srcptr tol)
+/* Select TOL as minimum step of the solver, or only the one derived from
+   the working precision if TOL is NULL. */
+{
+  brent_state_t *	state = S->driver_state;
+  if (&brent_driver != S->driver)
+    return MP_ODRF_ERROR_UNSUPPORTED_BY_DRIVER;
+  if (NULL == tol) {
+    state->user_tol	= 0.0;
+    state->user_tol_exp	= 0;
+  } else if (mpfr_nan_p(tol) || (mpfr_sgn(tol) < 0)) {
+    return MP_ODRF_ERROR_ABSOLUTE_TOLERANCE_IS_NEGATIVE;
+  } else {
+    /* Round up: the step must not fall below the requested one.  The
+       exponent is undefined for zero and infinity. */
+    long	exp = 0;
+    state->user_tol	= mpfr_get_d_2exp(&exp, tol, GMP_RNDU);
+    state->user_tol_exp	= mpfr_regular_p(tol)? exp : 0;
+  }
+  return MP_ODRF_OK;
+}
+
 /* end of file */
@@ -0,0 +1,300 @@
+/*
+   Part of: Multiple Precision One Dimensional Root Finding
+   Contents: root bracketing Chandrupatla algorithm
+   Date: Fri Oct 16, 2026
+
+   Abstract
+
+	This module implements  the Chandrupatla root bracketing algorithm
+	driver: like Brent's method it  chooses between inverse quadratic
+	interpolation  and bisection, but  the  choice is made  with  a
+	cheaper  test, checking that  the  function is monotonic  enough
+	over the last three points for the interpolation to be safe.
+
+	The new point  is computed as a fraction of the bracket,  so only
+	the fraction is  interpolated; it needs  just the bits that  the
+	step moves, and it is computed with reduced precision.
+
+   Copyright (c) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+   This program is free software:  you can redistribute it and/or modify
+   it under the terms of the  GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at
+   your option) any later version.
+
+   This program is  distributed in the hope that it  will be useful, but
+   WITHOUT  ANY   WARRANTY;  without   even  the  implied   warranty  of
+   MERCHANTABILITY  or FITNESS FOR  A PARTICULAR  PURPOSE.  See  the GNU
+   General Public License for more details.
+
+   You should  have received  a copy of  the GNU General  Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#include "mp-odrf-internals.h"
+
+/* Precision of  the interpolation test:  it compares ratios in  (0, 1),
+   which need only a few bits. */
+#define CHANDRUPATLA_TEST_PREC		32
+
+/* Guard bits of the interpolated fraction. */
+#define CHANDRUPATLA_GUARD_BITS		16
+
+/* The ordinates come first, see "driver_state_ordinate_count". */
+typedef struct {
+  mpfr_t	y_lower;
+  mpfr_t	y_upper;
+  /* The function value at C. */
+  mpfr_t	y_c;
+  /* Scratch variable for "chandrupatla_iterate()". */
+  mpfr_t	y_new;
+  /* The bound replaced by the last iteration, now out of the bracket. */
+  mpfr_t	c;
+  /* Scratch variables for "chandrupatla_iterate()"; the last ones hold
+     the interpolated fraction and have reduced precision. */
+  mpfr_t	x_new, tmp1, tmp2;
+  mpfr_t	d1, d2, d3, ratio, t;
+  /* The bound replaced by the last iteration: -1 for the lower, +1 for
+     the upper, 0 if none. */
+  int		newest;
+  /* The layout flags of the solver. */
+  unsigned	flags;
+} chandrupatla_state_t;
+
+
+/** --------------------------------------------------------------------
+ ** Chandrupatla root bracketing driver: functions.
+ ** ----------------------------------------------------------------- */
+
+static void
+chandrupatla_init (void * driver_state, unsigned flags)
+{
+  chandrupatla_state_t *	state = driver_state;
+  state->newest	= 0;
+  state->flags	= flags;
+}
+static mp_odrf_code_t
+chandrupatla_set (void * driver_state, mp_odrf_mpfr_function_t * f,
+		  mpfr_ptr root, mpfr_ptr x_lower, mpfr_ptr x_upper)
+/* This is equal to "bisection_set()". */
+{
+  mp_odrf_code_t		retval = MP_ODRF_OK;
+  chandrupatla_state_t *	state  = driver_state;
+  int				clo, cup;
+  /* root = (x_lower + x_upper) / 2 */
+  mpfr_add(root, x_lower, x_upper, GMP_RNDN);
+  mpfr_div_2ui(root, root, 1, GMP_RNDN);
+  state->newest = 0;
+  SAFE_FUNC_CALL(retval, f, x_lower, state->y_lower, MP_ODRF_HINT_MIN_BITS);
+  if (MP_ODRF_OK == retval) {
+    SAFE_FUNC_CALL(retval, f, x_upper, state->y_upper, MP_ODRF_HINT_MIN_BITS);
+    if (MP_ODRF_OK == retval) {
+      clo = mpfr_cmp_si(state->y_lower, 0);
+      cup = mpfr_cmp_si(state->y_upper, 0);
+      if (((clo < 0) && (cup < 0)) ||
+	  ((clo > 0) && (cup > 0))) {
+	retval = MP_ODRF_ERROR_ENDPOINTS_DO_NOT_STRADDLE;
+      }
+    }
+  }
+  return retval;
+}
+static mp_prec_t
+chandrupatla_fraction_prec (mpfr_srcptr a, mpfr_srcptr ba, mpfr_srcptr ca, mp_prec_t prec)
+/* Return the precision of the fraction of the bracket interpolated from
+   the newest bound A, given the distances BA and CA of the other points.
+   The interpolation error is about the product of the errors at the three
+   points, so the fraction needs  the bits resolved by  the two older
+   ones; and the step is at most BA wide, so it needs no more than the bits
+   below EXP(A)-EXP(BA) to be exact in the last place. */
+{
+  mp_exp_t	rb, rc;
+  mp_prec_t	bits, limit;
+  if (! mpfr_regular_p(a))
+    return prec;
+  rb = mpfr_get_exp(a) - mpfr_get_exp(ba);
+  rc = mpfr_get_exp(a) - mpfr_get_exp(ca);
+  if (rb < 0)
+    rb = 0;
+  if (rc < 0)
+    rc = 0;
+  bits  = (mp_prec_t)(rb + rc) + CHANDRUPATLA_GUARD_BITS;
+  limit = ((mp_prec_t)rb < prec)? prec - (mp_prec_t)rb + CHANDRUPATLA_GUARD_BITS : CHANDRUPATLA_GUARD_BITS;
+  if (bits > limit)
+    bits = limit;
+  if (bits < MP_ODRF_HINT_MIN_BITS)
+    bits = MP_ODRF_HINT_MIN_BITS;
+  return (bits < prec)? bits : prec;
+}
+static int
+chandrupatla_interpolate (chandrupatla_state_t * state, mpfr_ptr x_lower, mpfr_ptr x_upper)
+/* Store in "tmp1" the inverse quadratic interpolation point through the
+   newest  bound A, the other bound B  and the old point C, if the test of
+   Chandrupatla accepts it: with xi = (A-B)/(C-B) and phi = (fA-fB)/(fC-fB)
+   it must be phi^2 < xi and (1-phi)^2 < 1-xi.  Return false if the
+   bracket must be bisected instead.
+
+   Near the  root A and C are  much closer to each other than to B, so
+   xi and phi are both close to 1: the complements are computed from their
+   own differences, and the conditions are tested in the form that does not
+   subtract them from 1. */
+{
+  mpfr_ptr	a	= (state->newest < 0)? x_lower : x_upper;
+  mpfr_ptr	b	= (state->newest < 0)? x_upper : x_lower;
+  mpfr_ptr	fa	= (state->newest < 0)? state->y_lower : state->y_upper;
+  mpfr_ptr	fb	= (state->newest < 0)? state->y_upper : state->y_lower;
+  mpfr_ptr	fc	= state->y_c;
+  mpfr_ptr	d1	= state->d1;
+  mpfr_ptr	d2	= state->d2;
+  mpfr_ptr	d3	= state->d3;
+  mpfr_ptr	ratio	= state->ratio;
+  mpfr_ptr	t	= state->t;
+  mp_prec_t	prec	= mpfr_get_prec(state->x_new);
+  double	xi, xi1, phi, phi1;
+  int		accept;
+  MPFR_DECL_INIT(ba, CHANDRUPATLA_TEST_PREC);
+  MPFR_DECL_INIT(ca, CHANDRUPATLA_TEST_PREC);
+  MPFR_DECL_INIT(cb, CHANDRUPATLA_TEST_PREC);
+  if (0 == state->newest)
+    return 0;
+  mpfr_sub(ba, b, a, GMP_RNDN);
+  mpfr_sub(ca, state->c, a, GMP_RNDN);
+  mpfr_sub(cb, state->c, b, GMP_RNDN);
+  if (! (mpfr_regular_p(ba) && mpfr_regular_p(ca) && mpfr_regular_p(cb)))
+    return 0;
+  prec = chandrupatla_fraction_prec(a, ba, ca, prec);
+  mp_odrf_mpfr_state_set_prec(d1,    prec, state->flags);
+  mp_odrf_mpfr_state_set_prec(d2,    prec, state->flags);
+  mp_odrf_mpfr_state_set_prec(d3,    prec, state->flags);
+  mp_odrf_mpfr_state_set_prec(ratio, prec, state->flags);
+  mp_odrf_mpfr_state_set_prec(t,     prec, state->flags);
+  /* xi  = (A-B)/(C-B),	  phi  = (fA-fB)/(fC-fB) = d1/d2
+     xi1 = 1-xi = (C-A)/(C-B),  phi1 = 1-phi = (fC-fA)/(fC-fB) = -d3/d2 */
+  mpfr_sub(d1, fb, fa, GMP_RNDN);
+  mpfr_sub(d2, fb, fc, GMP_RNDN);
+  mpfr_sub(d3, fc, fa, GMP_RNDN);
+  mpfr_div(ba, ba, cb, GMP_RNDN);
+  mpfr_div(ca, ca, cb, GMP_RNDN);
+  xi   = - mpfr_get_d(ba, GMP_RNDN);
+  xi1  =   mpfr_get_d(ca, GMP_RNDN);
+  mpfr_div(cb, d1, d2, GMP_RNDN);
+  phi  =   mpfr_get_d(cb, GMP_RNDN);
+  mpfr_div(cb, d3, d2, GMP_RNDN);
+  phi1 = - mpfr_get_d(cb, GMP_RNDN);
+  /* phi^2 < xi  <=>  xi1 < phi1 * (2 - phi1)
+     phi1^2 < xi1  <=>  xi < phi * (2 - phi) */
+  accept = (xi1 < 0.5)? (xi1 < phi1 * (2.0 - phi1)) : (phi * phi < xi);
+  if (accept)
+    accept = (xi < 0.5)? (xi < phi * (2.0 - phi)) : (phi1 * phi1 < xi1);
+  if (! accept)
+    return 0;
+  /* t = fA/(fB-fA) * fC/(fB-fC) + (C-A)/(B-A) * fA/(fC-fA) * fB/(fC-fB)
+       = fA/d2 * (fC/d1 - (C-A)/(B-A) * fB/d3) */
+  mpfr_sub(state->tmp1, b, a, GMP_RNDN);
+  mpfr_sub(ratio, state->c, a, GMP_RNDN);
+  mpfr_div(ratio, ratio, state->tmp1, GMP_RNDN);
+  mpfr_div(d3,    fb, d3,    GMP_RNDN);
+  mpfr_mul(d3,    d3, ratio, GMP_RNDN);
+  mpfr_div(t,     fc, d1,    GMP_RNDN);
+  mpfr_sub(t,     t,  d3,    GMP_RNDN);
+  mpfr_div(d1,    fa, d2,    GMP_RNDN);
+  mpfr_mul(t,     t,  d1,    GMP_RNDN);
+  if (! mpfr_number_p(t))
+    return 0;
+  /* tmp1 = A + t * (B - A) */
+  mpfr_mul(state->tmp1, state->tmp1, t, GMP_RNDN);
+  mpfr_add(state->tmp1, state->tmp1, a, GMP_RNDN);
+  return 1;
+}
+static mp_odrf_code_t
+chandrupatla_iterate (void * driver_state, mp_odrf_mpfr_function_t * f,
+		      mpfr_t root, mpfr_t x_lower, mpfr_t x_upper)
+{
+  mp_odrf_code_t		retval	= MP_ODRF_OK;
+  chandrupatla_state_t *	state	= driver_state;
+  if (mpfr_zero_p(state->y_lower)) {
+    mpfr_set(root,    x_lower, GMP_RNDN);
+    mpfr_set(x_upper, x_lower, GMP_RNDN);
+  } else if (mpfr_zero_p(state->y_upper)) {
+    mpfr_set(root,    x_upper, GMP_RNDN);
+    mpfr_set(x_lower, x_upper, GMP_RNDN);
+  } else {
+    mpfr_ptr	x_new	= state->x_new;
+    mpfr_ptr	y_new	= state->y_new;
+    mpfr_ptr	tmp1	= state->tmp1;
+    mpfr_ptr	tmp2	= state->tmp2;
+    mpfr_ptr	x_bound, y_bound;
+    int		clow, cnew;
+    if (mp_odrf_bracket_is_exhausted(x_new, x_lower, x_upper)) {
+      retval = mp_odrf_bracket_exhausted_root(root, x_lower, x_upper,
+					      state->y_lower, state->y_upper);
+      goto end;
+    }
+    /* X_NEW holds the midpoint, which is used if the interpolation is
+       rejected or the bracket is too narrow to keep it away from the
+       bounds. */
+    if (chandrupatla_interpolate(state, x_lower, x_upper) &&
+	mp_odrf_clamp_inside(tmp1, x_lower, x_upper, tmp2))
+      mpfr_swap(x_new, tmp1);
+    mpfr_sub(tmp1, x_new, (state->newest > 0)? x_upper : x_lower, GMP_RNDN);
+
+    SAFE_FUNC_CALL(retval, f, x_new, y_new, mp_odrf_hint_bits(x_new, tmp1, y_new));
+    if (MP_ODRF_OK != retval) {
+      goto end;
+    }
+    mpfr_set(root, x_new, GMP_RNDN);
+    if (mpfr_zero_p(y_new)) {
+      /* The next iterations must not evaluate the function again. */
+      mpfr_set(x_lower, x_new, GMP_RNDN);
+      mpfr_set(x_upper, x_new, GMP_RNDN);
+      mpfr_set_si(state->y_lower, 0, GMP_RNDN);
+      goto end;
+    }
+    /* Replace the bound with the same sign: the old one becomes C.  The
+       scratch variables are swapped into the state to avoid copying the
+       limbs. */
+    clow = mpfr_cmp_si(state->y_lower, 0);
+    cnew = mpfr_cmp_si(y_new,          0);
+    if (((clow > 0) && (cnew > 0)) || ((clow < 0) && (cnew < 0))) {
+      state->newest = -1;
+      x_bound	    = x_lower;
+      y_bound	    = state->y_lower;
+    } else {
+      state->newest = +1;
+      x_bound	    = x_upper;
+      y_bound	    = state->y_upper;
+    }
+    mpfr_swap(state->c,   x_bound);
+    mpfr_swap(state->y_c, y_bound);
+    mpfr_swap(x_bound,    x_new);
+    mpfr_swap(y_bound,    y_new);
+  }
+ end:
+  return retval;
+}
+
+
+/** --------------------------------------------------------------------
+ ** Chandrupatla root bracketing driver: struct definition.
+ ** ----------------------------------------------------------------- */
+
+static const mp_odrf_mpfr_root_fsolver_driver_t chandrupatla_driver = {
+  .name			= "chandrupatla",
+  .driver_state_size	= sizeof(chandrupatla_state_t),
+  .driver_state_mpfr_count = offsetof(chandrupatla_state_t, newest) / sizeof(mpfr_t),
+  .driver_state_ordinate_count = offsetof(chandrupatla_state_t, c) / sizeof(mpfr_t),
+  .init			= chandrupatla_init,
+  .final		= NULL,
+  .set			= chandrupatla_set,
+  .iterate		= chandrupatla_iterate
+};
+
+const mp_odrf_mpfr_root_fsolver_driver_t * \
+  mp_odrf_mpfr_root_fsolver_chandrupatla = &chandrupatla_driver;
+
+/* end of file */
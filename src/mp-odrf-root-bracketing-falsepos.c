@@ -33,9 +33,14 @@
 
 #include "mp-odrf-internals.h"
 
+/* The ordinates come first, see "driver_state_ordinate_count". */
 typedef struct {
   mpfr_t	y_lower;
   mpfr_t	y_upper;
+  /* Scratch variables for "falsepos_iterate()". */
+  mpfr_t	y_linear, y_bisect;
+  mpfr_t	x_linear, x_bisect;
+  mpfr_t	tmp1, tmp2, tmp3;
 } falsepos_state_t;
 
 
@@ -43,44 +48,21 @@ typedef struct {
  ** Falsepos root bracketing driver: functions.
  ** ----------------------------------------------------------------- */
 
-static void
-falsepos_init (void * driver_state)
-/* This is equal to "bisection_init()". */
-{
-  falsepos_state_t *	state = driver_state;
-  mpfr_init(state->y_lower);
-  mpfr_init(state->y_upper);
-}
-static void
-falsepos_final (void * driver_state)
-/* This is equal to "bisection_final()". */
-{
-  falsepos_state_t *	state = driver_state;
-  mpfr_clear(state->y_lower);
-  mpfr_clear(state->y_upper);
-}
 static mp_odrf_code_t
 falsepos_set (void * driver_state, mp_odrf_mpfr_function_t * f,
 	      mpfr_ptr root, mpfr_ptr x_lower, mpfr_ptr x_upper)
 /* This is equal to "bisection_set()". */
 {
   mp_odrf_code_t	retval = MP_ODRF_OK;
-  {
-    mpfr_t	tmp;
-    mpfr_init(tmp);
-    {
-      /* tmp = (x_lower + x_upper) / 2 */
-      mpfr_add(tmp, x_lower, x_upper, GMP_RNDN);
-      mpfr_mul_d(root, tmp, 0.5, GMP_RNDN);
-    }
-    mpfr_clear(tmp);
-  }
+  /* root = (x_lower + x_upper) / 2 */
+  mpfr_add(root, x_lower, x_upper, GMP_RNDN);
+  mpfr_div_2ui(root, root, 1, GMP_RNDN);
   {
     falsepos_state_t *	state = driver_state;
     int			clo, cup;
-    SAFE_FUNC_CALL(retval, f, x_lower, state->y_lower);
+    SAFE_FUNC_CALL(retval, f, x_lower, state->y_lower, MP_ODRF_HINT_MIN_BITS);
     if (MP_ODRF_OK == retval) {
-      SAFE_FUNC_CALL(retval, f, x_upper, state->y_upper);
+      SAFE_FUNC_CALL(retval, f, x_upper, state->y_upper, MP_ODRF_HINT_MIN_BITS);
       if (MP_ODRF_OK == retval) {
 	clo = mpfr_cmp_si(state->y_lower, 0);
 	cup = mpfr_cmp_si(state->y_upper, 0);
@@ -108,90 +90,88 @@ falsepos_iterate (void * driver_state, mp_odrf_mpfr_function_t * f,
     mpfr_set(x_lower, x_upper, GMP_RNDN);
     retval = MP_ODRF_OK;
   } else {
-    mpfr_t	tmp1, tmp2, tmp3;
-    mpfr_t	x_linear, y_linear;
-    mpfr_t	x_bisect, y_bisect;
+    mpfr_ptr	x_linear = state->x_linear;
+    mpfr_ptr	y_linear = state->y_linear;
+    mpfr_ptr	x_bisect = state->x_bisect;
+    mpfr_ptr	y_bisect = state->y_bisect;
+    mpfr_ptr	tmp1	 = state->tmp1;
+    mpfr_ptr	tmp2	 = state->tmp2;
+    mpfr_ptr	tmp3	 = state->tmp3;
     int		clow, clin, cbis;
-    mpfr_init(tmp1);
-    mpfr_init(tmp2);
-    mpfr_init(tmp3);
-    mpfr_init(x_linear);
-    mpfr_init(y_linear);
-    mpfr_init(x_bisect);
-    mpfr_init(y_bisect);
-    {
-      /* Draw  a line  between f(*lower_bound)  and f(*upper_bound)  and
-	 note where  it crosses the X  axis; that's where we  will split
-	 the interval. */
-      mpfr_sub(tmp1,     x_lower,        x_upper,        GMP_RNDN);
-      mpfr_sub(tmp2,     state->y_lower, state->y_upper, GMP_RNDN);
-      mpfr_div(tmp3,     tmp1,           tmp2,           GMP_RNDN);
-      mpfr_mul(tmp1,     state->y_upper, tmp3,           GMP_RNDN);
-      mpfr_sub(x_linear, x_upper,        tmp1,           GMP_RNDN);
-
-      SAFE_FUNC_CALL(retval, f, x_linear, y_linear);
-      if (MP_ODRF_OK != retval) {
-	goto end;
-      }
-      if (mpfr_zero_p(y_linear)) {
-	mpfr_set(root,    x_linear, GMP_RNDN);
-	mpfr_set(x_lower, x_linear, GMP_RNDN);
-	mpfr_set(x_upper, x_linear, GMP_RNDN);
-	goto end;
-      }
-      /* Discard  the half  of the  interval which  doesn't contain  the
-	 root. */
-      mpfr_set(root, x_linear, GMP_RNDN);
-      clow = mpfr_cmp_si(state->y_lower, 0);
-      clin = mpfr_cmp_si(y_linear,       0);
-      if (((clow > 0) && (clin < 0)) ||
-	  ((clow < 0) && (clin > 0))) {
-	mpfr_set(x_upper,        x_linear, GMP_RNDN);
-	mpfr_set(state->y_upper, y_linear, GMP_RNDN);
-	mpfr_sub(tmp3, x_linear, x_lower, GMP_RNDN);
-      } else {
-	mpfr_set(x_lower,        x_linear, GMP_RNDN);
-	mpfr_set(state->y_lower, y_linear, GMP_RNDN);
-	mpfr_sub(tmp3, x_upper, x_linear, GMP_RNDN);
-      }
-      mpfr_sub(tmp1, x_upper, x_lower, GMP_RNDN);
-      mpfr_mul_d(tmp2, tmp1, 0.5, GMP_RNDN);
-      if (mpfr_less_p(tmp3, tmp2))
-	goto end;
-      mpfr_add(tmp1, x_lower, x_upper, GMP_RNDN);
-      mpfr_mul_d(x_bisect, tmp1, 0.5, GMP_RNDN);
-      SAFE_FUNC_CALL(retval, f, x_bisect, y_bisect);
-      if (MP_ODRF_OK != retval) {
-	goto end;
+    if (mp_odrf_bracket_is_exhausted(x_bisect, x_lower, x_upper)) {
+      retval = mp_odrf_bracket_exhausted_root(root, x_lower, x_upper,
+					      state->y_lower, state->y_upper);
+      goto end;
+    }
+    /* Draw  a line  between  f(*lower_bound)  and f(*upper_bound)  and
+       note where  it crosses the  X axis; that's  where we will  split
+       the interval. */
+    mpfr_sub(tmp1,     x_lower,        x_upper,        GMP_RNDN);
+    mpfr_sub(tmp2,     state->y_lower, state->y_upper, GMP_RNDN);
+    mpfr_div(tmp3,     tmp1,           tmp2,           GMP_RNDN);
+    mpfr_mul(tmp1,     state->y_upper, tmp3,           GMP_RNDN);
+    mpfr_sub(x_linear, x_upper,        tmp1,           GMP_RNDN);
+
+    SAFE_FUNC_CALL(retval, f, x_linear, y_linear,
+		   mp_odrf_hint_bits(x_linear, tmp1, y_linear));
+    if (MP_ODRF_OK != retval) {
+      goto end;
+    }
+    if (mpfr_zero_p(y_linear)) {
+      /* The next iterations must not evaluate the function again. */
+      mpfr_set(root,    x_linear, GMP_RNDN);
+      mpfr_set(x_lower, x_linear, GMP_RNDN);
+      mpfr_set(x_upper, x_linear, GMP_RNDN);
+      mpfr_set_si(state->y_lower, 0, GMP_RNDN);
+      goto end;
+    }
+    /* Discard the  half of the  interval which doesn't contain  the
+       root;  the scratch  variables  are swapped  into  the state  to
+       avoid copying the limbs. */
+    mpfr_set(root, x_linear, GMP_RNDN);
+    clow = mpfr_cmp_si(state->y_lower, 0);
+    clin = mpfr_cmp_si(y_linear,       0);
+    if (((clow > 0) && (clin < 0)) ||
+	((clow < 0) && (clin > 0))) {
+      mpfr_sub(tmp3, x_linear, x_lower, GMP_RNDN);
+      mpfr_swap(x_upper,        x_linear);
+      mpfr_swap(state->y_upper, y_linear);
+    } else {
+      mpfr_sub(tmp3, x_upper, x_linear, GMP_RNDN);
+      mpfr_swap(x_lower,        x_linear);
+      mpfr_swap(state->y_lower, y_linear);
+    }
+    mpfr_sub(tmp2, x_upper, x_lower, GMP_RNDN);
+    mpfr_div_2ui(tmp2, tmp2, 1, GMP_RNDN);
+    if (mpfr_less_p(tmp3, tmp2))
+      goto end;
+    mpfr_add(x_bisect, x_lower, x_upper, GMP_RNDN);
+    mpfr_div_2ui(x_bisect, x_bisect, 1, GMP_RNDN);
+    SAFE_FUNC_CALL(retval, f, x_bisect, y_bisect,
+		   mp_odrf_hint_bits(x_bisect, tmp2, y_bisect));
+    if (MP_ODRF_OK != retval) {
+      goto end;
+    }
+    clow = mpfr_cmp_si(state->y_lower, 0);
+    cbis = mpfr_cmp_si(y_bisect,       0);
+    if (((clow > 0) && (cbis < 0)) ||
+	((clow < 0) && (cbis > 0))) {
+      mpfr_swap(x_upper,        x_bisect);
+      mpfr_swap(state->y_upper, y_bisect);
+      if (mpfr_greater_p(root, x_upper)) {
+	mpfr_add(root, x_lower, x_upper, GMP_RNDN);
+	mpfr_div_2ui(root, root, 1, GMP_RNDN);
       }
-      clow = mpfr_cmp_si(state->y_lower, 0);
-      cbis = mpfr_cmp_si(y_bisect,       0);
-      if (((clow > 0) && (cbis < 0)) ||
-	  ((clow < 0) && (cbis > 0))) {
-	mpfr_set(x_upper,        x_bisect, GMP_RNDN);
-	mpfr_set(state->y_upper, y_bisect, GMP_RNDN);
-	if (mpfr_greater_p(root, x_bisect)) {
-	  mpfr_add(tmp1, x_lower, x_bisect, GMP_RNDN);
-	  mpfr_mul_d(root, tmp1, 0.5, GMP_RNDN);
-	}
-      } else {
-	mpfr_set(x_lower,        x_bisect, GMP_RNDN);
-	mpfr_set(state->y_lower, y_bisect, GMP_RNDN);
-	if (mpfr_less_p(root, x_bisect)) {
-	  mpfr_add(tmp1, x_bisect, x_upper, GMP_RNDN);
-	  mpfr_mul_d(root, tmp1, 0.5, GMP_RNDN);
-	}
+    } else {
+      mpfr_swap(x_lower,        x_bisect);
+      mpfr_swap(state->y_lower, y_bisect);
+      if (mpfr_less_p(root, x_lower)) {
+	mpfr_add(root, x_lower, x_upper, GMP_RNDN);
+	mpfr_div_2ui(root, root, 1, GMP_RNDN);
       }
     }
-  end:
-    mpfr_clear(tmp1);
-    mpfr_clear(tmp2);
-    mpfr_clear(tmp3);
-    mpfr_clear(x_linear);
-    mpfr_clear(y_linear);
-    mpfr_clear(x_bisect);
-    mpfr_clear(y_bisect);
   }
+ end:
   return retval;
 }
 
@@ -203,8 +183,10 @@ falsepos_iterate (void * driver_state, mp_odrf_mpfr_function_t * f,
 static const mp_odrf_mpfr_root_fsolver_driver_t falsepos_driver = {
   .name			= "falsepos",
   .driver_state_size	= sizeof(falsepos_state_t),
-  .init			= falsepos_init,
-  .final		= falsepos_final,
+  .driver_state_mpfr_count = sizeof(falsepos_state_t) / sizeof(mpfr_t),
+  .driver_state_ordinate_count = offsetof(falsepos_state_t, x_linear) / sizeof(mpfr_t),
+  .init			= NULL,
+  .final		= NULL,
   .set			= falsepos_set,
   .iterate		= falsepos_iterate
 };
@@ -0,0 +1,278 @@
+/*
+   Part of: Multiple Precision One Dimensional Root Finding
+   Contents: root bracketing ITP algorithm
+   Date: Fri Oct 16, 2026
+
+   Abstract
+
+	This module implements the ITP (Interpolate, Truncate, Project) root
+	bracketing algorithm driver, by I.F.D. Oliveira and R.H.C. Takahashi:
+	the false position  point is moved towards  the midpoint, then
+	projected into a neighbourhood of the midpoint so that the bracket
+	never needs more iterations than bisection, plus a few.
+
+   Copyright (c) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+   This program is free software:  you can redistribute it and/or modify
+   it under the terms of the  GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at
+   your option) any later version.
+
+   This program is  distributed in the hope that it  will be useful, but
+   WITHOUT  ANY   WARRANTY;  without   even  the  implied   warranty  of
+   MERCHANTABILITY  or FITNESS FOR  A PARTICULAR  PURPOSE.  See  the GNU
+   General Public License for more details.
+
+   You should  have received  a copy of  the GNU General  Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#include "mp-odrf-internals.h"
+
+/* Default parameters,  the ones suggested by the  authors: KAPPA1 is
+   relative to the width of the initial bracket. */
+#define ITP_DEFAULT_KAPPA1	0.2
+#define ITP_DEFAULT_KAPPA2	2.0
+#define ITP_DEFAULT_N0		1
+
+/* The  truncation exponent  must be  in the  range [1, 1 + phi), phi
+   being the golden ratio. */
+#define ITP_MAX_KAPPA2		2.618033988749895
+
+/* The size of the truncation step matters only roughly, so it is computed
+   with a few bits. */
+#define ITP_TRUNCATION_PREC	32
+
+/* The ordinates come first, see "driver_state_ordinate_count". */
+typedef struct {
+  mpfr_t	y_lower;
+  mpfr_t	y_upper;
+  mpfr_t	y_itp;
+  /* Width of the bracket given to "itp_set()". */
+  mpfr_t	width0;
+  /* Scratch variables for "itp_iterate()". */
+  mpfr_t	x_half, x_f, x_itp;
+  mpfr_t	width, delta, radius;
+  mpfr_t	tmp1, tmp2;
+  /* Parameters selected with "mp_odrf_mpfr_root_fsolver_itp_set_parameters()";
+     they are kept by the "set" and "reset" functions. */
+  double	kappa1;
+  double	kappa2;
+  unsigned long	n0;
+  /* Number of iterations since "itp_set()". */
+  unsigned long	count;
+} itp_state_t;
+
+
+/** --------------------------------------------------------------------
+ ** ITP root bracketing driver: functions.
+ ** ----------------------------------------------------------------- */
+
+static void
+itp_init (void * driver_state, unsigned flags MP_ODRF_UNUSED)
+{
+  itp_state_t *	state = driver_state;
+  state->kappa1	= ITP_DEFAULT_KAPPA1;
+  state->kappa2	= ITP_DEFAULT_KAPPA2;
+  state->n0	= ITP_DEFAULT_N0;
+  state->count	= 0;
+}
+static mp_odrf_code_t
+itp_set (void * driver_state, mp_odrf_mpfr_function_t * f,
+	 mpfr_ptr root, mpfr_ptr x_lower, mpfr_ptr x_upper)
+/* This is equal to "bisection_set()",  but it also records the width of
+   the bracket for the projection step. */
+{
+  mp_odrf_code_t	retval = MP_ODRF_OK;
+  itp_state_t *		state  = driver_state;
+  int			clo, cup;
+  /* root = (x_lower + x_upper) / 2 */
+  mpfr_add(root, x_lower, x_upper, GMP_RNDN);
+  mpfr_div_2ui(root, root, 1, GMP_RNDN);
+  mpfr_sub(state->width0, x_upper, x_lower, GMP_RNDU);
+  state->count = 0;
+  SAFE_FUNC_CALL(retval, f, x_lower, state->y_lower, MP_ODRF_HINT_MIN_BITS);
+  if (MP_ODRF_OK == retval) {
+    SAFE_FUNC_CALL(retval, f, x_upper, state->y_upper, MP_ODRF_HINT_MIN_BITS);
+    if (MP_ODRF_OK == retval) {
+      clo = mpfr_cmp_si(state->y_lower, 0);
+      cup = mpfr_cmp_si(state->y_upper, 0);
+      if (((clo < 0) && (cup < 0)) ||
+	  ((clo > 0) && (cup > 0))) {
+	retval = MP_ODRF_ERROR_ENDPOINTS_DO_NOT_STRADDLE;
+      }
+    }
+  }
+  return retval;
+}
+static void
+itp_truncation (itp_state_t * state)
+/* Store  in  DELTA  the  truncation  step:  kappa1  *  width0  *
+   (width / width0)^kappa2.   It is  raised to |x_half| * 2^(1-prec), at
+   least one unit in the last place  of the midpoint: a smaller step would
+   be lost in the rounding, leaving the false position point stuck on one
+   side of the root once the bracket is a few units wide. */
+{
+  mpfr_ptr	tol = state->tmp2;
+  MPFR_DECL_INIT(t, ITP_TRUNCATION_PREC);
+  mpfr_div(t, state->width, state->width0, GMP_RNDN);
+  if (ITP_DEFAULT_KAPPA2 == state->kappa2) {
+    mpfr_sqr(t, t, GMP_RNDN);
+  } else {
+    MPFR_DECL_INIT(kappa2, DBL_MANT_DIG);
+    mpfr_set_d(kappa2, state->kappa2, GMP_RNDN);
+    mpfr_pow(t, t, kappa2, GMP_RNDN);
+  }
+  mpfr_mul_d(t, t, state->kappa1, GMP_RNDN);
+  mpfr_mul(state->delta, t, state->width0, GMP_RNDN);
+  mpfr_div_2ui(tol, state->x_half, (unsigned long)mpfr_get_prec(tol) - 1, GMP_RNDN);
+  mpfr_abs(tol, tol, GMP_RNDN);
+  if (mpfr_less_p(state->delta, tol))
+    mpfr_set(state->delta, tol, GMP_RNDN);
+}
+static mp_odrf_code_t
+itp_iterate (void * driver_state, mp_odrf_mpfr_function_t * f,
+	     mpfr_t root, mpfr_t x_lower, mpfr_t x_upper)
+{
+  mp_odrf_code_t	retval	= MP_ODRF_OK;
+  itp_state_t *		state	= driver_state;
+  if (mpfr_zero_p(state->y_lower)) {
+    mpfr_set(root,    x_lower, GMP_RNDN);
+    mpfr_set(x_upper, x_lower, GMP_RNDN);
+  } else if (mpfr_zero_p(state->y_upper)) {
+    mpfr_set(root,    x_upper, GMP_RNDN);
+    mpfr_set(x_lower, x_upper, GMP_RNDN);
+  } else {
+    mpfr_ptr	x_half	= state->x_half;
+    mpfr_ptr	x_f	= state->x_f;
+    mpfr_ptr	x_itp	= state->x_itp;
+    mpfr_ptr	y_itp	= state->y_itp;
+    mpfr_ptr	width	= state->width;
+    mpfr_ptr	delta	= state->delta;
+    mpfr_ptr	radius	= state->radius;
+    mpfr_ptr	tmp1	= state->tmp1;
+    mpfr_ptr	tmp2	= state->tmp2;
+    int		sigma, clow, citp;
+    if (mp_odrf_bracket_is_exhausted(x_half, x_lower, x_upper)) {
+      retval = mp_odrf_bracket_exhausted_root(root, x_lower, x_upper,
+					      state->y_lower, state->y_upper);
+      goto end;
+    }
+    mpfr_sub(width, x_upper, x_lower, GMP_RNDN);
+    /* Interpolate: the false position point. */
+    mpfr_sub(tmp1, x_lower,        x_upper,        GMP_RNDN);
+    mpfr_sub(tmp2, state->y_lower, state->y_upper, GMP_RNDN);
+    mpfr_div(tmp1, tmp1,           tmp2,           GMP_RNDN);
+    mpfr_mul(tmp1, state->y_upper, tmp1,           GMP_RNDN);
+    mpfr_sub(x_f,  x_upper,        tmp1,           GMP_RNDN);
+    /* Truncate: move towards the midpoint by DELTA, or up to it. */
+    itp_truncation(state);
+    sigma = mpfr_cmp(x_half, x_f);
+    mpfr_sub(tmp1, x_half, x_f, GMP_RNDN);
+    if (mpfr_cmpabs(tmp1, delta) >= 0) {
+      if (sigma > 0)
+	mpfr_add(x_itp, x_f, delta, GMP_RNDN);
+      else
+	mpfr_sub(x_itp, x_f, delta, GMP_RNDN);
+    } else {
+      mpfr_set(x_itp, x_half, GMP_RNDN);
+    }
+    /* Project: radius = width0 * 2^(n0 - count - 1) - width / 2, the
+       distance from the midpoint beyond which the bracket could end up
+       wider than the one of bisection delayed by "n0" steps. */
+    mpfr_mul_2si(radius, state->width0, (long)state->n0 - (long)state->count - 1, GMP_RNDD);
+    mpfr_div_2ui(tmp2, width, 1, GMP_RNDU);
+    mpfr_sub(radius, radius, tmp2, GMP_RNDD);
+    if (mpfr_sgn(radius) < 0)
+      mpfr_set_ui(radius, 0, GMP_RNDN);
+    mpfr_sub(tmp1, x_itp, x_half, GMP_RNDN);
+    if (mpfr_cmpabs(tmp1, radius) > 0) {
+      if (sigma > 0)
+	mpfr_sub(x_itp, x_half, radius, GMP_RNDN);
+      else
+	mpfr_add(x_itp, x_half, radius, GMP_RNDN);
+    }
+    /* Rounding can put the point on a bound, which is not a split. */
+    if (mpfr_lessequal_p(x_itp, x_lower) || mpfr_greaterequal_p(x_itp, x_upper))
+      mpfr_set(x_itp, x_half, GMP_RNDN);
+    ++(state->count);
+
+    SAFE_FUNC_CALL(retval, f, x_itp, y_itp, mp_odrf_hint_bits(x_itp, width, y_itp));
+    if (MP_ODRF_OK != retval) {
+      goto end;
+    }
+    mpfr_set(root, x_itp, GMP_RNDN);
+    if (mpfr_zero_p(y_itp)) {
+      /* The next iterations must not evaluate the function again. */
+      mpfr_set(x_lower, x_itp, GMP_RNDN);
+      mpfr_set(x_upper, x_itp, GMP_RNDN);
+      mpfr_set_si(state->y_lower, 0, GMP_RNDN);
+      goto end;
+    }
+    /* Discard the  half of the  interval which doesn't contain  the
+       root;  the scratch  variables  are swapped  into  the state  to
+       avoid copying the limbs. */
+    clow = mpfr_cmp_si(state->y_lower, 0);
+    citp = mpfr_cmp_si(y_itp,          0);
+    if (((clow > 0) && (citp < 0)) ||
+	((clow < 0) && (citp > 0))) {
+      mpfr_swap(x_upper,        x_itp);
+      mpfr_swap(state->y_upper, y_itp);
+    } else {
+      mpfr_swap(x_lower,        x_itp);
+      mpfr_swap(state->y_lower, y_itp);
+    }
+  }
+ end:
+  return retval;
+}
+
+
+/** --------------------------------------------------------------------
+ ** ITP root bracketing driver: struct definition.
+ ** ----------------------------------------------------------------- */
+
+static const mp_odrf_mpfr_root_fsolver_driver_t itp_driver = {
+  .name			= "itp",
+  .driver_state_size	= sizeof(itp_state_t),
+  .driver_state_mpfr_count = offsetof(itp_state_t, kappa1) / sizeof(mpfr_t),
+  .driver_state_ordinate_count = offsetof(itp_state_t, width0) / sizeof(mpfr_t),
+  .init			= itp_init,
+  .final		= NULL,
+  .set			= itp_set,
+  .iterate		= itp_iterate
+};
+
+const mp_odrf_mpfr_root_fsolver_driver_t * mp_odrf_mpfr_root_fsolver_itp = &itp_driver;
+
+
+/** --------------------------------------------------------------------
+ ** ITP root bracketing driver: configuration.
+ ** ----------------------------------------------------------------- */
+
+mp_odrf_code_t
+mp_odrf_mpfr_root_fsolver_itp_set_parameters (mp_odrf_mpfr_root_fsolver_t * S,
+					      double kappa1, double kappa2,
+					      unsigned long n0)
+/* Select the truncation parameters KAPPA1 and KAPPA2 and the projection
+   slack N0. */
+{
+  itp_state_t *	state = S->driver_state;
+  if (&itp_driver != S->driver)
+    return MP_ODRF_ERROR_UNSUPPORTED_BY_DRIVER;
+  /* The comparisons are false for NaN. */
+  if ((! (kappa1 > 0.0)) || (kappa1 > DBL_MAX) ||
+      (! (kappa2 >= 1.0)) || (kappa2 >= ITP_MAX_KAPPA2))
+    return MP_ODRF_ERROR_INVALID_DRIVER_PARAMETER;
+  state->kappa1	= kappa1;
+  state->kappa2	= kappa2;
+  state->n0	= n0;
+  return MP_ODRF_OK;
+}
+
+/* end of file */
@@ -0,0 +1,250 @@
+/*
+   Part of: Multiple Precision One Dimensional Root Finding
+   Contents: root bracketing modified false position algorithms
+   Date: Fri Oct 16, 2026
+
+   Abstract
+
+	This module implements the  Illinois, Pegasus and Anderson-Bjorck
+	root bracketing algorithm drivers: the false position algorithm
+	with one evaluation per step, in which the function value at the
+	retained bound is scaled down when the same bound is replaced twice
+	in a row, so that the interpolation point does not stagnate.
+
+   Copyright (c) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+   This program is free software:  you can redistribute it and/or modify
+   it under the terms of the  GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at
+   your option) any later version.
+
+   This program is  distributed in the hope that it  will be useful, but
+   WITHOUT  ANY   WARRANTY;  without   even  the  implied   warranty  of
+   MERCHANTABILITY  or FITNESS FOR  A PARTICULAR  PURPOSE.  See  the GNU
+   General Public License for more details.
+
+   You should  have received  a copy of  the GNU General  Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#include "mp-odrf-internals.h"
+
+typedef enum {
+  ILLINOIS,
+  PEGASUS,
+  ANDERSON_BJORCK
+} modified_falsepos_variant_t;
+
+/* The ordinates come first, see "driver_state_ordinate_count": the
+   function values, possibly scaled, and the scaling factor. */
+typedef struct {
+  mpfr_t	y_lower;
+  mpfr_t	y_upper;
+  /* Scratch variables for "modified_falsepos_iterate()". */
+  mpfr_t	y_new, factor;
+  mpfr_t	x_new;
+  mpfr_t	tmp1, tmp2;
+  /* The bound replaced by the last iteration: -1 for the lower, +1 for
+     the upper, 0 if none. */
+  int		last_side;
+} modified_falsepos_state_t;
+
+
+/** --------------------------------------------------------------------
+ ** Modified false position root bracketing drivers: functions.
+ ** ----------------------------------------------------------------- */
+
+static mp_odrf_code_t
+modified_falsepos_set (void * driver_state, mp_odrf_mpfr_function_t * f,
+		       mpfr_ptr root, mpfr_ptr x_lower, mpfr_ptr x_upper)
+/* This is equal to "bisection_set()". */
+{
+  mp_odrf_code_t		retval = MP_ODRF_OK;
+  modified_falsepos_state_t *	state  = driver_state;
+  int				clo, cup;
+  /* root = (x_lower + x_upper) / 2 */
+  mpfr_add(root, x_lower, x_upper, GMP_RNDN);
+  mpfr_div_2ui(root, root, 1, GMP_RNDN);
+  state->last_side = 0;
+  SAFE_FUNC_CALL(retval, f, x_lower, state->y_lower, MP_ODRF_HINT_MIN_BITS);
+  if (MP_ODRF_OK == retval) {
+    SAFE_FUNC_CALL(retval, f, x_upper, state->y_upper, MP_ODRF_HINT_MIN_BITS);
+    if (MP_ODRF_OK == retval) {
+      clo = mpfr_cmp_si(state->y_lower, 0);
+      cup = mpfr_cmp_si(state->y_upper, 0);
+      if (((clo < 0) && (cup < 0)) ||
+	  ((clo > 0) && (cup > 0))) {
+	retval = MP_ODRF_ERROR_ENDPOINTS_DO_NOT_STRADDLE;
+      }
+    }
+  }
+  return retval;
+}
+static void
+modified_falsepos_scale (modified_falsepos_state_t * state, modified_falsepos_variant_t variant,
+			 mpfr_ptr y_retained, mpfr_srcptr y_replaced)
+/* Scale the function value Y_RETAINED at the bound kept twice in a row;
+   Y_REPLACED  is the  old value  at the  other bound,  "y_new" the new
+   one: they have the same sign. */
+{
+  mpfr_ptr	factor = state->factor;
+  switch (variant) {
+  case ILLINOIS:
+    mpfr_div_2ui(y_retained, y_retained, 1, GMP_RNDN);
+    return;
+  case PEGASUS:
+    /* factor = y_replaced / (y_replaced + y_new), in (0, 1) */
+    mpfr_add(factor, y_replaced, state->y_new, GMP_RNDN);
+    mpfr_div(factor, y_replaced, factor, GMP_RNDN);
+    break;
+  case ANDERSON_BJORCK:
+    /* factor = 1 - y_new / y_replaced, or 1/2 if not positive */
+    mpfr_div(factor, state->y_new, y_replaced, GMP_RNDN);
+    mpfr_ui_sub(factor, 1, factor, GMP_RNDN);
+    if (mpfr_sgn(factor) <= 0)
+      mpfr_set_d(factor, 0.5, GMP_RNDN);
+    break;
+  }
+  mpfr_mul(y_retained, y_retained, factor, GMP_RNDN);
+}
+static mp_odrf_code_t
+modified_falsepos_iterate (void * driver_state, mp_odrf_mpfr_function_t * f,
+			   mpfr_t root, mpfr_t x_lower, mpfr_t x_upper,
+			   modified_falsepos_variant_t variant)
+{
+  mp_odrf_code_t		retval	= MP_ODRF_OK;
+  modified_falsepos_state_t *	state	= driver_state;
+  if (mpfr_zero_p(state->y_lower)) {
+    mpfr_set(root,    x_lower, GMP_RNDN);
+    mpfr_set(x_upper, x_lower, GMP_RNDN);
+  } else if (mpfr_zero_p(state->y_upper)) {
+    mpfr_set(root,    x_upper, GMP_RNDN);
+    mpfr_set(x_lower, x_upper, GMP_RNDN);
+  } else {
+    mpfr_ptr	x_new	= state->x_new;
+    mpfr_ptr	y_new	= state->y_new;
+    mpfr_ptr	tmp1	= state->tmp1;
+    mpfr_ptr	tmp2	= state->tmp2;
+    int		clow, cnew, side;
+    if (mp_odrf_bracket_is_exhausted(x_new, x_lower, x_upper)) {
+      retval = mp_odrf_bracket_exhausted_root(root, x_lower, x_upper,
+					      state->y_lower, state->y_upper);
+      goto end;
+    }
+    /* Draw a line between the  bounds, with the scaled function values,
+       and split the interval where it crosses the X axis. */
+    mpfr_sub(tmp1, x_lower,        x_upper,        GMP_RNDN);
+    mpfr_sub(tmp2, state->y_lower, state->y_upper, GMP_RNDN);
+    mpfr_div(tmp2, tmp1,           tmp2,           GMP_RNDN);
+    mpfr_mul(tmp1, state->y_upper, tmp2,           GMP_RNDN);
+    mpfr_sub(tmp2, x_upper,        tmp1,           GMP_RNDN);
+    /* X_NEW holds the midpoint, which is used if the bracket is too narrow
+       to keep the crossing away from the bounds. */
+    if (mp_odrf_clamp_inside(tmp2, x_lower, x_upper, tmp1))
+      mpfr_swap(x_new, tmp2);
+    mpfr_sub(tmp1, x_upper, x_new, GMP_RNDN);
+
+    SAFE_FUNC_CALL(retval, f, x_new, y_new, mp_odrf_hint_bits(x_new, tmp1, y_new));
+    if (MP_ODRF_OK != retval) {
+      goto end;
+    }
+    mpfr_set(root, x_new, GMP_RNDN);
+    if (mpfr_zero_p(y_new)) {
+      /* The next iterations must not evaluate the function again. */
+      mpfr_set(x_lower, x_new, GMP_RNDN);
+      mpfr_set(x_upper, x_new, GMP_RNDN);
+      mpfr_set_si(state->y_lower, 0, GMP_RNDN);
+      goto end;
+    }
+    /* Replace the bound with the same sign; if it is the one replaced by
+       the last iteration too, scale the value at the other.  The scratch
+       variables are swapped into the state to avoid copying the limbs. */
+    clow = mpfr_cmp_si(state->y_lower, 0);
+    cnew = mpfr_cmp_si(y_new,          0);
+    side = (((clow > 0) && (cnew > 0)) || ((clow < 0) && (cnew < 0)))? -1 : +1;
+    if (side < 0) {
+      if (side == state->last_side)
+	modified_falsepos_scale(state, variant, state->y_upper, state->y_lower);
+      mpfr_swap(x_lower,        x_new);
+      mpfr_swap(state->y_lower, y_new);
+    } else {
+      if (side == state->last_side)
+	modified_falsepos_scale(state, variant, state->y_lower, state->y_upper);
+      mpfr_swap(x_upper,        x_new);
+      mpfr_swap(state->y_upper, y_new);
+    }
+    state->last_side = side;
+  }
+ end:
+  return retval;
+}
+static mp_odrf_code_t
+illinois_iterate (void * driver_state, mp_odrf_mpfr_function_t * f,
+		  mpfr_t root, mpfr_t x_lower, mpfr_t x_upper)
+{
+  return modified_falsepos_iterate(driver_state, f, root, x_lower, x_upper, ILLINOIS);
+}
+static mp_odrf_code_t
+pegasus_iterate (void * driver_state, mp_odrf_mpfr_function_t * f,
+		 mpfr_t root, mpfr_t x_lower, mpfr_t x_upper)
+{
+  return modified_falsepos_iterate(driver_state, f, root, x_lower, x_upper, PEGASUS);
+}
+static mp_odrf_code_t
+anderson_bjorck_iterate (void * driver_state, mp_odrf_mpfr_function_t * f,
+			 mpfr_t root, mpfr_t x_lower, mpfr_t x_upper)
+{
+  return modified_falsepos_iterate(driver_state, f, root, x_lower, x_upper, ANDERSON_BJORCK);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Modified false position root bracketing drivers: struct definitions.
+ ** ----------------------------------------------------------------- */
+
+static const mp_odrf_mpfr_root_fsolver_driver_t illinois_driver = {
+  .name			= "illinois",
+  .driver_state_size	= sizeof(modified_falsepos_state_t),
+  .driver_state_mpfr_count = offsetof(modified_falsepos_state_t, last_side) / sizeof(mpfr_t),
+  .driver_state_ordinate_count = offsetof(modified_falsepos_state_t, x_new) / sizeof(mpfr_t),
+  .init			= NULL,
+  .final		= NULL,
+  .set			= modified_falsepos_set,
+  .iterate		= illinois_iterate
+};
+
+static const mp_odrf_mpfr_root_fsolver_driver_t pegasus_driver = {
+  .name			= "pegasus",
+  .driver_state_size	= sizeof(modified_falsepos_state_t),
+  .driver_state_mpfr_count = offsetof(modified_falsepos_state_t, last_side) / sizeof(mpfr_t),
+  .driver_state_ordinate_count = offsetof(modified_falsepos_state_t, x_new) / sizeof(mpfr_t),
+  .init			= NULL,
+  .final		= NULL,
+  .set			= modified_falsepos_set,
+  .iterate		= pegasus_iterate
+};
+
+static const mp_odrf_mpfr_root_fsolver_driver_t anderson_bjorck_driver = {
+  .name			= "anderson-bjorck",
+  .driver_state_size	= sizeof(modified_falsepos_state_t),
+  .driver_state_mpfr_count = offsetof(modified_falsepos_state_t, last_side) / sizeof(mpfr_t),
+  .driver_state_ordinate_count = offsetof(modified_falsepos_state_t, x_new) / sizeof(mpfr_t),
+  .init			= NULL,
+  .final		= NULL,
+  .set			= modified_falsepos_set,
+  .iterate		= anderson_bjorck_iterate
+};
+
+const mp_odrf_mpfr_root_fsolver_driver_t * \
+  mp_odrf_mpfr_root_fsolver_illinois = &illinois_driver;
+const mp_odrf_mpfr_root_fsolver_driver_t * \
+  mp_odrf_mpfr_root_fsolver_pegasus = &pegasus_driver;
+const mp_odrf_mpfr_root_fsolver_driver_t * \
+  mp_odrf_mpfr_root_fsolver_anderson_bjorck = &anderson_bjorck_driver;
+
+/* end of file */
@@ -0,0 +1,209 @@
+/*
+   Part of: Multiple Precision One Dimensional Root Finding
+   Contents: root bracketing Ridders algorithm
+   Date: Fri Oct 16, 2026
+
+   Abstract
+
+	This module implements Ridders' root bracketing algorithm driver:
+	the function is evaluated at  the midpoint, then an exponential fit
+	through the bounds and  the midpoint gives a  second point, always
+	inside the bracket.
+
+   Copyright (c) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+   This program is free software:  you can redistribute it and/or modify
+   it under the terms of the  GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at
+   your option) any later version.
+
+   This program is  distributed in the hope that it  will be useful, but
+   WITHOUT  ANY   WARRANTY;  without   even  the  implied   warranty  of
+   MERCHANTABILITY  or FITNESS FOR  A PARTICULAR  PURPOSE.  See  the GNU
+   General Public License for more details.
+
+   You should  have received  a copy of  the GNU General  Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#include "mp-odrf-internals.h"
+
+/* The  ordinates  come first,  see "driver_state_ordinate_count": the
+   function values, the square root of "y_mid^2 - y_lower * y_upper" and
+   the ratio "y_mid / s". */
+typedef struct {
+  mpfr_t	y_lower;
+  mpfr_t	y_upper;
+  /* Scratch variables for "ridders_iterate()". */
+  mpfr_t	y_mid, y_new;
+  mpfr_t	s, ratio;
+  mpfr_t	x_mid, x_new;
+  mpfr_t	step, tol;
+} ridders_state_t;
+
+
+/** --------------------------------------------------------------------
+ ** Ridders root bracketing driver: functions.
+ ** ----------------------------------------------------------------- */
+
+static mp_odrf_code_t
+ridders_set (void * driver_state, mp_odrf_mpfr_function_t * f,
+	     mpfr_ptr root, mpfr_ptr x_lower, mpfr_ptr x_upper)
+/* This is equal to "bisection_set()". */
+{
+  mp_odrf_code_t	retval = MP_ODRF_OK;
+  ridders_state_t *	state  = driver_state;
+  int			clo, cup;
+  /* root = (x_lower + x_upper) / 2 */
+  mpfr_add(root, x_lower, x_upper, GMP_RNDN);
+  mpfr_div_2ui(root, root, 1, GMP_RNDN);
+  SAFE_FUNC_CALL(retval, f, x_lower, state->y_lower, MP_ODRF_HINT_MIN_BITS);
+  if (MP_ODRF_OK == retval) {
+    SAFE_FUNC_CALL(retval, f, x_upper, state->y_upper, MP_ODRF_HINT_MIN_BITS);
+    if (MP_ODRF_OK == retval) {
+      clo = mpfr_cmp_si(state->y_lower, 0);
+      cup = mpfr_cmp_si(state->y_upper, 0);
+      if (((clo < 0) && (cup < 0)) ||
+	  ((clo > 0) && (cup > 0))) {
+	retval = MP_ODRF_ERROR_ENDPOINTS_DO_NOT_STRADDLE;
+      }
+    }
+  }
+  return retval;
+}
+static mp_odrf_code_t
+ridders_iterate (void * driver_state, mp_odrf_mpfr_function_t * f,
+		 mpfr_t root, mpfr_t x_lower, mpfr_t x_upper)
+{
+  mp_odrf_code_t	retval	= MP_ODRF_OK;
+  ridders_state_t *	state	= driver_state;
+  if (mpfr_zero_p(state->y_lower)) {
+    mpfr_set(root,    x_lower, GMP_RNDN);
+    mpfr_set(x_upper, x_lower, GMP_RNDN);
+  } else if (mpfr_zero_p(state->y_upper)) {
+    mpfr_set(root,    x_upper, GMP_RNDN);
+    mpfr_set(x_lower, x_upper, GMP_RNDN);
+  } else {
+    mpfr_ptr	x_mid	= state->x_mid;
+    mpfr_ptr	y_mid	= state->y_mid;
+    mpfr_ptr	x_new	= state->x_new;
+    mpfr_ptr	y_new	= state->y_new;
+    mpfr_ptr	s	= state->s;
+    mpfr_ptr	ratio	= state->ratio;
+    mpfr_ptr	step	= state->step;
+    mpfr_ptr	tol	= state->tol;
+    int		clow, cmid;
+    if (mp_odrf_bracket_is_exhausted(x_mid, x_lower, x_upper)) {
+      retval = mp_odrf_bracket_exhausted_root(root, x_lower, x_upper,
+					      state->y_lower, state->y_upper);
+      goto end;
+    }
+    mpfr_sub(step, x_mid, x_lower, GMP_RNDN);
+    SAFE_FUNC_CALL(retval, f, x_mid, y_mid, mp_odrf_hint_bits(x_mid, step, y_mid));
+    if (MP_ODRF_OK != retval) {
+      goto end;
+    }
+    mpfr_set(root, x_mid, GMP_RNDN);
+    if (mpfr_zero_p(y_mid)) {
+      /* The next iterations must not evaluate the function again. */
+      mpfr_set(x_lower, x_mid, GMP_RNDN);
+      mpfr_set(x_upper, x_mid, GMP_RNDN);
+      mpfr_set_si(state->y_lower, 0, GMP_RNDN);
+      goto end;
+    }
+    /* s = sqrt(y_mid^2 - y_lower * y_upper); the product is negative, so
+       there is no cancellation and S is not below |y_mid|. */
+    mpfr_mul(s,     state->y_lower, state->y_upper, GMP_RNDN);
+    mpfr_sqr(ratio, y_mid,                          GMP_RNDN);
+    mpfr_sub(s,     ratio,          s,              GMP_RNDN);
+    mpfr_sqrt(s,    s,                              GMP_RNDN);
+    /* x_new = x_mid + (x_mid - x_lower) * sign(y_lower) * y_mid / s */
+    mpfr_div(ratio, y_mid, s, GMP_RNDN);
+    mpfr_mul(step,  step,  ratio, GMP_RNDN);
+    if (mpfr_sgn(state->y_lower) > 0)
+      mpfr_add(x_new, x_mid, step, GMP_RNDN);
+    else
+      mpfr_sub(x_new, x_mid, step, GMP_RNDN);
+    clow = mpfr_cmp_si(state->y_lower, 0);
+    cmid = mpfr_cmp_si(y_mid,          0);
+    /* The point is kept away from the bounds, but a narrow bracket or the
+       rounding can put it on a bound or on the midpoint: then this is a
+       bisection step.  The scratch variables are swapped into
+       the state to avoid copying the limbs. */
+    if ((! mp_odrf_clamp_inside(x_new, x_lower, x_upper, tol)) ||
+	mpfr_equal_p(x_new, x_mid)) {
+      if (((clow > 0) && (cmid < 0)) ||
+	  ((clow < 0) && (cmid > 0))) {
+	mpfr_swap(x_upper,        x_mid);
+	mpfr_swap(state->y_upper, y_mid);
+      } else {
+	mpfr_swap(x_lower,        x_mid);
+	mpfr_swap(state->y_lower, y_mid);
+      }
+      goto end;
+    }
+    mpfr_sub(step, x_new, x_mid, GMP_RNDN);
+    SAFE_FUNC_CALL(retval, f, x_new, y_new, mp_odrf_hint_bits(x_new, step, y_new));
+    if (MP_ODRF_OK != retval) {
+      goto end;
+    }
+    mpfr_set(root, x_new, GMP_RNDN);
+    if (mpfr_zero_p(y_new)) {
+      mpfr_set(x_lower, x_new, GMP_RNDN);
+      mpfr_set(x_upper, x_new, GMP_RNDN);
+      mpfr_set_si(state->y_lower, 0, GMP_RNDN);
+      goto end;
+    }
+    /* Keep the narrowest of the  brackets made by the four points: with
+       P and Q the midpoint and  the new point in ascending order, the
+       sign changes in [x_lower, P], [P, Q] or [Q, x_upper]. */
+    {
+      int	p_first = mpfr_less_p(x_mid, x_new);
+      mpfr_ptr	xp = (p_first)? x_mid : x_new, yp = (p_first)? y_mid : y_new;
+      mpfr_ptr	xq = (p_first)? x_new : x_mid, yq = (p_first)? y_new : y_mid;
+      int	cp = mpfr_cmp_si(yp, 0);
+      int	cq = mpfr_cmp_si(yq, 0);
+      if (((clow > 0) && (cp < 0)) ||
+	  ((clow < 0) && (cp > 0))) {
+	mpfr_swap(x_upper,        xp);
+	mpfr_swap(state->y_upper, yp);
+      } else if (((cp > 0) && (cq < 0)) ||
+		 ((cp < 0) && (cq > 0))) {
+	mpfr_swap(x_lower,        xp);
+	mpfr_swap(state->y_lower, yp);
+	mpfr_swap(x_upper,        xq);
+	mpfr_swap(state->y_upper, yq);
+      } else {
+	mpfr_swap(x_lower,        xq);
+	mpfr_swap(state->y_lower, yq);
+      }
+    }
+  }
+ end:
+  return retval;
+}
+
+
+/** --------------------------------------------------------------------
+ ** Ridders root bracketing driver: struct definition.
+ ** ----------------------------------------------------------------- */
+
+static const mp_odrf_mpfr_root_fsolver_driver_t ridders_driver = {
+  .name			= "ridders",
+  .driver_state_size	= sizeof(ridders_state_t),
+  .driver_state_mpfr_count = sizeof(ridders_state_t) / sizeof(mpfr_t),
+  .driver_state_ordinate_count = offsetof(ridders_state_t, x_mid) / sizeof(mpfr_t),
+  .init			= NULL,
+  .final		= NULL,
+  .set			= ridders_set,
+  .iterate		= ridders_iterate
+};
+
+const mp_odrf_mpfr_root_fsolver_driver_t * mp_odrf_mpfr_root_fsolver_ridders = &ridders_driver;
+
+/* end of file */
@@ -0,0 +1,390 @@
+/*
+   Part of: Multiple Precision One Dimensional Root Finding
+   Contents: root bracketing TOMS 748 algorithm
+   Date: Fri Oct 16, 2026
+
+   Abstract
+
+	This  module implements  the root  bracketing algorithm  748 of
+	Alefeld, Potra and Shi (ACM TOMS,  1995) with the cubic inverse
+	interpolation: each group of iterations does two interpolation
+	steps,  a  double-length  secant  step and,  if  the  bracket  did
+	not shrink enough, a bisection step.
+
+	Every iteration  of the driver evaluates the  function once; the
+	position in the group is saved in the state.
+
+   Copyright (c) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+   This program is free software:  you can redistribute it and/or modify
+   it under the terms of the  GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at
+   your option) any later version.
+
+   This program is  distributed in the hope that it  will be useful, but
+   WITHOUT  ANY   WARRANTY;  without   even  the  implied   warranty  of
+   MERCHANTABILITY  or FITNESS FOR  A PARTICULAR  PURPOSE.  See  the GNU
+   General Public License for more details.
+
+   You should  have received  a copy of  the GNU General  Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#include "mp-odrf-internals.h"
+
+/* The steps of the algorithm, in the order they are taken; after the
+   first two, the last four are repeated. */
+typedef enum {
+  TOMS748_SECANT,
+  TOMS748_QUADRATIC,
+  TOMS748_INTERPOLATION_1,
+  TOMS748_INTERPOLATION_2,
+  TOMS748_DOUBLE_SECANT,
+  TOMS748_BISECTION
+} toms748_phase_t;
+
+/* The ordinates come first, see "driver_state_ordinate_count": the
+   function values at the bounds "a" and "b", at the new point "c", and
+   at the previous points "d" and "e". */
+typedef struct {
+  mpfr_t	fa, fb, fc, fd, fe;
+  mpfr_t	c, d, e;
+  /* Width of the bracket at the start of the current group. */
+  mpfr_t	width0;
+  /* Scratch variables for the interpolation functions. */
+  mpfr_t	q11, q21, q31, d21, d31;
+  mpfr_t	den;
+  toms748_phase_t	phase;
+} toms748_state_t;
+
+
+/** --------------------------------------------------------------------
+ ** TOMS 748 root bracketing driver: interpolation.
+ ** ----------------------------------------------------------------- */
+
+/* In the  functions below A and B are the bounds of the bracket, with
+   function  values "fa" and  "fb"  in the state;  the new point is
+   stored in "c", always inside the bracket.  It can be equal to a bound:
+   "toms748_bracket()" moves it away. */
+
+static void
+toms748_midpoint (toms748_state_t * state, mpfr_srcptr a, mpfr_srcptr b)
+{
+  mpfr_add(state->c, a, b, GMP_RNDN);
+  mpfr_div_2ui(state->c, state->c, 1, GMP_RNDN);
+}
+static int
+toms748_is_inside (toms748_state_t * state, mpfr_srcptr a, mpfr_srcptr b)
+/* Return true if "c" is a number  inside the bracket.  Close to the root
+   the interpolation often rounds to the nearest bound, which is still a
+   good guess: falling back to the midpoint would make the last bits be
+   found by bisection. */
+{
+  return (mpfr_greaterequal_p(state->c, a) && mpfr_lessequal_p(state->c, b));
+}
+static void
+toms748_secant (toms748_state_t * state, mpfr_srcptr a, mpfr_srcptr b)
+/* c = a - fa * (b - a) / (fb - fa) */
+{
+  mpfr_sub(state->den, state->fb, state->fa, GMP_RNDN);
+  mpfr_sub(state->q11, b, a, GMP_RNDN);
+  mpfr_mul(state->q11, state->q11, state->fa, GMP_RNDN);
+  mpfr_div(state->q11, state->q11, state->den, GMP_RNDN);
+  mpfr_sub(state->c, a, state->q11, GMP_RNDN);
+  if (! toms748_is_inside(state, a, b))
+    toms748_midpoint(state, a, b);
+}
+static void
+toms748_quadratic (toms748_state_t * state, mpfr_srcptr a, mpfr_srcptr b, int count)
+/* Take COUNT Newton steps towards the  root of the quadratic through
+   (a, fa), (b, fb) and (d, fd), starting from the bound at which the
+   quadratic has the sign of its second derivative; fall back to the
+   secant step if the quadratic is degenerate. */
+{
+  mpfr_ptr	B = state->q31, A = state->d21;
+  mpfr_ptr	num = state->q11, tmp = state->q21;
+  int		i;
+  /* B = (fb - fa) / (b - a) */
+  mpfr_sub(state->den, state->fb, state->fa, GMP_RNDN);
+  mpfr_sub(tmp, b, a, GMP_RNDN);
+  mpfr_div(B, state->den, tmp, GMP_RNDN);
+  /* A = ((fd - fb) / (d - b) - B) / (d - a) */
+  mpfr_sub(state->den, state->fd, state->fb, GMP_RNDN);
+  mpfr_sub(tmp, state->d, b, GMP_RNDN);
+  if (mpfr_zero_p(tmp))
+    goto secant;
+  mpfr_div(A, state->den, tmp, GMP_RNDN);
+  mpfr_sub(A, A, B, GMP_RNDN);
+  mpfr_sub(tmp, state->d, a, GMP_RNDN);
+  if (mpfr_zero_p(tmp))
+    goto secant;
+  mpfr_div(A, A, tmp, GMP_RNDN);
+  if (mpfr_zero_p(A))
+    goto secant;
+  mpfr_set(state->c, ((mpfr_sgn(A) > 0) == (mpfr_sgn(state->fa) > 0))? a : b, GMP_RNDN);
+  for (i=0; i<count; ++i) {
+    /* num = fa + (B + A (c - b)) (c - a) */
+    mpfr_sub(num, state->c, b, GMP_RNDN);
+    mpfr_mul(num, num, A, GMP_RNDN);
+    mpfr_add(num, num, B, GMP_RNDN);
+    mpfr_sub(tmp, state->c, a, GMP_RNDN);
+    mpfr_mul(num, num, tmp, GMP_RNDN);
+    mpfr_add(num, num, state->fa, GMP_RNDN);
+    /* tmp = B + A (2 c - a - b) */
+    mpfr_mul_2ui(tmp, state->c, 1, GMP_RNDN);
+    mpfr_sub(tmp, tmp, a, GMP_RNDN);
+    mpfr_sub(tmp, tmp, b, GMP_RNDN);
+    mpfr_mul(tmp, tmp, A, GMP_RNDN);
+    mpfr_add(tmp, tmp, B, GMP_RNDN);
+    if (mpfr_zero_p(tmp))
+      goto secant;
+    mpfr_div(num, num, tmp, GMP_RNDN);
+    mpfr_sub(state->c, state->c, num, GMP_RNDN);
+  }
+  if (toms748_is_inside(state, a, b))
+    return;
+ secant:
+  toms748_secant(state, a, b);
+}
+static int
+toms748_values_coincide (toms748_state_t * state)
+/* Return true if two of the function values at the four points are
+   equal: the inverse cubic is not defined. */
+{
+  return (mpfr_equal_p(state->fa, state->fb) || mpfr_equal_p(state->fa, state->fd) ||
+	  mpfr_equal_p(state->fa, state->fe) || mpfr_equal_p(state->fb, state->fd) ||
+	  mpfr_equal_p(state->fb, state->fe) || mpfr_equal_p(state->fd, state->fe));
+}
+static void
+toms748_cubic (toms748_state_t * state, mpfr_srcptr a, mpfr_srcptr b, int count)
+/* Evaluate at zero the inverse cubic through the points a, b, d and e,
+   with Aitken-Neville  interpolation; if two  function values are
+   equal or the result is outside the bracket, fall back to COUNT Newton
+   steps on the quadratic. */
+{
+  mpfr_ptr	q11 = state->q11, q21 = state->q21, q31 = state->q31;
+  mpfr_ptr	d21 = state->d21, d31 = state->d31, den = state->den;
+  if (toms748_values_coincide(state)) {
+    toms748_quadratic(state, a, b, count);
+    return;
+  }
+  /* q11 = (d - e) fd / (fe - fd) */
+  mpfr_sub(den, state->fe, state->fd, GMP_RNDN);
+  mpfr_sub(q11, state->d, state->e, GMP_RNDN);
+  mpfr_mul(q11, q11, state->fd, GMP_RNDN);
+  mpfr_div(q11, q11, den, GMP_RNDN);
+  /* q21 = (b - d) fb / (fd - fb), d21 = (b - d) fd / (fd - fb) */
+  mpfr_sub(den, state->fd, state->fb, GMP_RNDN);
+  mpfr_sub(d21, b, state->d, GMP_RNDN);
+  mpfr_div(d21, d21, den, GMP_RNDN);
+  mpfr_mul(q21, d21, state->fb, GMP_RNDN);
+  mpfr_mul(d21, d21, state->fd, GMP_RNDN);
+  /* q31 = (a - b) fa / (fb - fa), d31 = (a - b) fb / (fb - fa) */
+  mpfr_sub(den, state->fb, state->fa, GMP_RNDN);
+  mpfr_sub(d31, a, b, GMP_RNDN);
+  mpfr_div(d31, d31, den, GMP_RNDN);
+  mpfr_mul(q31, d31, state->fa, GMP_RNDN);
+  mpfr_mul(d31, d31, state->fb, GMP_RNDN);
+  /* q22 = (d21 - q11) fb / (fe - fb), stored in q11 */
+  mpfr_sub(den, state->fe, state->fb, GMP_RNDN);
+  mpfr_sub(q11, d21, q11, GMP_RNDN);
+  mpfr_mul(q11, q11, state->fb, GMP_RNDN);
+  mpfr_div(q11, q11, den, GMP_RNDN);
+  /* q32 = (d31 - q21) fa / (fd - fa), stored in q21;
+     d32 = (d31 - q21) fd / (fd - fa), stored in d21 */
+  mpfr_sub(den, state->fd, state->fa, GMP_RNDN);
+  mpfr_sub(d31, d31, q21, GMP_RNDN);
+  mpfr_div(d31, d31, den, GMP_RNDN);
+  mpfr_mul(q21, d31, state->fa, GMP_RNDN);
+  mpfr_mul(d21, d31, state->fd, GMP_RNDN);
+  /* q33 = (d32 - q22) fa / (fe - fa), stored in d21 */
+  mpfr_sub(den, state->fe, state->fa, GMP_RNDN);
+  mpfr_sub(d21, d21, q11, GMP_RNDN);
+  mpfr_mul(d21, d21, state->fa, GMP_RNDN);
+  mpfr_div(d21, d21, den, GMP_RNDN);
+  /* c = a + q31 + q32 + q33 */
+  mpfr_add(state->c, q31, q21, GMP_RNDN);
+  mpfr_add(state->c, state->c, d21, GMP_RNDN);
+  mpfr_add(state->c, state->c, a, GMP_RNDN);
+  if (! toms748_is_inside(state, a, b))
+    toms748_quadratic(state, a, b, count);
+}
+static void
+toms748_double_secant (toms748_state_t * state, mpfr_srcptr a, mpfr_srcptr b)
+/* From the bound U with the least residual: c = u - 2 fu (b - a) / (fb -
+   fa), or the midpoint if this is farther than half the bracket. */
+{
+  int		use_a = (mpfr_cmpabs(state->fa, state->fb) < 0);
+  mpfr_srcptr	u  = (use_a)? a : b;
+  mpfr_srcptr	fu = (use_a)? state->fa : state->fb;
+  mpfr_sub(state->den, state->fb, state->fa, GMP_RNDN);
+  mpfr_sub(state->q11, b, a, GMP_RNDN);
+  mpfr_mul(state->q21, state->q11, fu, GMP_RNDN);
+  mpfr_div(state->q21, state->q21, state->den, GMP_RNDN);
+  mpfr_mul_2ui(state->q21, state->q21, 1, GMP_RNDN);
+  mpfr_sub(state->c, u, state->q21, GMP_RNDN);
+  mpfr_div_2ui(state->q11, state->q11, 1, GMP_RNDN);
+  if ((mpfr_cmpabs(state->q21, state->q11) > 0) || (! toms748_is_inside(state, a, b)))
+    toms748_midpoint(state, a, b);
+}
+
+
+/** --------------------------------------------------------------------
+ ** TOMS 748 root bracketing driver: functions.
+ ** ----------------------------------------------------------------- */
+
+static mp_odrf_code_t
+toms748_set (void * driver_state, mp_odrf_mpfr_function_t * f,
+	     mpfr_ptr root, mpfr_ptr x_lower, mpfr_ptr x_upper)
+/* This is equal to "bisection_set()". */
+{
+  mp_odrf_code_t	retval = MP_ODRF_OK;
+  toms748_state_t *	state  = driver_state;
+  int			clo, cup;
+  /* root = (x_lower + x_upper) / 2 */
+  mpfr_add(root, x_lower, x_upper, GMP_RNDN);
+  mpfr_div_2ui(root, root, 1, GMP_RNDN);
+  state->phase = TOMS748_SECANT;
+  SAFE_FUNC_CALL(retval, f, x_lower, state->fa, MP_ODRF_HINT_MIN_BITS);
+  if (MP_ODRF_OK == retval) {
+    SAFE_FUNC_CALL(retval, f, x_upper, state->fb, MP_ODRF_HINT_MIN_BITS);
+    if (MP_ODRF_OK == retval) {
+      clo = mpfr_cmp_si(state->fa, 0);
+      cup = mpfr_cmp_si(state->fb, 0);
+      if (((clo < 0) && (cup < 0)) ||
+	  ((clo > 0) && (cup > 0))) {
+	retval = MP_ODRF_ERROR_ENDPOINTS_DO_NOT_STRADDLE;
+      }
+    }
+  }
+  return retval;
+}
+static mp_odrf_code_t
+toms748_bracket (toms748_state_t * state, mp_odrf_mpfr_function_t * f,
+		 mpfr_t root, mpfr_t a, mpfr_t b)
+/* Evaluate the function at "c" and replace  with it the bound having the
+   same sign; the replaced bound becomes "d". */
+{
+  mp_odrf_code_t	retval = MP_ODRF_OK;
+  mpfr_ptr		tol = state->den;
+  int			ca, cc;
+  if (! mp_odrf_clamp_inside(state->c, a, b, tol))
+    toms748_midpoint(state, a, b);
+  mpfr_sub(tol, b, a, GMP_RNDN);
+  SAFE_FUNC_CALL(retval, f, state->c, state->fc, mp_odrf_hint_bits(state->c, tol, state->fc));
+  if (MP_ODRF_OK != retval) {
+    return retval;
+  }
+  mpfr_set(root, state->c, GMP_RNDN);
+  if (mpfr_zero_p(state->fc)) {
+    /* The next iterations must not evaluate the function again. */
+    mpfr_set(a, state->c, GMP_RNDN);
+    mpfr_set(b, state->c, GMP_RNDN);
+    mpfr_set_si(state->fa, 0, GMP_RNDN);
+    return retval;
+  }
+  /* The limbs are swapped rather than copied: d = b; b = c; or d = a;
+     a = c; the old "d" is not needed anymore. */
+  ca = mpfr_cmp_si(state->fa, 0);
+  cc = mpfr_cmp_si(state->fc, 0);
+  if (((ca > 0) && (cc < 0)) ||
+      ((ca < 0) && (cc > 0))) {
+    mpfr_swap(state->d,  b);
+    mpfr_swap(state->fd, state->fb);
+    mpfr_swap(b,         state->c);
+    mpfr_swap(state->fb, state->fc);
+  } else {
+    mpfr_swap(state->d,  a);
+    mpfr_swap(state->fd, state->fa);
+    mpfr_swap(a,         state->c);
+    mpfr_swap(state->fa, state->fc);
+  }
+  return retval;
+}
+static mp_odrf_code_t
+toms748_iterate (void * driver_state, mp_odrf_mpfr_function_t * f,
+		 mpfr_t root, mpfr_t x_lower, mpfr_t x_upper)
+{
+  mp_odrf_code_t	retval	= MP_ODRF_OK;
+  toms748_state_t *	state	= driver_state;
+  if (mpfr_zero_p(state->fa)) {
+    mpfr_set(root,    x_lower, GMP_RNDN);
+    mpfr_set(x_upper, x_lower, GMP_RNDN);
+    return retval;
+  } else if (mpfr_zero_p(state->fb)) {
+    mpfr_set(root,    x_upper, GMP_RNDN);
+    mpfr_set(x_lower, x_upper, GMP_RNDN);
+    return retval;
+  }
+  if (mp_odrf_bracket_is_exhausted(state->c, x_lower, x_upper))
+    return mp_odrf_bracket_exhausted_root(root, x_lower, x_upper, state->fa, state->fb);
+  /* The bisection step is taken only if the last group did not halve the
+     bracket; else the next group starts right away.  "c" already holds
+     the midpoint. */
+  if (TOMS748_BISECTION == state->phase) {
+    mpfr_sub(state->den, x_upper, x_lower, GMP_RNDN);
+    mpfr_mul_2ui(state->den, state->den, 1, GMP_RNDN);
+    state->phase = TOMS748_INTERPOLATION_1;
+    if (mpfr_greaterequal_p(state->den, state->width0)) {
+      mpfr_set(state->e,  state->d,  GMP_RNDN);
+      mpfr_set(state->fe, state->fd, GMP_RNDN);
+      return toms748_bracket(state, f, root, x_lower, x_upper);
+    }
+  }
+  switch (state->phase) {
+  case TOMS748_SECANT:
+    toms748_secant(state, x_lower, x_upper);
+    state->phase = TOMS748_QUADRATIC;
+    break;
+  case TOMS748_QUADRATIC:
+    toms748_quadratic(state, x_lower, x_upper, 2);
+    mpfr_set(state->e,  state->d,  GMP_RNDN);
+    mpfr_set(state->fe, state->fd, GMP_RNDN);
+    state->phase = TOMS748_INTERPOLATION_1;
+    break;
+  case TOMS748_INTERPOLATION_1:
+    mpfr_sub(state->width0, x_upper, x_lower, GMP_RNDN);
+    toms748_cubic(state, x_lower, x_upper, 2);
+    mpfr_set(state->e,  state->d,  GMP_RNDN);
+    mpfr_set(state->fe, state->fd, GMP_RNDN);
+    state->phase = TOMS748_INTERPOLATION_2;
+    break;
+  case TOMS748_INTERPOLATION_2:
+    toms748_cubic(state, x_lower, x_upper, 3);
+    state->phase = TOMS748_DOUBLE_SECANT;
+    break;
+  case TOMS748_DOUBLE_SECANT:
+  default:
+    toms748_double_secant(state, x_lower, x_upper);
+    mpfr_set(state->e,  state->d,  GMP_RNDN);
+    mpfr_set(state->fe, state->fd, GMP_RNDN);
+    state->phase = TOMS748_BISECTION;
+    break;
+  }
+  return toms748_bracket(state, f, root, x_lower, x_upper);
+}
+
+
+/** --------------------------------------------------------------------
+ ** TOMS 748 root bracketing driver: struct definition.
+ ** ----------------------------------------------------------------- */
+
+static const mp_odrf_mpfr_root_fsolver_driver_t toms748_driver = {
+  .name			= "toms748",
+  .driver_state_size	= sizeof(toms748_state_t),
+  .driver_state_mpfr_count = offsetof(toms748_state_t, phase) / sizeof(mpfr_t),
+  .driver_state_ordinate_count = offsetof(toms748_state_t, c) / sizeof(mpfr_t),
+  .init			= NULL,
+  .final		= NULL,
+  .set			= toms748_set,
+  .iterate		= toms748_iterate
+};
+
+const mp_odrf_mpfr_root_fsolver_driver_t * mp_odrf_mpfr_root_fsolver_toms748 = &toms748_driver;
+
+/* end of file */
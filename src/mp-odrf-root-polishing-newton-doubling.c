@@ -0,0 +1,152 @@
+/*
+   Part of: Multiple Precision One Dimensional Root Finding
+   Contents: root polishing newton algorithm with precision doubling
+   Date: Fri Oct 16, 2026
+
+   Abstract
+
+	This module implements a variant of  the newton root polishing
+	algorithm driver  which starts at double  precision and doubles
+	the working precision  as the iterations converge, up  to the
+	precision of the solver.
+
+	Newton's method doubles the number of correct bits at each step,
+	so a step only needs twice the precision of the estimate it starts
+	from: the cost of the whole solve is  about twice the cost of one
+	evaluation at the precision of the solver.
+
+   Copyright (c) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+   This program is free software:  you can redistribute it and/or modify
+   it under the terms of the  GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at
+   your option) any later version.
+
+   This program is  distributed in the hope that it  will be useful, but
+   WITHOUT  ANY   WARRANTY;  without   even  the  implied   warranty  of
+   MERCHANTABILITY  or FITNESS FOR  A PARTICULAR  PURPOSE.  See  the GNU
+   General Public License for more details.
+
+   You should  have received  a copy of  the GNU General  Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#include "mp-odrf-internals.h"
+
+/* The starting working precision: the one of IEEE 754 doubles. */
+#define START_PREC	53
+
+/* All the numbers are allocated with the precision of the solver, which
+   is the  one of the root;  their precision is lowered  and raised within
+   it, so the limbs are never reallocated. */
+typedef struct {
+  mpfr_t	f, df;
+  /* The current estimate at the working precision. */
+  mpfr_t	x;
+  /* Scratch variable for "newton_doubling_iterate()". */
+  mpfr_t	delta;
+  mp_prec_t	working_prec;
+  /* The layout flags of the solver. */
+  unsigned	flags;
+} newton_doubling_state_t;
+
+
+/** --------------------------------------------------------------------
+ ** Newton doubling root polishing driver: functions.
+ ** ----------------------------------------------------------------- */
+
+static void
+newton_doubling_init (void * driver_state, unsigned flags)
+{
+  newton_doubling_state_t *	state = driver_state;
+  state->flags = flags;
+}
+static void
+set_function_prec (newton_doubling_state_t * state, mp_prec_t prec)
+/* Reinitialise the function values and the scratch variable to PREC. */
+{
+  mp_odrf_mpfr_state_set_prec(state->f,     prec, state->flags);
+  mp_odrf_mpfr_state_set_prec(state->df,    prec, state->flags);
+  mp_odrf_mpfr_state_set_prec(state->delta, prec, state->flags);
+}
+static mp_odrf_code_t
+newton_doubling_set (void * driver_state,
+		     mp_odrf_mpfr_function_fdf_t * FDF,
+		     mpfr_ptr initial_guess)
+{
+  newton_doubling_state_t *	state	= driver_state;
+  mp_prec_t			prec	= mpfr_get_prec(initial_guess);
+  if (prec > START_PREC)
+    prec = START_PREC;
+  state->working_prec = prec;
+  mp_odrf_mpfr_state_set_prec(state->x, prec, state->flags);
+  mpfr_set(state->x, initial_guess, GMP_RNDN);
+  set_function_prec(state, prec);
+  return MP_ODRF_MPFR_FN_FDF_EVAL_F_DF(FDF, state->df, state->f, state->x);
+}
+static mp_odrf_code_t
+newton_doubling_iterate (void * driver_state,
+			 mp_odrf_mpfr_function_fdf_t * FDF,
+			 mpfr_ptr root)
+{
+  mp_odrf_code_t		retval	= MP_ODRF_OK;
+  newton_doubling_state_t *	state	= driver_state;
+  mp_prec_t			prec	= state->working_prec;
+  mp_prec_t			final	= mpfr_get_prec(root);
+  mp_prec_t			bits;
+  if (mpfr_zero_p(state->df)) {
+    retval = MP_ODRF_ERROR_DERIVATIVE_IS_ZERO;
+  } else {
+    mpfr_div(state->delta, state->f, state->df, GMP_RNDN);
+    /* When the step  is below the square root  of the relative spacing
+       at the working  precision, the new estimate is  correct to about
+       the full working precision: the next step needs twice as much.
+       Before that we are not in the quadratic regime yet. */
+    if ((prec < final) &&
+	(mpfr_zero_p(state->delta) ||
+	 ((! mpfr_zero_p(state->x)) &&
+	  (mpfr_get_exp(state->delta) <= mpfr_get_exp(state->x) - (mp_exp_t)(prec / 2))))) {
+      prec = (prec < final / 2)? 2 * prec : final;
+      state->working_prec = prec;
+      mp_odrf_mpfr_state_raise_prec(state->x, prec, state->flags);
+    }
+    mpfr_sub(state->x, state->x, state->delta, GMP_RNDN);
+    mpfr_set(root, state->x, GMP_RNDN);
+    /* The hint  needs the step, which "set_function_prec()"  resets; X is
+       already at the new working precision, so it caps the bits. */
+    bits = mp_odrf_hint_bits(state->x, state->delta, state->x);
+    set_function_prec(state, prec);
+    retval = MP_ODRF_MPFR_FN_FDF_EVAL_F_DF_HINTED(FDF, state->df, state->f, state->x, bits);
+    if (MP_ODRF_OK == retval) {
+      if ((!mpfr_number_p(state->f)) || (!mpfr_number_p(state->df))) {
+	retval = MP_ODRF_ERROR_FUNCTION_OR_DERIVATIVE_VALUE_INVALID;
+      }
+    }
+  }
+  return retval;
+}
+
+
+/** --------------------------------------------------------------------
+ ** Newton doubling root polishing driver: struct definition.
+ ** ----------------------------------------------------------------- */
+
+static const mp_odrf_mpfr_root_fdfsolver_driver_t newton_doubling_driver = {
+  .name			= "newton-doubling",
+  .driver_state_size	= sizeof(newton_doubling_state_t),
+  .driver_state_mpfr_count = offsetof(newton_doubling_state_t, working_prec) / sizeof(mpfr_t),
+  .init			= newton_doubling_init,
+  .final		= NULL,
+  .set			= newton_doubling_set,
+  .iterate		= newton_doubling_iterate
+};
+
+const mp_odrf_mpfr_root_fdfsolver_driver_t * \
+  mp_odrf_mpfr_root_fdfsolver_newton_doubling = &newton_doubling_driver;
+
+/* end of file */
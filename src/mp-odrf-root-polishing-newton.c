@@ -34,6 +34,8 @@
 
 typedef struct {
   mpfr_t	f, df;
+  /* Scratch variable for "newton_iterate()". */
+  mpfr_t	delta;
 } newton_state_t;
 
 
@@ -41,20 +43,6 @@ typedef struct {
  ** Bisection root bracketing driver: functions.
  ** ----------------------------------------------------------------- */
 
-static void
-newton_init (void * driver_state)
-{
-  newton_state_t *	state = driver_state;
-  mpfr_init(state->f);
-  mpfr_init(state->df);
-}
-static void
-newton_final (void * driver_state)
-{
-  newton_state_t *	state = driver_state;
-  mpfr_clear(state->f);
-  mpfr_clear(state->df);
-}
 mp_odrf_code_t
 newton_set (void * driver_state,
 	    mp_odrf_mpfr_function_fdf_t * FDF,
@@ -70,26 +58,19 @@ newton_iterate (void * driver_state,
 {
   mp_odrf_code_t	retval	= MP_ODRF_OK;
   newton_state_t *	state	= driver_state;
-  mpfr_t		tmp1, tmp2;
-  mpfr_init(tmp1);
-  mpfr_init(tmp2);
-  {
-    if (mpfr_zero_p(state->df)) {
-      retval = MP_ODRF_ERROR_DERIVATIVE_IS_ZERO;
-    } else {
-      mpfr_div(tmp1, state->f, state->df, GMP_RNDN);
-      mpfr_sub(tmp2, root, tmp1, GMP_RNDN);
-      mpfr_set(root, tmp2, GMP_RNDN);
-      retval = MP_ODRF_MPFR_FN_FDF_EVAL_F_DF(FDF, state->df, state->f, root);
-      if (MP_ODRF_OK == retval) {
-	if ((!mpfr_number_p(state->f)) || (!mpfr_number_p(state->df))) {
-	  retval = MP_ODRF_ERROR_FUNCTION_OR_DERIVATIVE_VALUE_INVALID;
-	}
+  if (mpfr_zero_p(state->df)) {
+    retval = MP_ODRF_ERROR_DERIVATIVE_IS_ZERO;
+  } else {
+    mpfr_div(state->delta, state->f, state->df, GMP_RNDN);
+    mpfr_sub(root, root, state->delta, GMP_RNDN);
+    retval = MP_ODRF_MPFR_FN_FDF_EVAL_F_DF_HINTED(FDF, state->df, state->f, root,
+						  mp_odrf_hint_bits(root, state->delta, state->f));
+    if (MP_ODRF_OK == retval) {
+      if ((!mpfr_number_p(state->f)) || (!mpfr_number_p(state->df))) {
+	retval = MP_ODRF_ERROR_FUNCTION_OR_DERIVATIVE_VALUE_INVALID;
       }
     }
   }
-  mpfr_clear(tmp1);
-  mpfr_clear(tmp2);
   return retval;
 }
 
@@ -101,8 +82,9 @@ newton_iterate (void * driver_state,
 static const mp_odrf_mpfr_root_fdfsolver_driver_t newton_driver = {
   .name			= "newton",
   .driver_state_size	= sizeof(newton_state_t),
-  .init			= newton_init,
-  .final		= newton_final,
+  .driver_state_mpfr_count = sizeof(newton_state_t) / sizeof(mpfr_t),
+  .init			= NULL,
+  .final		= NULL,
   .set			= newton_set,
   .iterate		= newton_iterate
 };
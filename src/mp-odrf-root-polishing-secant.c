@@ -34,6 +34,9 @@
 
 typedef struct {
   mpfr_t	f, df;
+  /* Scratch variables for "secant_iterate()". */
+  mpfr_t	F_new, X_new;
+  mpfr_t	deltaF, deltaX;
 } secant_state_t;
 
 
@@ -41,20 +44,6 @@ typedef struct {
  ** Bisection root bracketing driver: functions.
  ** ----------------------------------------------------------------- */
 
-static void
-secant_init (void * driver_state)
-{
-  secant_state_t *	state = driver_state;
-  mpfr_init(state->f);
-  mpfr_init(state->df);
-}
-static void
-secant_final (void * driver_state)
-{
-  secant_state_t *	state = driver_state;
-  mpfr_clear(state->f);
-  mpfr_clear(state->df);
-}
 mp_odrf_code_t
 secant_set (void * driver_state,
 	    mp_odrf_mpfr_function_fdf_t * FDF,
@@ -72,41 +61,37 @@ secant_iterate (void * driver_state,
   if (mpfr_zero_p(state->df)) {
     retval = MP_ODRF_ERROR_DERIVATIVE_IS_ZERO;
   } else {
-    mpfr_t	F_new, DF_new, X_new;
-    mpfr_t	deltaF, deltaX;
-    mpfr_init(deltaF);
-    mpfr_init(deltaX);
-    mpfr_init(X_new);
-    mpfr_init(F_new);
-    mpfr_init(DF_new);
-    {
-      mpfr_div(deltaF, state->f, state->df, GMP_RNDN);
-      mpfr_sub(X_new, root, deltaF, GMP_RNDN);
-      /* F_new = F(X_new) */
-      retval = MP_ODRF_MPFR_FN_FDF_EVAL_F(FDF, F_new, X_new);
-      if (MP_ODRF_OK == retval) {
-	/* Compute the incremental ratio of F. */
-	{
-	  /* deltaF = F_new - state->f */
-	  mpfr_sub(deltaF, F_new, state->f, GMP_RNDN);
-	  /* deltaX = X_new - root */
-	  mpfr_sub(deltaX, X_new, root, GMP_RNDN);
-	  /* DF_new = deltaF / deltaX */
-	  mpfr_div(DF_new, deltaF, deltaX, GMP_RNDN);
-	}
-	mpfr_set(root,       X_new, GMP_RNDN);
-	mpfr_set(state->f,   F_new, GMP_RNDN);
-	mpfr_set(state->df, DF_new, GMP_RNDN);
-	if ((!mpfr_number_p(F_new)) || (!mpfr_number_p(DF_new))) {
-	  retval = MP_ODRF_ERROR_FUNCTION_OR_DERIVATIVE_VALUE_INVALID;
-	}
+    mpfr_ptr	F_new	= state->F_new;
+    mpfr_ptr	X_new	= state->X_new;
+    mpfr_ptr	deltaF	= state->deltaF;
+    mpfr_ptr	deltaX	= state->deltaX;
+    mpfr_div(deltaF, state->f, state->df, GMP_RNDN);
+    mpfr_sub(X_new, root, deltaF, GMP_RNDN);
+    /* F_new = F(X_new) */
+    retval = MP_ODRF_MPFR_FN_FDF_EVAL_F_HINTED(FDF, F_new, X_new,
+					       mp_odrf_hint_bits(X_new, deltaF, F_new));
+    if (MP_ODRF_OK == retval) {
+      /* Compute the incremental ratio of F. */
+      {
+	/* deltaF = F_new - state->f */
+	mpfr_sub(deltaF, F_new, state->f, GMP_RNDN);
+	/* deltaX = X_new - root */
+	mpfr_sub(deltaX, X_new, root, GMP_RNDN);
+	/* The old  derivative is not needed anymore: store the new one
+	   directly in the state.  When the step is below the resolution of
+	   the root the estimate does not move and the ratio would be 0/0:
+	   we keep the old derivative. */
+	if (! mpfr_zero_p(deltaX))
+	  mpfr_div(state->df, deltaF, deltaX, GMP_RNDN);
+      }
+      /* Swap the  limbs rather than copying them:  the scratch variables
+	 receive the old values, which are garbage from now on. */
+      mpfr_swap(root,     X_new);
+      mpfr_swap(state->f, F_new);
+      if ((!mpfr_number_p(state->f)) || (!mpfr_number_p(state->df))) {
+	retval = MP_ODRF_ERROR_FUNCTION_OR_DERIVATIVE_VALUE_INVALID;
       }
     }
-    mpfr_clear(deltaF);
-    mpfr_clear(deltaX);
-    mpfr_clear(X_new);
-    mpfr_clear(F_new);
-    mpfr_clear(DF_new);
   }
   return retval;
 }
@@ -119,8 +104,9 @@ secant_iterate (void * driver_state,
 static const mp_odrf_mpfr_root_fdfsolver_driver_t secant_driver = {
   .name			= "secant",
   .driver_state_size	= sizeof(secant_state_t),
-  .init			= secant_init,
-  .final		= secant_final,
+  .driver_state_mpfr_count = sizeof(secant_state_t) / sizeof(mpfr_t),
+  .init			= NULL,
+  .final		= NULL,
   .set			= secant_set,
   .iterate		= secant_iterate
 };
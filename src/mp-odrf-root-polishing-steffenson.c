@@ -37,6 +37,10 @@ typedef struct {
   mpfr_t	x;
   mpfr_t	x_1;
   mpfr_t	x_2;
+  /* Scratch variables for "steffenson_iterate()". */
+  mpfr_t	X_new, F_new, DF_new;
+  mpfr_t	u, v;
+  mpfr_t	tmp1, tmp2;
   int		count;
 } steffenson_state_t;
 
@@ -45,26 +49,6 @@ typedef struct {
  ** Bisection root bracketing driver: functions.
  ** ----------------------------------------------------------------- */
 
-static void
-steffenson_init (void * driver_state)
-{
-  steffenson_state_t *	state = driver_state;
-  mpfr_init(state->f);
-  mpfr_init(state->df);
-  mpfr_init(state->x);
-  mpfr_init(state->x_1);
-  mpfr_init(state->x_2);
-}
-static void
-steffenson_final (void * driver_state)
-{
-  steffenson_state_t *	state = driver_state;
-  mpfr_clear(state->f);
-  mpfr_clear(state->df);
-  mpfr_clear(state->x);
-  mpfr_clear(state->x_1);
-  mpfr_clear(state->x_2);
-}
 mp_odrf_code_t
 steffenson_set (void * driver_state,
 		mp_odrf_mpfr_function_fdf_t * FDF, mpfr_ptr initial_guess)
@@ -92,60 +76,54 @@ steffenson_iterate (void * driver_state,
   if (mpfr_zero_p(state->df)) {
     retval = MP_ODRF_ERROR_DERIVATIVE_IS_ZERO;
   } else {
-    mpfr_t	X_new, F_new, DF_new;
-    mpfr_t	tmp1, tmp2;
-    mpfr_init(X_new);
-    mpfr_init(F_new);
-    mpfr_init(DF_new);
-    mpfr_init(tmp1);
-    mpfr_init(tmp2);
-    {
-      mpfr_div(tmp1, state->f, state->df, GMP_RNDN);
-      mpfr_sub(X_new, state->x, tmp1, GMP_RNDN);
-      retval = MP_ODRF_MPFR_FN_FDF_EVAL_F_DF(FDF, DF_new, F_new, X_new);
-      if (MP_ODRF_OK == retval) {
-	mpfr_set(state->x_2, state->x_1, GMP_RNDN);
-	mpfr_set(state->x_1, state->x,   GMP_RNDN);
-	mpfr_set(state->x,   X_new,      GMP_RNDN);
-	mpfr_set(state->f,   F_new,      GMP_RNDN);
-	mpfr_set(state->df,  DF_new,     GMP_RNDN);
-	if (!mpfr_number_p(F_new)) {
-	  retval = MP_ODRF_ERROR_FUNCTION_OR_DERIVATIVE_VALUE_INVALID;
+    mpfr_ptr	X_new	= state->X_new;
+    mpfr_ptr	F_new	= state->F_new;
+    mpfr_ptr	DF_new	= state->DF_new;
+    mpfr_ptr	tmp1	= state->tmp1;
+    mpfr_ptr	tmp2	= state->tmp2;
+    mpfr_div(tmp1, state->f, state->df, GMP_RNDN);
+    mpfr_sub(X_new, state->x, tmp1, GMP_RNDN);
+    retval = MP_ODRF_MPFR_FN_FDF_EVAL_F_DF_HINTED(FDF, DF_new, F_new, X_new,
+						  mp_odrf_hint_bits(X_new, tmp1, F_new));
+    if (MP_ODRF_OK == retval) {
+      /* Shift the history: x_2 <- x_1 <- x <- X_new.  The values are
+	 rotated by swapping the limbs, so the scratch variables receive
+	 the discarded ones; from now on the new values must be read from
+	 the state. */
+      mpfr_swap(state->x_2, state->x_1);
+      mpfr_swap(state->x_1, state->x);
+      mpfr_swap(state->x,   X_new);
+      mpfr_swap(state->f,   F_new);
+      mpfr_swap(state->df,  DF_new);
+      X_new  = state->x;
+      F_new  = state->f;
+      DF_new = state->df;
+      if (!mpfr_number_p(F_new)) {
+	retval = MP_ODRF_ERROR_FUNCTION_OR_DERIVATIVE_VALUE_INVALID;
+      } else {
+	if (state->count < 3) {
+	  mpfr_set(root, X_new, GMP_RNDN);
+	  state->count++;
 	} else {
-	  if (state->count < 3) {
-	    mpfr_set(root, X_new, GMP_RNDN);
-	    state->count++;
-	  } else {
-	    mpfr_t	u, v;
-	    mpfr_init(u);
-	    mpfr_init(v);
-	    {
-	      mpfr_sub(u, state->x, state->x_1, GMP_RNDN);
-	      mpfr_mul_si(tmp1, state->x, 2, GMP_RNDN);
-	      mpfr_sub(tmp2, X_new, tmp1, GMP_RNDN);
-	      mpfr_add(v, tmp2, state->x_1, GMP_RNDN);
-	      if (mpfr_zero_p(v))
-		mpfr_set(root, X_new, GMP_RNDN);  /* avoid division by zero */
-	      else {
-		mpfr_div(tmp1, u, v, GMP_RNDN);
-		mpfr_mul(tmp2, u, tmp1, GMP_RNDN);
-		mpfr_sub(root, state->x_1, tmp2, GMP_RNDN);  /* accelerated value */
-	      }
-	    }
-	    mpfr_clear(u);
-	    mpfr_clear(v);
-	  }
-	  if (!mpfr_number_p(DF_new)) {
-	    retval = MP_ODRF_ERROR_FUNCTION_OR_DERIVATIVE_VALUE_INVALID;
+	  mpfr_ptr	u = state->u;
+	  mpfr_ptr	v = state->v;
+	  mpfr_sub(u, state->x, state->x_1, GMP_RNDN);
+	  mpfr_mul_2ui(tmp1, state->x, 1, GMP_RNDN);
+	  mpfr_sub(tmp2, X_new, tmp1, GMP_RNDN);
+	  mpfr_add(v, tmp2, state->x_1, GMP_RNDN);
+	  if (mpfr_zero_p(v))
+	    mpfr_set(root, X_new, GMP_RNDN);  /* avoid division by zero */
+	  else {
+	    mpfr_div(tmp1, u, v, GMP_RNDN);
+	    mpfr_mul(tmp2, u, tmp1, GMP_RNDN);
+	    mpfr_sub(root, state->x_1, tmp2, GMP_RNDN);  /* accelerated value */
 	  }
 	}
+	if (!mpfr_number_p(DF_new)) {
+	  retval = MP_ODRF_ERROR_FUNCTION_OR_DERIVATIVE_VALUE_INVALID;
+	}
       }
     }
-    mpfr_clear(X_new);
-    mpfr_clear(F_new);
-    mpfr_clear(DF_new);
-    mpfr_clear(tmp1);
-    mpfr_clear(tmp2);
   }
   return retval;
 }
@@ -158,8 +136,9 @@ steffenson_iterate (void * driver_state,
 static const mp_odrf_mpfr_root_fdfsolver_driver_t steffenson_driver = {
   .name			= "steffenson",
   .driver_state_size	= sizeof(steffenson_state_t),
-  .init			= steffenson_init,
-  .final		= steffenson_final,
+  .driver_state_mpfr_count = offsetof(steffenson_state_t, count) / sizeof(mpfr_t),
+  .init			= NULL,
+  .final		= NULL,
   .set			= steffenson_set,
   .iterate		= steffenson_iterate
 };
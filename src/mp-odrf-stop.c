@@ -0,0 +1,384 @@
+/*
+  Part of: Multiple Precision One-Dimensional Root-Finding
+  Contents: convergence tests and stop criteria
+  Date: Fri Oct 16, 2026
+
+  Abstract
+
+	This module implements the convergence tests.  The stop criterion
+	objects  are built  once  and  own their  scratch  storage, so
+	testing a solver at every iteration performs no allocation.
+
+	Tolerances are  compared  with  directed  rounding:  the  width  of
+	intervals is  rounded up and tolerances  are rounded down, so the
+	scratch numbers can  have low precision even when  the abscissae
+	have  thousands of  bits; whenever the  exponents of  the operands
+	settle the answer no arithmetic is performed at all.
+
+  Copyright (C) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+  Copyright (C) 1996, 1997, 1998, 1999, 2000, 2007 Reid Priedhorsky,
+  Brian Gough.
+
+  This program is  free software: you can redistribute  it and/or modify
+  it under the  terms of the GNU General Public  License as published by
+  the Free Software Foundation, either version  3 of the License, or (at
+  your option) any later version.
+
+  This program  is distributed in the  hope that it will  be useful, but
+  WITHOUT   ANY  WARRANTY;   without  even   the  implied   warranty  of
+  MERCHANTABILITY  or FITNESS  FOR A  PARTICULAR PURPOSE.   See the  GNU
+  General Public License for more details.
+
+  You should  have received  a copy  of the  GNU General  Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#include "mp-odrf-internals.h"
+
+/* Precision of the scratch numbers used to compare widths and tolerances. */
+#define SCRATCH_PREC		64
+
+
+/** --------------------------------------------------------------------
+ ** Helpers: tests.
+ ** ----------------------------------------------------------------- */
+
+static mp_odrf_code_t
+check_tolerances (mpfr_srcptr epsabs, mpfr_srcptr epsrel)
+{
+  if (epsrel && (mpfr_sgn(epsrel) < 0))
+    return MP_ODRF_ERROR_RELATIVE_TOLERANCE_IS_NEGATIVE;
+  else if (mpfr_sgn(epsabs) < 0)
+    return MP_ODRF_ERROR_ABSOLUTE_TOLERANCE_IS_NEGATIVE;
+  else
+    return MP_ODRF_OK;
+}
+static mpfr_exp_t
+max_exp (mpfr_srcptr a, mpfr_srcptr b)
+/* Return  the largest exponent  of the  non-zero  numbers among A and
+   B; both must be finite and at least one of them must be non-zero. */
+{
+  if (mpfr_zero_p(a))
+    return mpfr_get_exp(b);
+  else if (mpfr_zero_p(b))
+    return mpfr_get_exp(a);
+  else {
+    mpfr_exp_t	ea = mpfr_get_exp(a);
+    mpfr_exp_t	eb = mpfr_get_exp(b);
+    return (ea > eb)? ea : eb;
+  }
+}
+static mp_odrf_code_t
+interval_test (mpfr_srcptr x_lower, mpfr_srcptr x_upper,
+	       mpfr_srcptr epsabs,  mpfr_srcptr epsrel,
+	       mpfr_ptr width, mpfr_ptr tolerance)
+/* Test:
+
+     |x_upper - x_lower| < epsabs + epsrel * min(|x_lower|, |x_upper|)
+
+   where the minimum is  zero when the interval straddles zero.  WIDTH and
+   TOLERANCE are scratch numbers.  The exponents are compared only when
+   the numbers are finite; a NaN never passes the test. */
+{
+  int	slo, sup;
+  if (mpfr_nan_p(x_lower) || mpfr_nan_p(x_upper))
+    return MP_ODRF_CONTINUE;
+  slo = mpfr_sgn(x_lower);
+  sup = mpfr_sgn(x_upper);
+  if ((slo <= 0) && (0 <= sup)) {
+    /* The  tolerance is EPSABS and,  with M = max(|x_lower|, |x_upper|),
+       we have M <= width <= 2 M. */
+    if (mpfr_zero_p(epsabs))
+      return MP_ODRF_CONTINUE;
+    else if ((0 == slo) && (0 == sup))
+      return MP_ODRF_OK;
+    else {
+      if (mpfr_number_p(x_lower) && mpfr_number_p(x_upper) && mpfr_regular_p(epsabs)) {
+	mpfr_exp_t	e = max_exp(x_lower, x_upper);
+	mpfr_exp_t	E = mpfr_get_exp(epsabs);
+	if (e + 1 <= E - 1)
+	  return MP_ODRF_OK;		/* width < 2^(e+1) <= epsabs */
+	else if (e - 1 >= E)
+	  return MP_ODRF_CONTINUE;	/* width >= 2^(e-1) > epsabs */
+      }
+      mpfr_set(tolerance, epsabs, GMP_RNDD);
+    }
+  } else {
+    mpfr_srcptr	min_abs = (0 < mpfr_cmpabs(x_lower, x_upper))? x_upper : x_lower;
+    mpfr_abs(tolerance, min_abs, GMP_RNDD);
+    if (epsrel)
+      mpfr_mul(tolerance, tolerance, epsrel, GMP_RNDD);
+    else
+      mpfr_set_si(tolerance, 0, GMP_RNDN);
+    mpfr_add(tolerance, tolerance, epsabs, GMP_RNDD);
+  }
+  mpfr_sub(width, x_upper, x_lower, GMP_RNDU);
+  return (mpfr_less_p(width, tolerance))? MP_ODRF_OK : MP_ODRF_CONTINUE;
+}
+static mp_odrf_code_t
+delta_test (mpfr_srcptr x1, mpfr_srcptr x0,
+	    mpfr_srcptr epsabs, mpfr_srcptr epsrel,
+	    mpfr_ptr delta, mpfr_ptr tolerance)
+/* Test:
+
+     |x1 - x0| < epsabs + epsrel * |x1|
+
+   DELTA and  TOLERANCE are scratch numbers.  The exponents are compared
+   only when the numbers are finite; a NaN never passes the test. */
+{
+  if (mpfr_nan_p(x1) || mpfr_nan_p(x0))
+    return MP_ODRF_CONTINUE;
+  if (mpfr_equal_p(x1, x0))
+    return MP_ODRF_OK;
+  if ((mpfr_sgn(x1) * mpfr_sgn(x0) < 0) &&
+      mpfr_number_p(x1) && mpfr_number_p(x0) && mpfr_number_p(epsabs) &&
+      ((! epsrel) || mpfr_number_p(epsrel))) {
+    /* With opposite signs |x1 - x0| >= max(|x1|, |x0|) >= 2^(e-1), while
+       the tolerance is below 2^(max(Ea, Er + e1) + 1). */
+    mpfr_exp_t	e  = max_exp(x1, x0);
+    mpfr_exp_t	Ea = mpfr_zero_p(epsabs)? mpfr_get_emin() : mpfr_get_exp(epsabs);
+    mpfr_exp_t	Er = (!epsrel || mpfr_zero_p(epsrel))? mpfr_get_emin() :
+      (mpfr_get_exp(epsrel) + mpfr_get_exp(x1));
+    mpfr_exp_t	Et = ((Ea > Er)? Ea : Er) + 1;
+    if (e - 1 >= Et)
+      return MP_ODRF_CONTINUE;
+  }
+  mpfr_abs(tolerance, x1, GMP_RNDD);
+  if (epsrel)
+    mpfr_mul(tolerance, tolerance, epsrel, GMP_RNDD);
+  else
+    mpfr_set_si(tolerance, 0, GMP_RNDN);
+  mpfr_add(tolerance, tolerance, epsabs, GMP_RNDD);
+  mpfr_sub(delta, x1, x0, (mpfr_greater_p(x1, x0))? GMP_RNDU : GMP_RNDD);
+  return (0 > mpfr_cmpabs(delta, tolerance))? MP_ODRF_OK : MP_ODRF_CONTINUE;
+}
+static mp_odrf_code_t
+residual_test (mpfr_srcptr f, mpfr_srcptr epsabs)
+/* Test: |f| < epsabs.  A NaN never passes the test. */
+{
+  if (mpfr_nan_p(f) || mpfr_nan_p(epsabs))
+    return MP_ODRF_CONTINUE;
+  else if (mpfr_zero_p(f))
+    return (mpfr_zero_p(epsabs))? MP_ODRF_CONTINUE : MP_ODRF_OK;
+  else if (mpfr_zero_p(epsabs))
+    return MP_ODRF_CONTINUE;
+  else if (mpfr_inf_p(f) || mpfr_inf_p(epsabs))
+    return (0 > mpfr_cmpabs(f, epsabs))? MP_ODRF_OK : MP_ODRF_CONTINUE;
+  else {
+    mpfr_exp_t	ef = mpfr_get_exp(f);
+    mpfr_exp_t	E  = mpfr_get_exp(epsabs);
+    if (ef < E)
+      return MP_ODRF_OK;		/* |f| < 2^ef <= 2^(E-1) <= epsabs */
+    else if (ef > E)
+      return MP_ODRF_CONTINUE;		/* |f| >= 2^(ef-1) >= 2^E > epsabs */
+    else
+      return (0 > mpfr_cmpabs(f, epsabs))? MP_ODRF_OK : MP_ODRF_CONTINUE;
+  }
+}
+
+
+/** --------------------------------------------------------------------
+ ** Convergence tests API.
+ ** ----------------------------------------------------------------- */
+
+mp_odrf_code_t
+mp_odrf_mpfr_root_test_interval (mpfr_ptr x_lower, mpfr_ptr x_upper,
+				 mpfr_ptr epsabs,  mpfr_ptr epsrel)
+{
+  mp_odrf_code_t	retval = check_tolerances(epsabs, epsrel);
+  if (MP_ODRF_OK != retval) {
+    ;
+  } else if (mpfr_greater_p(x_lower, x_upper)) {
+    retval	= MP_ODRF_ERROR_LOWER_BOUND_LARGER_THAN_UPPER_BOUND;
+  } else {
+    MPFR_DECL_INIT(width,     SCRATCH_PREC);
+    MPFR_DECL_INIT(tolerance, SCRATCH_PREC);
+    retval = interval_test(x_lower, x_upper, epsabs, epsrel, width, tolerance);
+  }
+  return retval;
+}
+mp_odrf_code_t
+mp_odrf_mpfr_root_test_delta (mpfr_ptr x1, mpfr_ptr x0,
+			      mpfr_ptr epsabs, mpfr_ptr epsrel)
+{
+  mp_odrf_code_t	retval = check_tolerances(epsabs, epsrel);
+  if (MP_ODRF_OK == retval) {
+    MPFR_DECL_INIT(delta,     SCRATCH_PREC);
+    MPFR_DECL_INIT(tolerance, SCRATCH_PREC);
+    retval = delta_test(x1, x0, epsabs, epsrel, delta, tolerance);
+  }
+  return retval;
+}
+mp_odrf_code_t
+mp_odrf_mpfr_root_test_residual (mpfr_ptr f, mpfr_ptr epsabs)
+{
+  mp_odrf_code_t	retval = check_tolerances(epsabs, NULL);
+  if (MP_ODRF_OK == retval)
+    retval = residual_test(f, epsabs);
+  return retval;
+}
+
+
+/** --------------------------------------------------------------------
+ ** Stop criteria: construction.
+ ** ----------------------------------------------------------------- */
+
+mp_odrf_code_t
+mp_odrf_stop_init (mp_odrf_stop_t * C, mp_odrf_stop_kind_t kind,
+		   mpfr_srcptr epsabs, mpfr_srcptr epsrel,
+		   unsigned long max_iterations)
+/* Initialise C to test the selected criterion  with the given tolerances;
+   EPSREL can be NULL, meaning zero.  When MAX_ITERATIONS is not zero:
+   the search fails after that many iterations. */
+{
+  mp_odrf_code_t	retval = check_tolerances(epsabs, epsrel);
+  if (MP_ODRF_OK == retval) {
+    C->kind		= kind;
+    C->max_iterations	= max_iterations;
+    C->iterations	= 0;
+    mpfr_init2(C->epsabs, mpfr_get_prec(epsabs));
+    mpfr_set(C->epsabs, epsabs, GMP_RNDN);
+    if (epsrel) {
+      mpfr_init2(C->epsrel, mpfr_get_prec(epsrel));
+      mpfr_set(C->epsrel, epsrel, GMP_RNDN);
+    } else {
+      mpfr_init2(C->epsrel, MPFR_PREC_MIN);
+      mpfr_set_si(C->epsrel, 0, GMP_RNDN);
+    }
+    /* The precision  of these is  adjusted to the  one of the  solver's
+       root the first time they are used. */
+    mpfr_init2(C->previous, MPFR_PREC_MIN);
+    mpfr_init2(C->value,    MPFR_PREC_MIN);
+    mpfr_init2(C->tmp1, SCRATCH_PREC);
+    mpfr_init2(C->tmp2, SCRATCH_PREC);
+  }
+  return retval;
+}
+void
+mp_odrf_stop_clear (mp_odrf_stop_t * C)
+{
+  mpfr_clear(C->epsabs);
+  mpfr_clear(C->epsrel);
+  mpfr_clear(C->previous);
+  mpfr_clear(C->value);
+  mpfr_clear(C->tmp1);
+  mpfr_clear(C->tmp2);
+}
+void
+mp_odrf_stop_reset (mp_odrf_stop_t * C)
+/* Prepare C for a new search. */
+{
+  C->iterations = 0;
+  mpfr_set_nan(C->previous);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Stop criteria: testing.
+ ** ----------------------------------------------------------------- */
+
+static void
+adjust_prec (mpfr_ptr x, mpfr_srcptr root)
+/* Make the precision of X equal to the one of ROOT.  It allocates only
+   the first time a criterion is used with a given precision. */
+{
+  if (mpfr_get_prec(x) != mpfr_get_prec(root))
+    mpfr_set_prec(x, mpfr_get_prec(root));
+}
+static mp_odrf_code_t
+delta_step (mp_odrf_stop_t * C, mpfr_srcptr root)
+/* Compare ROOT with the root of the previous iteration and remember it.
+   In adaptive mode the working precision grows between iterations: the
+   previous root is rounded to it, else it would keep the starting one. */
+{
+  mp_odrf_code_t	retval;
+  if (mpfr_nan_p(C->previous)) {
+    adjust_prec(C->previous, root);
+    retval = MP_ODRF_CONTINUE;
+  } else {
+    if (mpfr_get_prec(C->previous) != mpfr_get_prec(root))
+      mpfr_prec_round(C->previous, mpfr_get_prec(root), GMP_RNDN);
+    retval = delta_test(root, C->previous, C->epsabs, C->epsrel, C->tmp1, C->tmp2);
+  }
+  mpfr_set(C->previous, root, GMP_RNDN);
+  return retval;
+}
+static mp_odrf_code_t
+residual_eval (mp_odrf_mpfr_function_t * F, mpfr_ptr value, mpfr_ptr root)
+/* Store in VALUE  the function at ROOT.  With a ball function we store
+   the upper bound |MID|+RAD, so that the residual test is proven. */
+{
+  mp_odrf_code_t	retval;
+  if (F->ball) {
+    MPFR_DECL_INIT(radius, MP_ODRF_BALL_RADIUS_PREC);
+    retval = (F->ball)(value, radius, root, F->params);
+    if (MP_ODRF_OK == retval) {
+      mpfr_abs(value, value, GMP_RNDU);
+      mpfr_add(value, value, radius, GMP_RNDU);
+    }
+  } else
+    retval = MP_ODRF_MPFR_FN_EVAL(F, value, root);
+  return retval;
+}
+static mp_odrf_code_t
+count_iteration (mp_odrf_stop_t * C, mp_odrf_code_t retval)
+{
+  ++(C->iterations);
+  if ((MP_ODRF_CONTINUE == retval) &&
+      C->max_iterations && (C->iterations >= C->max_iterations))
+    retval = MP_ODRF_ERROR_MAX_ITERATIONS_REACHED;
+  return retval;
+}
+mp_odrf_code_t
+mp_odrf_stop_fsolver (mp_odrf_stop_t * C, mp_odrf_mpfr_root_fsolver_t * S)
+/* Test the criterion against the current state of S; it must be called
+   once after every iteration. */
+{
+  mp_odrf_code_t	retval;
+  switch (C->kind) {
+  case MP_ODRF_STOP_INTERVAL:
+    retval = interval_test(S->x_lower, S->x_upper, C->epsabs, C->epsrel, C->tmp1, C->tmp2);
+    break;
+  case MP_ODRF_STOP_DELTA:
+    retval = delta_step(C, S->root);
+    break;
+  case MP_ODRF_STOP_RESIDUAL:
+    adjust_prec(C->value, S->root);
+    retval = residual_eval(S->function, C->value, S->root);
+    if (MP_ODRF_OK == retval)
+      retval = residual_test(C->value, C->epsabs);
+    break;
+  default:
+    retval = MP_ODRF_ERROR;
+  }
+  return count_iteration(C, retval);
+}
+mp_odrf_code_t
+mp_odrf_stop_fdfsolver (mp_odrf_stop_t * C, mp_odrf_mpfr_root_fdfsolver_t * S)
+/* Test the criterion against the current state of S; it must be called
+   once after every iteration.   The interval criterion is meaningless for
+   root polishing solvers. */
+{
+  mp_odrf_code_t	retval;
+  switch (C->kind) {
+  case MP_ODRF_STOP_DELTA:
+    retval = delta_step(C, S->root);
+    break;
+  case MP_ODRF_STOP_RESIDUAL:
+    adjust_prec(C->value, S->root);
+    retval = MP_ODRF_MPFR_FN_FDF_EVAL_F(S->fdf, C->value, S->root);
+    if (MP_ODRF_OK == retval)
+      retval = residual_test(C->value, C->epsabs);
+    break;
+  default:
+    retval = MP_ODRF_ERROR;
+  }
+  return count_iteration(C, retval);
+}
+
+/* end of file */
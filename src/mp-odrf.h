@@ -101,7 +101,8 @@ extern "C" {
  ** ----------------------------------------------------------------- */
 
 typedef enum {
-  MP_ODRF_POSITIVE_ERROR_CODE_LIMIT			=   2,
+  MP_ODRF_POSITIVE_ERROR_CODE_LIMIT			=   3,
+  MP_ODRF_BRACKET_EXHAUSTED				=   2,
   MP_ODRF_CONTINUE					=   1,
   MP_ODRF_OK						=   0,
   MP_ODRF_ERROR						=  -1,
@@ -114,7 +115,13 @@ typedef enum {
   MP_ODRF_ERROR_FUNCTION_VALUE_IS_NOT_FINITE		=  -8,
   MP_ODRF_ERROR_DERIVATIVE_IS_ZERO			=  -9,
   MP_ODRF_ERROR_FUNCTION_OR_DERIVATIVE_VALUE_INVALID	= -10,
-  MP_ODRF_NEGATIVE_ERROR_CODE_LIMIT			= -11
+  MP_ODRF_ERROR_MAX_ITERATIONS_REACHED			= -11,
+  MP_ODRF_ERROR_INVALID_PRECISION			= -12,
+  MP_ODRF_ERROR_UNSUPPORTED_BY_DRIVER			= -13,
+  MP_ODRF_ERROR_SIGN_IS_UNCERTAIN			= -14,
+  MP_ODRF_ERROR_ROUNDING_IS_UNDECIDED			= -15,
+  MP_ODRF_ERROR_INVALID_DRIVER_PARAMETER		= -16,
+  MP_ODRF_NEGATIVE_ERROR_CODE_LIMIT			= -17
 } mp_odrf_code_t;
 
 mp_odrf_decl const char * mp_odrf_strerror (mp_odrf_code_t code);
@@ -128,16 +135,64 @@ typedef int mp_odrf_mpfr_wrapped_f_t	(mpfr_ptr y, mpfr_ptr x, void * params);
 typedef int mp_odrf_mpfr_wrapped_fdf_t	(mpfr_ptr dy,
 					 mpfr_ptr y, mpfr_ptr x, void * params);
 
+/* Like the wrapped functions above, but the results need only BITS correct
+   leading bits, which  is never more than their precision;  the signs
+   must always be right, and a result must be zero only if the exact value
+   is. */
+typedef int mp_odrf_mpfr_hinted_f_t	(mpfr_ptr y, mpfr_ptr x,
+					 mp_prec_t bits, void * params);
+typedef int mp_odrf_mpfr_hinted_fdf_t	(mpfr_ptr dy, mpfr_ptr y, mpfr_ptr x,
+					 mp_prec_t bits, void * params);
+
+/* Store in SIGN the sign of the function at X, -1, 0 or +1, computing
+   it with  working precision PREC;  if  the sign cannot be decided  at
+   PREC store "MP_ODRF_SIGN_UNCERTAIN". */
+typedef int mp_odrf_mpfr_sign_f_t	(int * sign, mpfr_ptr x,
+					 mp_prec_t prec, void * params);
+
+#define MP_ODRF_SIGN_UNCERTAIN		2
+
+/* Store in MID and RAD a ball containing the value of the function at X:
+   the exact value is in [MID-RAD, MID+RAD].  MID is computed with its own
+   precision, RAD must be rounded upwards. */
+typedef int mp_odrf_mpfr_ball_f_t	(mpfr_ptr mid, mpfr_ptr rad, mpfr_ptr x,
+					 void * params);
+
+/* Double precision versions of the math function, used to compute the
+   first bits of the root in hardware;  they receive the same PARAMS of
+   the MPFR functions.  The second stores in F and DF the function and its
+   derivative. */
+typedef double mp_odrf_double_f_t	(double x, void * params);
+typedef void   mp_odrf_double_fdf_t	(double x, void * params, double * f, double * df);
+
+/* At least one  of "function" and "hinted" must be  set; the drivers use
+   "hinted" when it is not NULL.  The  sign oracle is optional and only
+   the drivers that use just the signs look at it.  The ball function is
+   optional: the  root bracketing drivers use  it in place of  the others
+   and decide on the signs only when they are certain.  The double
+   precision function is optional and used only by the "set_hybrid"
+   function. */
 typedef struct {
   mp_odrf_mpfr_wrapped_f_t *		function;
   void *				params;
+  mp_odrf_mpfr_hinted_f_t *		hinted;
+  mp_odrf_mpfr_sign_f_t *		sign;
+  mp_odrf_mpfr_ball_f_t *		ball;
+  mp_odrf_double_f_t *			double_f;
 } mp_odrf_mpfr_function_t;
 
+/* Every hinted function, when  not NULL, is used in place  of the plain
+   one.  The double precision function is optional and used only by the
+   "set_hybrid" function. */
 typedef struct {
   mp_odrf_mpfr_wrapped_f_t *	f;
   mp_odrf_mpfr_wrapped_f_t *	df;
   mp_odrf_mpfr_wrapped_fdf_t *	fdf;
   void *			params;
+  mp_odrf_mpfr_hinted_f_t *	hinted_f;
+  mp_odrf_mpfr_hinted_f_t *	hinted_df;
+  mp_odrf_mpfr_hinted_fdf_t *	hinted_fdf;
+  mp_odrf_double_fdf_t *	double_fdf;
 } mp_odrf_mpfr_function_fdf_t;
 
 /* Given  the target  math function  wrapped in  a structure  F of  type
@@ -148,7 +203,16 @@ typedef struct {
    If  an  error  occurs  computing   the  function:  a  suitable  error
    code must be returned. */
 #define MP_ODRF_MPFR_FN_EVAL(F,Y,X)			\
-  (((F)->function)((Y), (X), (F)->params))
+  (((F)->function)?					\
+   ((F)->function)((Y), (X), (F)->params) :		\
+   ((F)->hinted)((Y), (X), mpfr_get_prec(Y), (F)->params))
+
+/* Like "MP_ODRF_MPFR_FN_EVAL()", but only BITS correct bits of the result
+   are needed. */
+#define MP_ODRF_MPFR_FN_EVAL_HINTED(F,Y,X,BITS)		\
+  (((F)->hinted)?					\
+   ((F)->hinted)((Y), (X), (BITS), (F)->params) :	\
+   ((F)->function)((Y), (X), (F)->params))
 
 /* Given  the target  math  function  and its  derivative  wrapped in  a
    structure  FDF  of  type "mp_odrf_mpfr_function_fdf_t":  compute  the
@@ -157,8 +221,10 @@ typedef struct {
    initialised.
 
    If an  error occurs:  a suitable  error code must be returned. */
-#define MP_ODRF_MPFR_FN_FDF_EVAL_F(FDF,Y,X)		\
-  (((FDF)->f) ((Y), (X), (FDF)->params))
+#define MP_ODRF_MPFR_FN_FDF_EVAL_F(FDF,Y,X)			\
+  (((FDF)->f)?							\
+   ((FDF)->f) ((Y), (X), (FDF)->params) :			\
+   ((FDF)->hinted_f) ((Y), (X), mpfr_get_prec(Y), (FDF)->params))
 
 /* Given  the target  math  function  and its  derivative  wrapped in  a
    structure  FDF  of  type "mp_odrf_mpfr_function_fdf_t":  compute  the
@@ -167,8 +233,10 @@ typedef struct {
    initialised.
 
    If an  error occurs:  a suitable  error code must be returned. */
-#define MP_ODRF_MPFR_FN_FDF_EVAL_DF(FDF,DY,X)	\
-  (((FDF)->df) ((DY), (X), (FDF)->params))
+#define MP_ODRF_MPFR_FN_FDF_EVAL_DF(FDF,DY,X)				\
+  (((FDF)->df)?								\
+   ((FDF)->df) ((DY), (X), (FDF)->params) :				\
+   ((FDF)->hinted_df) ((DY), (X), mpfr_get_prec(DY), (FDF)->params))
 
 /* Given  the target  math  function  and its  derivative  wrapped in  a
    structure FDF of type "mp_odrf_mpfr_function_fdf_t": compute both the
@@ -178,8 +246,25 @@ typedef struct {
    of X, Y and DY must have been already initialised.
 
    If an  error occurs:  a suitable  error code must be returned. */
-#define MP_ODRF_MPFR_FN_FDF_EVAL_F_DF(FDF,DY,Y,X)	\
-  (((FDF)->fdf)((DY), (Y), (X), (FDF)->params))
+#define MP_ODRF_MPFR_FN_FDF_EVAL_F_DF(FDF,DY,Y,X)				\
+  (((FDF)->fdf)?								\
+   ((FDF)->fdf)((DY), (Y), (X), (FDF)->params) :				\
+   ((FDF)->hinted_fdf)((DY), (Y), (X), mpfr_get_prec(Y), (FDF)->params))
+
+/* Like the  macros above,  but only BITS  correct bits of  the results are
+   needed. */
+#define MP_ODRF_MPFR_FN_FDF_EVAL_F_HINTED(FDF,Y,X,BITS)		\
+  (((FDF)->hinted_f)?						\
+   ((FDF)->hinted_f) ((Y), (X), (BITS), (FDF)->params) :	\
+   ((FDF)->f) ((Y), (X), (FDF)->params))
+#define MP_ODRF_MPFR_FN_FDF_EVAL_DF_HINTED(FDF,DY,X,BITS)	\
+  (((FDF)->hinted_df)?						\
+   ((FDF)->hinted_df) ((DY), (X), (BITS), (FDF)->params) :	\
+   ((FDF)->df) ((DY), (X), (FDF)->params))
+#define MP_ODRF_MPFR_FN_FDF_EVAL_F_DF_HINTED(FDF,DY,Y,X,BITS)		\
+  (((FDF)->hinted_fdf)?							\
+   ((FDF)->hinted_fdf)((DY), (Y), (X), (BITS), (FDF)->params) :		\
+   ((FDF)->fdf)((DY), (Y), (X), (FDF)->params))
 
 
 /** --------------------------------------------------------------------
@@ -206,8 +291,9 @@ typedef mp_odrf_code_t \
 
 /* Prototype of function  used to initalise the state  of a root-finding
    problem.   It is  used by  the algorithm's  drivers, the  client code
-   should never use it. */
-typedef void mp_odrf_mpfr_roots_init_fun_t	(void * driver_state);
+   should never use it.  FLAGS are the "MP_ODRF_SOLVER_FLAG_*" bits of the
+   solver, describing how the limbs of the MPFR members were laid out. */
+typedef void mp_odrf_mpfr_roots_init_fun_t	(void * driver_state, unsigned flags);
 
 /* Prototype of  function used to  finalise the state of  a root-finding
    problem.   It is  used by  the algorithm's  drivers, the  client code
@@ -216,10 +302,24 @@ typedef void mp_odrf_mpfr_roots_final_fun_t	(void * driver_state);
 
 /* Driver  for  root  bracketing  algorithms.   The  library  statically
    allocates  and  initalises  an  instance  of  this  struct  for  each
-   implemented algorithm. */
+   implemented algorithm.
+
+   The first "driver_state_mpfr_count" members of the driver state struct
+   must be of type  "mpfr_t": the library initialises and finalises them
+   when allocating  and releasing  a solver.  The  optional "init"  and
+   "final" functions handle the remaining members, if any; they are also
+   called, in reverse order, when the solver is reset.
+
+   The first "driver_state_ordinate_count" of  those "mpfr_t" members
+   hold only function values or ratios of function values: they can be
+   given  a  precision  lower than  the  one of  the abscissae  with
+   "mp_odrf_mpfr_root_fsolver_set_ordinate_prec()".  The driver must not
+   swap their limbs with the ones of the other members. */
 typedef struct {
   const char *				name;
   size_t				driver_state_size;
+  size_t				driver_state_mpfr_count;
+  size_t				driver_state_ordinate_count;
   mp_odrf_mpfr_roots_init_fun_t *	init;
   mp_odrf_mpfr_roots_final_fun_t *	final;
   mp_odrf_mpfr_roots_f_fun_t *		set;
@@ -228,10 +328,12 @@ typedef struct {
 
 /* Driver  for  root  polishing   algorithms.   The  library  statically
    allocates  and  initalises  an  instance  of  this  struct  for  each
-   implemented algorithm. */
+   implemented algorithm.   The driver  state struct  follows the  same
+   layout rules of the root bracketing drivers. */
 typedef struct {
   const char *				name;
   size_t				driver_state_size;
+  size_t				driver_state_mpfr_count;
   mp_odrf_mpfr_roots_init_fun_t *	init;
   mp_odrf_mpfr_roots_final_fun_t *	final;
   mp_odrf_mpfr_roots_fdf_fun_t *	set;
@@ -245,14 +347,94 @@ typedef struct {
 
 /* Root bracketing algorithms. */
 mp_odrf_decl const mp_odrf_mpfr_root_fsolver_driver_t  * mp_odrf_mpfr_root_fsolver_bisection;
+mp_odrf_decl const mp_odrf_mpfr_root_fsolver_driver_t  * mp_odrf_mpfr_root_fsolver_bisection_sign;
 mp_odrf_decl const mp_odrf_mpfr_root_fsolver_driver_t  * mp_odrf_mpfr_root_fsolver_brent;
 mp_odrf_decl const mp_odrf_mpfr_root_fsolver_driver_t  * mp_odrf_mpfr_root_fsolver_falsepos;
+mp_odrf_decl const mp_odrf_mpfr_root_fsolver_driver_t  * mp_odrf_mpfr_root_fsolver_itp;
+mp_odrf_decl const mp_odrf_mpfr_root_fsolver_driver_t  * mp_odrf_mpfr_root_fsolver_ridders;
+mp_odrf_decl const mp_odrf_mpfr_root_fsolver_driver_t  * mp_odrf_mpfr_root_fsolver_illinois;
+mp_odrf_decl const mp_odrf_mpfr_root_fsolver_driver_t  * mp_odrf_mpfr_root_fsolver_pegasus;
+mp_odrf_decl const mp_odrf_mpfr_root_fsolver_driver_t  * mp_odrf_mpfr_root_fsolver_anderson_bjorck;
+mp_odrf_decl const mp_odrf_mpfr_root_fsolver_driver_t  * mp_odrf_mpfr_root_fsolver_toms748;
+mp_odrf_decl const mp_odrf_mpfr_root_fsolver_driver_t  * mp_odrf_mpfr_root_fsolver_chandrupatla;
 
 /* Root polishing algorithms. */
 mp_odrf_decl const mp_odrf_mpfr_root_fdfsolver_driver_t  * mp_odrf_mpfr_root_fdfsolver_newton;
+mp_odrf_decl const mp_odrf_mpfr_root_fdfsolver_driver_t  * mp_odrf_mpfr_root_fdfsolver_newton_doubling;
 mp_odrf_decl const mp_odrf_mpfr_root_fdfsolver_driver_t  * mp_odrf_mpfr_root_fdfsolver_secant;
 mp_odrf_decl const mp_odrf_mpfr_root_fdfsolver_driver_t  * mp_odrf_mpfr_root_fdfsolver_steffenson;
 
+
+/** --------------------------------------------------------------------
+ ** Memory allocation.
+ ** ----------------------------------------------------------------- */
+
+/* Allocator used  to obtain  the memory blocks  of solvers.   Every
+   function receives the "context" pointer as first argument; the "free"
+   function is never called with a NULL pointer. */
+typedef struct {
+  void *	(*alloc)	(void * context, size_t size);
+  void *	(*realloc)	(void * context, void * ptr, size_t size);
+  void		(*free)		(void * context, void * ptr);
+  void *	context;
+} mp_odrf_allocator_t;
+
+/* Select the allocator used by the solver constructors which do not take
+   one  as argument;  if A  is NULL:  restore the  default allocator,
+   which uses "malloc()", "realloc()" and "free()".  The referenced
+   struct must survive all the solvers allocated with it. */
+mp_odrf_decl void mp_odrf_set_allocator (const mp_odrf_allocator_t * A);
+
+/* Return the allocator currently used by the solver constructors. */
+mp_odrf_decl const mp_odrf_allocator_t * mp_odrf_get_allocator (void);
+
+/* Bump arena from which GMP,  MPFR and the user callbacks allocate their
+   temporary memory  while a  solver using it  is iterating  in the
+   current thread.   The first  time an arena  is allocated  the library
+   installs with "mp_set_memory_functions()" functions that forward every
+   other request to the previously installed ones.  Memory obtained from
+   GMP or MPFR inside  an iteration must be released inside the same
+   iteration. */
+typedef struct mp_odrf_arena_t	mp_odrf_arena_t;
+
+/* Allocate with the current allocator an arena of CAPACITY bytes; when
+   it is  full allocations  are forwarded.  Return  NULL if  memory
+   allocation fails. */
+mp_odrf_decl mp_odrf_arena_t * mp_odrf_arena_alloc (size_t capacity);
+
+/* Release an arena; no solver must use it anymore. */
+mp_odrf_decl void mp_odrf_arena_free (mp_odrf_arena_t * arena);
+
+/* Empty an arena; solvers do it when a solve completes. */
+mp_odrf_decl void mp_odrf_arena_reset (mp_odrf_arena_t * arena);
+
+/* Return the number of bytes in use, and the number of allocations which
+   did not fit, since the last reset. */
+mp_odrf_decl size_t mp_odrf_arena_used      (const mp_odrf_arena_t * arena);
+mp_odrf_decl size_t mp_odrf_arena_overflows (const mp_odrf_arena_t * arena);
+
+
+
+/** --------------------------------------------------------------------
+ ** MPFR functions: solver memory layout.
+ ** ----------------------------------------------------------------- */
+
+/* Bits for the  "flags" field of the solver structs,  describing how the
+   memory of the solver was obtained. */
+typedef enum {
+  /* The solver struct, the driver state and the limbs of all the MPFR
+     numbers are stored in a single memory block. */
+  MP_ODRF_SOLVER_FLAG_CONTIGUOUS	= 1,
+  /* The memory block is owned by the caller, which initialised the
+     solver in place. */
+  MP_ODRF_SOLVER_FLAG_IN_PLACE		= 2
+} mp_odrf_solver_flag_t;
+
+/* Required alignment of the buffers handed to the "init_in_place"
+   functions; the sizes returned  by the "sizeof" functions are multiples
+   of it, so solvers can be stored in arrays. */
+#define MP_ODRF_SOLVER_ALIGNMENT	16
+
 
 /** --------------------------------------------------------------------
  ** MPFR functions: root bracketing problems.
@@ -268,16 +450,76 @@ typedef struct {
   mpfr_t				x_lower;
   mpfr_t				x_upper;
   void *				driver_state;
+  mp_odrf_arena_t *			arena;
+  const mp_odrf_allocator_t *		allocator;
+  unsigned				flags;
+  /* The precision the  solver was allocated with, the one selected for
+     the ordinates and the starting precision of the adaptive mode, zero
+     if the precision is fixed. */
+  mp_prec_t				prec;
+  mp_prec_t				ordinate_prec;
+  mp_prec_t				start_prec;
+  /* When not zero: the driver met a sign which the ball function could
+     not decide, and the solver goes on bisecting  with it; this is the
+     sign at the lower bound. */
+  int					ball_lower_sign;
 } mp_odrf_mpfr_root_fsolver_t;
 
 /* Allocate and initialise a new root bracketing state struct to use the
-   selected algorithm driver. */
+   selected algorithm driver, with the current default precision.  When
+   the library  is configured with "--enable-inline-limbs" this  is the
+   same as the contiguous allocation below. */
 mp_odrf_decl mp_odrf_mpfr_root_fsolver_t * \
   mp_odrf_mpfr_root_fsolver_alloc (const mp_odrf_mpfr_root_fsolver_driver_t * T);
 
+/* Like "mp_odrf_mpfr_root_fsolver_alloc()",  but all the MPFR numbers of
+   the  solver have  precision  PREC,  regardless  of the  default one.
+   Return NULL if PREC is invalid or memory allocation fails. */
+mp_odrf_decl mp_odrf_mpfr_root_fsolver_t * \
+  mp_odrf_mpfr_root_fsolver_alloc2 (const mp_odrf_mpfr_root_fsolver_driver_t * T,
+				     mp_prec_t prec);
+
+/* Like "mp_odrf_mpfr_root_fsolver_alloc()", but lay out the solver, the
+   driver state and the limbs of all the MPFR numbers in a single memory
+   block, using the current default precision. */
+mp_odrf_decl mp_odrf_mpfr_root_fsolver_t * \
+  mp_odrf_mpfr_root_fsolver_alloc_contiguous (const mp_odrf_mpfr_root_fsolver_driver_t * T);
+
+/* Like  "mp_odrf_mpfr_root_fsolver_alloc_contiguous()",  but  obtain the
+   memory block from the allocator A rather than from the one selected
+   with "mp_odrf_set_allocator()".  The solver  holds no other memory, so
+   an arena allocator can release it without calling the "free" function
+   of the solver. */
+mp_odrf_decl mp_odrf_mpfr_root_fsolver_t * \
+  mp_odrf_mpfr_root_fsolver_alloc_with_allocator (const mp_odrf_mpfr_root_fsolver_driver_t * T,
+						  const mp_odrf_allocator_t * A);
+
+/* Return the  number of bytes  needed to  store a solver  with driver T
+   and numbers of precision PREC in a single memory block. */
+mp_odrf_decl size_t \
+  mp_odrf_mpfr_root_fsolver_sizeof (const mp_odrf_mpfr_root_fsolver_driver_t * T,
+				    mp_prec_t prec);
+
+/* Initialise  a  solver with driver  T and  numbers  of precision PREC
+   in BUFFER,  which must be at least  as wide as reported by the
+   "sizeof" function  and aligned to "MP_ODRF_SOLVER_ALIGNMENT".  Return
+   BUFFER as pointer to the solver. */
+mp_odrf_decl mp_odrf_mpfr_root_fsolver_t * \
+  mp_odrf_mpfr_root_fsolver_init_in_place (void * buffer,
+					   const mp_odrf_mpfr_root_fsolver_driver_t * T,
+					   mp_prec_t prec);
+
+/* Finalise a solver initialised in place; the buffer is not released. */
+mp_odrf_decl void mp_odrf_mpfr_root_fsolver_fini_in_place (mp_odrf_mpfr_root_fsolver_t * S);
+
 /* Finalise and release a root bracketing state struct. */
 mp_odrf_decl void mp_odrf_mpfr_root_fsolver_free (mp_odrf_mpfr_root_fsolver_t * S);
 
+/* Forget the problem  of a root bracketing state struct,  but keep the
+   storage of its MPFR numbers;  the struct must be set again before
+   iterating. */
+mp_odrf_decl void mp_odrf_mpfr_root_fsolver_reset (mp_odrf_mpfr_root_fsolver_t * S);
+
 /* Select the  math function to be  searched for roots for  a given root
    bracketing state struct.  Also selects the search bracket. */
 mp_odrf_decl mp_odrf_code_t \
@@ -285,11 +527,84 @@ mp_odrf_decl mp_odrf_code_t \
 				 mp_odrf_mpfr_function_t * f,
 				 mpfr_t x_lower, mpfr_t x_upper);
 
+/* Like  the "set"  function, but  if F  has a  double precision  version
+   the bracket is first narrowed  with Brent's method in hardware, then
+   widened until the MPFR function straddles zero at its bounds. */
+mp_odrf_decl mp_odrf_code_t \
+  mp_odrf_mpfr_root_fsolver_set_hybrid (mp_odrf_mpfr_root_fsolver_t * S,
+					mp_odrf_mpfr_function_t * f,
+					mpfr_t x_lower, mpfr_t x_upper);
+
+/* Set to PREC the precision of  the function values in the driver state,
+   leaving the abscissae untouched;  the sign tests and the ratios of
+   function values become cheaper.  It must be called before the "set"
+   function; the precision is retained  by "reset".  For a solver laid
+   out in a single memory block PREC must not exceed the precision of
+   the abscissae,  else  "MP_ODRF_ERROR_INVALID_PRECISION"  is returned;
+   for the other solvers the memory of the limbs is reallocated. */
+mp_odrf_decl mp_odrf_code_t \
+  mp_odrf_mpfr_root_fsolver_set_ordinate_prec (mp_odrf_mpfr_root_fsolver_t * S,
+					       mp_prec_t prec);
+
+/* Select the adaptive mode: the "set" function lowers the precision of
+   all the numbers  to PREC and the "iterate" function raises  it as the
+   bracket narrows,  up to the  precision of the solver; if  PREC is zero:
+   go  back to the fixed precision.   It must be called before the "set"
+   function. */
+mp_odrf_decl mp_odrf_code_t \
+  mp_odrf_mpfr_root_fsolver_set_adaptive_prec (mp_odrf_mpfr_root_fsolver_t * S,
+					       mp_prec_t prec);
+
+/* Make  the solver  use ARENA,  or no  arena if  NULL, for  the memory
+   allocated by the  "set" and "iterate" functions; the arena  is reset
+   by the "set" and "reset" functions. */
+mp_odrf_decl void mp_odrf_mpfr_root_fsolver_set_arena (mp_odrf_mpfr_root_fsolver_t * S,
+						       mp_odrf_arena_t * arena);
+
+/* Select TOL  as the minimum step of  a Brent solver, or  go back to
+   the default if  TOL is NULL.  The default is  half the relative spacing
+   of the numbers at the working precision, times the current estimate
+   of the root; the larger of the two  is used.  It is forgotten by the
+   "reset" function.  Return "MP_ODRF_ERROR_UNSUPPORTED_BY_DRIVER" if S
+   is not a Brent solver. */
+mp_odrf_decl mp_odrf_code_t \
+  mp_odrf_mpfr_root_fsolver_brent_set_tolerance (mp_odrf_mpfr_root_fsolver_t * S,
+						 mpfr_srcptr tol);
+
+/* Select the parameters of an ITP solver: the truncation step is "KAPPA1
+   W0 (W / W0)^KAPPA2", W being  the width of the bracket and W0 the
+   initial one;  the bracket  is never wider than  the one of bisection
+   after N0 more steps.   KAPPA1 must be  positive and KAPPA2 in the
+   range [1, 2.618...); the defaults are 0.2, 2 and 1, restored by the
+   "reset" function.  Return "MP_ODRF_ERROR_INVALID_DRIVER_PARAMETER"
+   for  a parameter out of range,  "MP_ODRF_ERROR_UNSUPPORTED_BY_DRIVER"
+   if S is not an ITP solver. */
+mp_odrf_decl mp_odrf_code_t \
+  mp_odrf_mpfr_root_fsolver_itp_set_parameters (mp_odrf_mpfr_root_fsolver_t * S,
+						double kappa1, double kappa2,
+						unsigned long n0);
+
 /* Perform a search iteration for a root bracketing state struct. */
 mp_odrf_decl int mp_odrf_mpfr_root_fsolver_iterate (mp_odrf_mpfr_root_fsolver_t * S);
 
+/* Select F and  the bracket [X_LOWER, X_UPPER] like the  "set" function,
+   then iterate until the root can be stored in ROP correctly rounded in
+   the direction RND; the sign of the error is stored in TERNARY, as for
+   the MPFR functions.  The working precision starts a few bits above the
+   one of ROP and it is raised only when the bounds of the bracket do not
+   round to the same number, up to the precision of the solver, which
+   must be larger  than the one of ROP.  Return "MP_ODRF_OK", or
+   "MP_ODRF_ERROR_ROUNDING_IS_UNDECIDED" if the  solver's precision is
+   not enough, or the error code of the "set" and "iterate" functions. */
+mp_odrf_decl mp_odrf_code_t \
+  mp_odrf_mpfr_root_fsolver_solve_rounded (mp_odrf_mpfr_root_fsolver_t * S,
+					   mp_odrf_mpfr_function_t * F,
+					   mpfr_t x_lower, mpfr_t x_upper,
+					   mpfr_ptr rop, int * ternary, mp_rnd_t rnd);
+
 /* Inspect the current state of a root bracketing problem. */
 mp_odrf_decl const char * mp_odrf_mpfr_root_fsolver_name (const mp_odrf_mpfr_root_fsolver_t * S);
+mp_odrf_decl mp_prec_t mp_odrf_mpfr_root_fsolver_prec   (const mp_odrf_mpfr_root_fsolver_t * S);
 mp_odrf_decl mpfr_ptr mp_odrf_mpfr_root_fsolver_root    (const mp_odrf_mpfr_root_fsolver_t * S);
 mp_odrf_decl mpfr_ptr mp_odrf_mpfr_root_fsolver_x_lower (const mp_odrf_mpfr_root_fsolver_t * S);
 mp_odrf_decl mpfr_ptr mp_odrf_mpfr_root_fsolver_x_upper (const mp_odrf_mpfr_root_fsolver_t * S);
@@ -307,16 +622,55 @@ typedef struct {
   mp_odrf_mpfr_function_fdf_t *		fdf;
   mpfr_t				root;
   void *				driver_state;
+  mp_odrf_arena_t *			arena;
+  const mp_odrf_allocator_t *		allocator;
+  unsigned				flags;
 } mp_odrf_mpfr_root_fdfsolver_t;
 
 /* Allocate and initialise a new root  polishing state struct to use the
-   selected algorithm driver. */
+   selected algorithm driver, with the current default precision.  When
+   the library  is configured with "--enable-inline-limbs" this  is the
+   same as the contiguous allocation below. */
 mp_odrf_decl mp_odrf_mpfr_root_fdfsolver_t * \
   mp_odrf_mpfr_root_fdfsolver_alloc (const mp_odrf_mpfr_root_fdfsolver_driver_t * T);
 
+/* Like "mp_odrf_mpfr_root_fdfsolver_alloc()", but all the MPFR numbers
+   of the solver have precision PREC. */
+mp_odrf_decl mp_odrf_mpfr_root_fdfsolver_t * \
+  mp_odrf_mpfr_root_fdfsolver_alloc2 (const mp_odrf_mpfr_root_fdfsolver_driver_t * T,
+				       mp_prec_t prec);
+
+/* Like "mp_odrf_mpfr_root_fdfsolver_alloc()",  but lay out the solver,
+   the driver state and the limbs of  all the MPFR numbers in a single
+   memory block, using the current default precision. */
+mp_odrf_decl mp_odrf_mpfr_root_fdfsolver_t * \
+  mp_odrf_mpfr_root_fdfsolver_alloc_contiguous (const mp_odrf_mpfr_root_fdfsolver_driver_t * T);
+
+/* Like "mp_odrf_mpfr_root_fdfsolver_alloc_contiguous()", but obtain the
+   memory block from the allocator A. */
+mp_odrf_decl mp_odrf_mpfr_root_fdfsolver_t * \
+  mp_odrf_mpfr_root_fdfsolver_alloc_with_allocator (const mp_odrf_mpfr_root_fdfsolver_driver_t * T,
+						    const mp_odrf_allocator_t * A);
+
+/* Size query and  in place initialisation  of root polishing  solvers;
+   the same rules of root bracketing solvers apply. */
+mp_odrf_decl size_t \
+  mp_odrf_mpfr_root_fdfsolver_sizeof (const mp_odrf_mpfr_root_fdfsolver_driver_t * T,
+				      mp_prec_t prec);
+mp_odrf_decl mp_odrf_mpfr_root_fdfsolver_t * \
+  mp_odrf_mpfr_root_fdfsolver_init_in_place (void * buffer,
+					     const mp_odrf_mpfr_root_fdfsolver_driver_t * T,
+					     mp_prec_t prec);
+mp_odrf_decl void mp_odrf_mpfr_root_fdfsolver_fini_in_place (mp_odrf_mpfr_root_fdfsolver_t * S);
+
 /* Finalise and release a root polishing state struct. */
 mp_odrf_decl void mp_odrf_mpfr_root_fdfsolver_free (mp_odrf_mpfr_root_fdfsolver_t * S);
 
+/* Forget the problem  of a root polishing state struct,  but keep the
+   storage of its MPFR numbers;  the struct must be set again before
+   iterating. */
+mp_odrf_decl void mp_odrf_mpfr_root_fdfsolver_reset (mp_odrf_mpfr_root_fdfsolver_t * S);
+
 /* Select the  math function to be  searched for roots for  a given root
    polishing state struct.  Also selects the initial solution guess. */
 mp_odrf_decl mp_odrf_code_t \
@@ -324,13 +678,65 @@ mp_odrf_decl mp_odrf_code_t \
 					 mp_odrf_mpfr_function_fdf_t * fdf,
 					 mpfr_t root);
 
+/* Like  the "set"  function, but  if FDF  has a  double precision version
+   the guess is first refined with Newton's method in hardware; if that
+   does not converge the guess is used as it is. */
+mp_odrf_decl mp_odrf_code_t \
+  mp_odrf_mpfr_root_fdfsolver_set_hybrid (mp_odrf_mpfr_root_fdfsolver_t * S,
+					  mp_odrf_mpfr_function_fdf_t * fdf,
+					  mpfr_t root);
+
+/* Make  the solver  use ARENA,  or no  arena if  NULL; the  same rules of
+   root bracketing solvers apply. */
+mp_odrf_decl void mp_odrf_mpfr_root_fdfsolver_set_arena (mp_odrf_mpfr_root_fdfsolver_t * S,
+							 mp_odrf_arena_t * arena);
+
 /* Perform a search iteration for a root polishing state struct. */
 mp_odrf_decl int mp_odrf_mpfr_root_fdfsolver_iterate (mp_odrf_mpfr_root_fdfsolver_t * S);
 
 /* Inspect the current state of a root polishing problem. */
 mp_odrf_decl const char * mp_odrf_mpfr_root_fdfsolver_name (const mp_odrf_mpfr_root_fdfsolver_t * S);
+mp_odrf_decl mp_prec_t mp_odrf_mpfr_root_fdfsolver_prec (const mp_odrf_mpfr_root_fdfsolver_t * S);
 mp_odrf_decl mpfr_ptr mp_odrf_mpfr_root_fdfsolver_root (const mp_odrf_mpfr_root_fdfsolver_t * S);
 
+
+/** --------------------------------------------------------------------
+ ** MPFR functions: pools of solvers.
+ ** ----------------------------------------------------------------- */
+
+/* Cache of released solvers, from which threads can acquire and release
+   solvers  without locking.  Solvers  are selected  by algorithm driver
+   and precision of the MPFR numbers. */
+typedef struct mp_odrf_pool_t	mp_odrf_pool_t;
+
+/* Allocate a new pool able to cache CAPACITY released solvers of each
+   kind; the pool and its solvers use the current allocator. */
+mp_odrf_decl mp_odrf_pool_t * mp_odrf_pool_alloc (size_t capacity);
+
+/* Release a  pool and all the  solvers cached in it;  it must not be
+   called while other threads are using the pool. */
+mp_odrf_decl void mp_odrf_pool_free (mp_odrf_pool_t * P);
+
+/* Return a ready-to-use solver  for the driver T with precision PREC,
+   allocating  a new  one  if  the pool  has  none.   The solver  is
+   contiguous and can also be released with its "free" function. */
+mp_odrf_decl mp_odrf_mpfr_root_fsolver_t * \
+  mp_odrf_pool_fsolver_acquire (mp_odrf_pool_t * P,
+				const mp_odrf_mpfr_root_fsolver_driver_t * T,
+				mp_prec_t prec);
+mp_odrf_decl mp_odrf_mpfr_root_fdfsolver_t * \
+  mp_odrf_pool_fdfsolver_acquire (mp_odrf_pool_t * P,
+				  const mp_odrf_mpfr_root_fdfsolver_driver_t * T,
+				  mp_prec_t prec);
+
+/* Reset a solver and hand it back to the pool; if the pool is full the
+   solver is released. */
+mp_odrf_decl void mp_odrf_pool_fsolver_release   (mp_odrf_pool_t * P,
+						  mp_odrf_mpfr_root_fsolver_t * S);
+mp_odrf_decl void mp_odrf_pool_fdfsolver_release (mp_odrf_pool_t * P,
+						  mp_odrf_mpfr_root_fdfsolver_t * S);
+
+
 
 /** --------------------------------------------------------------------
  ** MPFR functions: convergence tests.
@@ -347,6 +753,60 @@ mp_odrf_decl mp_odrf_code_t \
 mp_odrf_decl mp_odrf_code_t \
   mp_odrf_mpfr_root_test_residual	(mpfr_ptr f, mpfr_ptr epsabs);
 
+
+
+/** --------------------------------------------------------------------
+ ** MPFR functions: stop criteria.
+ ** ----------------------------------------------------------------- */
+
+typedef enum {
+  /* |x_upper - x_lower| < epsabs + epsrel * min(|x_lower|, |x_upper|) */
+  MP_ODRF_STOP_INTERVAL,
+  /* |x1 - x0| < epsabs + epsrel * |x1|, with x0 the previous root */
+  MP_ODRF_STOP_DELTA,
+  /* |f(x)| < epsabs */
+  MP_ODRF_STOP_RESIDUAL
+} mp_odrf_stop_kind_t;
+
+/* Precompiled stop criterion.  It is initialised once and then tested
+   after every iteration without allocating memory. */
+typedef struct {
+  mp_odrf_stop_kind_t	kind;
+  unsigned long		max_iterations;
+  unsigned long		iterations;
+  mpfr_t		epsabs;
+  mpfr_t		epsrel;
+  /* Root of the previous iteration, for the delta criterion. */
+  mpfr_t		previous;
+  /* Function value, for the residual criterion. */
+  mpfr_t		value;
+  /* Low precision scratch numbers. */
+  mpfr_t		tmp1, tmp2;
+} mp_odrf_stop_t;
+
+/* Initialise a stop criterion; EPSREL can be NULL, meaning zero.  When
+   MAX_ITERATIONS is not zero: the  search fails after that many
+   iterations.  If an error code is returned C is left uninitialised. */
+mp_odrf_decl mp_odrf_code_t \
+  mp_odrf_stop_init (mp_odrf_stop_t * C, mp_odrf_stop_kind_t kind,
+		     mpfr_srcptr epsabs, mpfr_srcptr epsrel,
+		     unsigned long max_iterations);
+
+/* Finalise a stop criterion. */
+mp_odrf_decl void mp_odrf_stop_clear (mp_odrf_stop_t * C);
+
+/* Prepare a stop criterion for a new search. */
+mp_odrf_decl void mp_odrf_stop_reset (mp_odrf_stop_t * C);
+
+/* Test a  stop criterion against the  current state of a solver; they
+   must be called once after every iteration.  Return "MP_ODRF_OK" if the
+   search is finished, "MP_ODRF_CONTINUE"  if it must go on, else an
+   error code. */
+mp_odrf_decl mp_odrf_code_t \
+  mp_odrf_stop_fsolver   (mp_odrf_stop_t * C, mp_odrf_mpfr_root_fsolver_t * S);
+mp_odrf_decl mp_odrf_code_t \
+  mp_odrf_stop_fdfsolver (mp_odrf_stop_t * C, mp_odrf_mpfr_root_fdfsolver_t * S);
+
 
 /** --------------------------------------------------------------------
  ** MPFR functions: comparison.
@@ -0,0 +1,713 @@
+/*
+   Part of: Multiple Precision One-Dimensional Root-Finding
+   Contents: tests for the allocation of solvers
+   Date: Fri Oct 16, 2026
+
+   Abstract
+
+	Tests for  the alternative  ways of allocating  root bracketing
+	and root polishing solvers.
+
+   Copyright (c) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+   This program is free software:  you can redistribute it and/or modify
+   it under the terms of the  GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at
+   your option) any later version.
+
+   This program is  distributed in the hope that it  will be useful, but
+   WITHOUT  ANY   WARRANTY;  without   even  the  implied   warranty  of
+   MERCHANTABILITY  or FITNESS FOR  A PARTICULAR  PURPOSE.  See  the GNU
+   General Public License for more details.
+
+   You should  have received a  copy of  the GNU General  Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#define DEBUGGING		0
+#include <mp-odrf.h>
+#include <test.h>
+#include <debug.h>
+
+/* Search the root of the sine function in the interval [-1, 0.5] using
+   the already allocated bracketing solver S; validate the result. */
+static void solve_bracketing (mp_odrf_mpfr_root_fsolver_t * S);
+
+/* Search the root of the sine  function starting from the guess 0.5,
+   using the already allocated polishing solver S; validate the result. */
+static void solve_polishing (mp_odrf_mpfr_root_fdfsolver_t * S);
+
+static void test_fsolver_alloc2		(const mp_odrf_mpfr_root_fsolver_driver_t * T);
+static void test_fdfsolver_alloc2	(const mp_odrf_mpfr_root_fdfsolver_driver_t * T);
+static void test_fsolver_contiguous	(const mp_odrf_mpfr_root_fsolver_driver_t * T);
+static void test_fdfsolver_contiguous	(const mp_odrf_mpfr_root_fdfsolver_driver_t * T);
+
+static void test_fsolver_arena		(const mp_odrf_mpfr_root_fsolver_driver_t * T);
+static void test_fdfsolver_arena	(const mp_odrf_mpfr_root_fdfsolver_driver_t * T);
+static void test_global_allocator	(void);
+static void test_fsolver_in_place	(const mp_odrf_mpfr_root_fsolver_driver_t * T);
+static void test_fdfsolver_in_place	(const mp_odrf_mpfr_root_fdfsolver_driver_t * T);
+static void test_reset			(void);
+static void test_pool			(void);
+static void test_pool_parameters	(void);
+static void test_ordinate_prec		(const mp_odrf_mpfr_root_fsolver_driver_t * T);
+
+static mp_odrf_mpfr_wrapped_f_t		sine_function;
+static mp_odrf_mpfr_wrapped_f_t		cosine_function;
+static mp_odrf_mpfr_wrapped_fdf_t	sine_and_cosine_function;
+
+
+/** --------------------------------------------------------------------
+ ** Main.
+ ** ----------------------------------------------------------------- */
+
+int
+main (void)
+{
+  title("allocation of solvers with explicit precision");
+  test_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_bisection);
+  test_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_falsepos);
+  test_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_brent);
+  test_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_itp);
+  test_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_ridders);
+  test_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_illinois);
+  test_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_toms748);
+  test_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_chandrupatla);
+  test_fdfsolver_alloc2(mp_odrf_mpfr_root_fdfsolver_newton);
+  test_fdfsolver_alloc2(mp_odrf_mpfr_root_fdfsolver_newton_doubling);
+  test_fdfsolver_alloc2(mp_odrf_mpfr_root_fdfsolver_secant);
+  test_fdfsolver_alloc2(mp_odrf_mpfr_root_fdfsolver_steffenson);
+
+  title("allocation of solvers in a single memory block");
+  test_fsolver_contiguous(mp_odrf_mpfr_root_fsolver_bisection);
+  test_fsolver_contiguous(mp_odrf_mpfr_root_fsolver_falsepos);
+  test_fsolver_contiguous(mp_odrf_mpfr_root_fsolver_brent);
+  test_fsolver_contiguous(mp_odrf_mpfr_root_fsolver_itp);
+  test_fsolver_contiguous(mp_odrf_mpfr_root_fsolver_ridders);
+  test_fsolver_contiguous(mp_odrf_mpfr_root_fsolver_illinois);
+  test_fsolver_contiguous(mp_odrf_mpfr_root_fsolver_toms748);
+  test_fsolver_contiguous(mp_odrf_mpfr_root_fsolver_chandrupatla);
+  test_fdfsolver_contiguous(mp_odrf_mpfr_root_fdfsolver_newton);
+  test_fdfsolver_contiguous(mp_odrf_mpfr_root_fdfsolver_newton_doubling);
+  test_fdfsolver_contiguous(mp_odrf_mpfr_root_fdfsolver_secant);
+  test_fdfsolver_contiguous(mp_odrf_mpfr_root_fdfsolver_steffenson);
+
+  title("allocation of solvers from a user supplied arena");
+  test_fsolver_arena(mp_odrf_mpfr_root_fsolver_bisection);
+  test_fsolver_arena(mp_odrf_mpfr_root_fsolver_falsepos);
+  test_fsolver_arena(mp_odrf_mpfr_root_fsolver_brent);
+  test_fdfsolver_arena(mp_odrf_mpfr_root_fdfsolver_newton);
+  test_fdfsolver_arena(mp_odrf_mpfr_root_fdfsolver_newton_doubling);
+  test_fdfsolver_arena(mp_odrf_mpfr_root_fdfsolver_secant);
+  test_fdfsolver_arena(mp_odrf_mpfr_root_fdfsolver_steffenson);
+  test_global_allocator();
+
+  title("solvers in caller-provided storage");
+  test_fsolver_in_place(mp_odrf_mpfr_root_fsolver_bisection);
+  test_fsolver_in_place(mp_odrf_mpfr_root_fsolver_falsepos);
+  test_fsolver_in_place(mp_odrf_mpfr_root_fsolver_brent);
+  test_fsolver_in_place(mp_odrf_mpfr_root_fsolver_itp);
+  test_fsolver_in_place(mp_odrf_mpfr_root_fsolver_ridders);
+  test_fsolver_in_place(mp_odrf_mpfr_root_fsolver_illinois);
+  test_fsolver_in_place(mp_odrf_mpfr_root_fsolver_toms748);
+  test_fsolver_in_place(mp_odrf_mpfr_root_fsolver_chandrupatla);
+  test_fdfsolver_in_place(mp_odrf_mpfr_root_fdfsolver_newton);
+  test_fdfsolver_in_place(mp_odrf_mpfr_root_fdfsolver_newton_doubling);
+  test_fdfsolver_in_place(mp_odrf_mpfr_root_fdfsolver_secant);
+  test_fdfsolver_in_place(mp_odrf_mpfr_root_fdfsolver_steffenson);
+
+  title("reusing solvers");
+  test_reset();
+  test_pool();
+  test_pool_parameters();
+
+  title("low precision ordinates");
+  test_ordinate_prec(mp_odrf_mpfr_root_fsolver_bisection);
+  test_ordinate_prec(mp_odrf_mpfr_root_fsolver_falsepos);
+  test_ordinate_prec(mp_odrf_mpfr_root_fsolver_brent);
+
+  exit(EXIT_SUCCESS);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Explicit precision.
+ ** ----------------------------------------------------------------- */
+
+static void
+test_fsolver_alloc2 (const mp_odrf_mpfr_root_fsolver_driver_t * T)
+/* Solvers with  different precisions coexist and the  default precision
+   is not touched. */
+{
+  mp_prec_t			default_prec = mpfr_get_default_prec();
+  mp_odrf_mpfr_root_fsolver_t *	S[2];
+  mp_prec_t			prec[2] = { 128, 20000 };
+  mpfr_ptr			V;
+  int				i;
+  start("alloc2 fsolver", T->name);
+  validate(NULL == mp_odrf_mpfr_root_fsolver_alloc2(T, 0), "invalid precision accepted");
+  for (i=0; i<2; ++i) {
+    S[i] = mp_odrf_mpfr_root_fsolver_alloc2(T, prec[i]);
+    if (NULL == S[i]) {
+      perror("error initialising solver");
+      exit(EXIT_FAILURE);
+    }
+  }
+  for (i=0; i<2; ++i) {
+    V = S[i]->driver_state;
+    validate(prec[i] == mp_odrf_mpfr_root_fsolver_prec(S[i]), "wrong precision of root");
+    validate(prec[i] == mpfr_get_prec(S[i]->x_upper), "wrong precision of bound");
+    validate(prec[i] == mpfr_get_prec(&V[T->driver_state_mpfr_count - 1]),
+	     "wrong precision of driver state");
+    solve_bracketing(S[i]);
+    mp_odrf_mpfr_root_fsolver_free(S[i]);
+  }
+  validate(default_prec == mpfr_get_default_prec(), "default precision changed");
+  fine();
+}
+static void
+test_fdfsolver_alloc2 (const mp_odrf_mpfr_root_fdfsolver_driver_t * T)
+{
+  mp_prec_t				default_prec = mpfr_get_default_prec();
+  mp_odrf_mpfr_root_fdfsolver_t *	S[2];
+  mp_prec_t				prec[2] = { 128, 20000 };
+  mpfr_ptr				V;
+  int					i;
+  start("alloc2 fdfsolver", T->name);
+  validate(NULL == mp_odrf_mpfr_root_fdfsolver_alloc2(T, 0), "invalid precision accepted");
+  for (i=0; i<2; ++i) {
+    S[i] = mp_odrf_mpfr_root_fdfsolver_alloc2(T, prec[i]);
+    if (NULL == S[i]) {
+      perror("error initialising solver");
+      exit(EXIT_FAILURE);
+    }
+  }
+  for (i=0; i<2; ++i) {
+    V = S[i]->driver_state;
+    validate(prec[i] == mp_odrf_mpfr_root_fdfsolver_prec(S[i]), "wrong precision of root");
+    validate(prec[i] == mpfr_get_prec(&V[T->driver_state_mpfr_count - 1]),
+	     "wrong precision of driver state");
+    solve_polishing(S[i]);
+    mp_odrf_mpfr_root_fdfsolver_free(S[i]);
+  }
+  validate(default_prec == mpfr_get_default_prec(), "default precision changed");
+  fine();
+}
+
+
+/** --------------------------------------------------------------------
+ ** Contiguous allocation.
+ ** ----------------------------------------------------------------- */
+
+static void
+test_fsolver_contiguous (const mp_odrf_mpfr_root_fsolver_driver_t * T)
+{
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  start("contiguous fsolver", T->name);
+  S = mp_odrf_mpfr_root_fsolver_alloc_contiguous(T);
+  if (NULL == S) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  validate(MP_ODRF_SOLVER_FLAG_CONTIGUOUS & S->flags, "missing contiguous flag");
+  validate(mpfr_get_default_prec() == mpfr_get_prec(S->root),
+	   "wrong precision of root");
+  solve_bracketing(S);
+  mp_odrf_mpfr_root_fsolver_free(S);
+  fine();
+}
+static void
+test_fdfsolver_contiguous (const mp_odrf_mpfr_root_fdfsolver_driver_t * T)
+{
+  mp_odrf_mpfr_root_fdfsolver_t *	S;
+  start("contiguous fdfsolver", T->name);
+  S = mp_odrf_mpfr_root_fdfsolver_alloc_contiguous(T);
+  if (NULL == S) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  validate(MP_ODRF_SOLVER_FLAG_CONTIGUOUS & S->flags, "missing contiguous flag");
+  validate(mpfr_get_default_prec() == mpfr_get_prec(S->root),
+	   "wrong precision of root");
+  solve_polishing(S);
+  mp_odrf_mpfr_root_fdfsolver_free(S);
+  fine();
+}
+
+
+/** --------------------------------------------------------------------
+ ** User supplied allocators.
+ ** ----------------------------------------------------------------- */
+
+/* A bump arena: blocks are never released one by one, the whole arena
+   is reset at once. */
+typedef struct {
+  char		buffer[1 << 16];
+  size_t	used;
+  int		allocs;
+  int		frees;
+} arena_t;
+
+static arena_t	the_arena;
+
+static void *
+arena_alloc (void * context, size_t size)
+{
+  arena_t *	arena = context;
+  void *	ptr   = NULL;
+  size = (size + 15) & ~((size_t)15);
+  if (arena->used + size <= sizeof(arena->buffer)) {
+    ptr = arena->buffer + arena->used;
+    arena->used += size;
+    ++(arena->allocs);
+  }
+  return ptr;
+}
+static void *
+arena_realloc (void * context MP_ODRF_UNUSED, void * ptr MP_ODRF_UNUSED,
+	       size_t size MP_ODRF_UNUSED)
+{
+  return NULL;
+}
+static void
+arena_free (void * context, void * ptr MP_ODRF_UNUSED)
+{
+  arena_t *	arena = context;
+  ++(arena->frees);
+}
+static void
+arena_reset (arena_t * arena)
+{
+  arena->used	= 0;
+  arena->allocs	= 0;
+  arena->frees	= 0;
+}
+
+static const mp_odrf_allocator_t arena_allocator = {
+  .alloc	= arena_alloc,
+  .realloc	= arena_realloc,
+  .free		= arena_free,
+  .context	= &the_arena
+};
+
+static void
+test_fsolver_arena (const mp_odrf_mpfr_root_fsolver_driver_t * T)
+{
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  start("arena fsolver", T->name);
+  arena_reset(&the_arena);
+  S = mp_odrf_mpfr_root_fsolver_alloc_with_allocator(T, &arena_allocator);
+  validate(NULL != S, "error allocating solver");
+  if (NULL != S) {
+    validate((char *)S == the_arena.buffer, "solver not allocated in the arena");
+    validate(1 == the_arena.allocs, "expected one allocation, got %d", the_arena.allocs);
+    solve_bracketing(S);
+    /* Release the whole arena without calling the solver's "free". */
+    arena_reset(&the_arena);
+  }
+  fine();
+}
+static void
+test_fdfsolver_arena (const mp_odrf_mpfr_root_fdfsolver_driver_t * T)
+{
+  mp_odrf_mpfr_root_fdfsolver_t *	S;
+  start("arena fdfsolver", T->name);
+  arena_reset(&the_arena);
+  S = mp_odrf_mpfr_root_fdfsolver_alloc_with_allocator(T, &arena_allocator);
+  validate(NULL != S, "error allocating solver");
+  if (NULL != S) {
+    validate((char *)S == the_arena.buffer, "solver not allocated in the arena");
+    validate(1 == the_arena.allocs, "expected one allocation, got %d", the_arena.allocs);
+    solve_polishing(S);
+    mp_odrf_mpfr_root_fdfsolver_free(S);
+    validate(1 == the_arena.frees, "expected one release, got %d", the_arena.frees);
+    arena_reset(&the_arena);
+  }
+  fine();
+}
+static void
+test_global_allocator (void)
+{
+  mp_odrf_mpfr_root_fsolver_t *		S;
+  mp_odrf_mpfr_root_fdfsolver_t *	R;
+  start("global allocator", "heap solvers");
+  arena_reset(&the_arena);
+  mp_odrf_set_allocator(&arena_allocator);
+  validate(&arena_allocator == mp_odrf_get_allocator(), "wrong current allocator");
+  S = mp_odrf_mpfr_root_fsolver_alloc(mp_odrf_mpfr_root_fsolver_brent);
+  R = mp_odrf_mpfr_root_fdfsolver_alloc(mp_odrf_mpfr_root_fdfsolver_newton);
+  mp_odrf_set_allocator(NULL);
+  validate(&arena_allocator != mp_odrf_get_allocator(), "default allocator not restored");
+  validate((NULL != S) && (NULL != R), "error allocating solvers");
+  if ((NULL != S) && (NULL != R)) {
+    /* Heap solvers take two blocks each, contiguous solvers one. */
+    int	blocks = (MP_ODRF_SOLVER_FLAG_CONTIGUOUS & S->flags)? 2 : 4;
+    validate(blocks == the_arena.allocs, "expected %d allocations, got %d",
+	     blocks, the_arena.allocs);
+    solve_bracketing(S);
+    solve_polishing(R);
+    /* The solvers remember their allocator. */
+    mp_odrf_mpfr_root_fsolver_free(S);
+    mp_odrf_mpfr_root_fdfsolver_free(R);
+    validate(blocks == the_arena.frees, "expected %d releases, got %d",
+	     blocks, the_arena.frees);
+  }
+  arena_reset(&the_arena);
+  fine();
+}
+
+
+/** --------------------------------------------------------------------
+ ** Caller-provided storage.
+ ** ----------------------------------------------------------------- */
+
+#define NUMBER_OF_SOLVERS	4
+
+static void
+test_fsolver_in_place (const mp_odrf_mpfr_root_fsolver_driver_t * T)
+/* Store an array of solvers in a single block. */
+{
+  static char	buffer[1 << 14] __attribute__((aligned(MP_ODRF_SOLVER_ALIGNMENT)));
+  size_t	size = mp_odrf_mpfr_root_fsolver_sizeof(T, 200);
+  int		i;
+  start("in place fsolver", T->name);
+  validate(0 == (size % MP_ODRF_SOLVER_ALIGNMENT), "size not aligned: %lu",
+	   (unsigned long)size);
+  validate(NUMBER_OF_SOLVERS * size <= sizeof(buffer), "buffer too small");
+  if (NUMBER_OF_SOLVERS * size <= sizeof(buffer)) {
+    mp_odrf_mpfr_root_fsolver_t *	S[NUMBER_OF_SOLVERS];
+    for (i=0; i<NUMBER_OF_SOLVERS; ++i) {
+      S[i] = mp_odrf_mpfr_root_fsolver_init_in_place(buffer + i * size, T, 200);
+      validate((char *)S[i] == buffer + i * size, "solver not in the buffer");
+      validate(200 == mpfr_get_prec(S[i]->root), "wrong precision");
+    }
+    for (i=0; i<NUMBER_OF_SOLVERS; ++i)
+      solve_bracketing(S[i]);
+    for (i=0; i<NUMBER_OF_SOLVERS; ++i)
+      mp_odrf_mpfr_root_fsolver_fini_in_place(S[i]);
+  }
+  fine();
+}
+static void
+test_fdfsolver_in_place (const mp_odrf_mpfr_root_fdfsolver_driver_t * T)
+/* Store an array of solvers in a single block. */
+{
+  static char	buffer[1 << 14] __attribute__((aligned(MP_ODRF_SOLVER_ALIGNMENT)));
+  size_t	size = mp_odrf_mpfr_root_fdfsolver_sizeof(T, 200);
+  int		i;
+  start("in place fdfsolver", T->name);
+  validate(0 == (size % MP_ODRF_SOLVER_ALIGNMENT), "size not aligned: %lu",
+	   (unsigned long)size);
+  validate(NUMBER_OF_SOLVERS * size <= sizeof(buffer), "buffer too small");
+  if (NUMBER_OF_SOLVERS * size <= sizeof(buffer)) {
+    mp_odrf_mpfr_root_fdfsolver_t *	S[NUMBER_OF_SOLVERS];
+    for (i=0; i<NUMBER_OF_SOLVERS; ++i) {
+      S[i] = mp_odrf_mpfr_root_fdfsolver_init_in_place(buffer + i * size, T, 200);
+      validate((char *)S[i] == buffer + i * size, "solver not in the buffer");
+      validate(200 == mpfr_get_prec(S[i]->root), "wrong precision");
+    }
+    for (i=0; i<NUMBER_OF_SOLVERS; ++i)
+      solve_polishing(S[i]);
+    for (i=0; i<NUMBER_OF_SOLVERS; ++i)
+      mp_odrf_mpfr_root_fdfsolver_fini_in_place(S[i]);
+  }
+  fine();
+}
+
+
+/** --------------------------------------------------------------------
+ ** Reusing solvers.
+ ** ----------------------------------------------------------------- */
+
+static void
+test_reset (void)
+{
+  mp_odrf_mpfr_root_fsolver_t *		S;
+  mp_odrf_mpfr_root_fdfsolver_t *	R;
+  start("reset", "solve twice with the same solvers");
+  S = mp_odrf_mpfr_root_fsolver_alloc(mp_odrf_mpfr_root_fsolver_brent);
+  R = mp_odrf_mpfr_root_fdfsolver_alloc(mp_odrf_mpfr_root_fdfsolver_steffenson);
+  if ((NULL == S) || (NULL == R)) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  solve_bracketing(S);
+  solve_polishing(R);
+  mp_odrf_mpfr_root_fsolver_reset(S);
+  mp_odrf_mpfr_root_fdfsolver_reset(R);
+  validate(mpfr_nan_p(mp_odrf_mpfr_root_fsolver_root(S)), "root not reset");
+  validate(NULL == S->function, "function not reset");
+  validate(mpfr_nan_p(mp_odrf_mpfr_root_fdfsolver_root(R)), "root not reset");
+  validate(NULL == R->fdf, "function not reset");
+  solve_bracketing(S);
+  solve_polishing(R);
+  mp_odrf_mpfr_root_fsolver_free(S);
+  mp_odrf_mpfr_root_fdfsolver_free(R);
+  fine();
+}
+static void
+test_pool (void)
+{
+  mp_odrf_pool_t *			P;
+  mp_odrf_mpfr_root_fsolver_t *		S1, * S2, * S3;
+  mp_odrf_mpfr_root_fdfsolver_t *	R1, * R2;
+  start("pool", "acquire and release solvers");
+  P = mp_odrf_pool_alloc(2);
+  if (NULL == P) {
+    perror("error initialising pool");
+    exit(EXIT_FAILURE);
+  }
+  S1 = mp_odrf_pool_fsolver_acquire(P, mp_odrf_mpfr_root_fsolver_brent, 128);
+  R1 = mp_odrf_pool_fdfsolver_acquire(P, mp_odrf_mpfr_root_fdfsolver_newton, 128);
+  validate((NULL != S1) && (NULL != R1), "error acquiring solvers");
+  validate(128 == mpfr_get_prec(S1->root), "wrong precision");
+  solve_bracketing(S1);
+  solve_polishing(R1);
+  mp_odrf_pool_fsolver_release(P, S1);
+  mp_odrf_pool_fdfsolver_release(P, R1);
+
+  /* Same driver and precision: we get back the released solvers. */
+  S2 = mp_odrf_pool_fsolver_acquire(P, mp_odrf_mpfr_root_fsolver_brent, 128);
+  R2 = mp_odrf_pool_fdfsolver_acquire(P, mp_odrf_mpfr_root_fdfsolver_newton, 128);
+  validate(S1 == S2, "fsolver not reused");
+  validate(R1 == R2, "fdfsolver not reused");
+  solve_bracketing(S2);
+  solve_polishing(R2);
+  mp_odrf_pool_fsolver_release(P, S2);
+
+  /* Different precision or driver: we get new solvers. */
+  S3 = mp_odrf_pool_fsolver_acquire(P, mp_odrf_mpfr_root_fsolver_brent, 256);
+  validate(S3 != S2, "fsolver with wrong precision reused");
+  validate(256 == mpfr_get_prec(S3->root), "wrong precision");
+  mp_odrf_pool_fsolver_release(P, S3);
+  S3 = mp_odrf_pool_fsolver_acquire(P, mp_odrf_mpfr_root_fsolver_bisection, 128);
+  validate(S3 != S2, "fsolver with wrong driver reused");
+  solve_bracketing(S3);
+  /* The pool is full: this one is released. */
+  mp_odrf_pool_fsolver_release(P, S3);
+
+  mp_odrf_pool_fdfsolver_release(P, R2);
+  mp_odrf_pool_free(P);
+  fine();
+}
+static void
+itp_first_iterates (mp_odrf_mpfr_root_fsolver_t * S, mpfr_t root)
+/* Search  the root of  the cosine function  in the interval [1, 2]:
+   store in ROOT the approximation after a few iterations. */
+{
+  mp_odrf_mpfr_function_t	F = {
+    .function	= cosine_function,
+    .params	= NULL
+  };
+  mpfr_t	x_lower, x_upper;
+  int		rv, i;
+  mpfr_inits(x_lower, x_upper, (mpfr_ptr)0);
+  {
+    mpfr_set_d(x_lower, 1.0, GMP_RNDN);
+    mpfr_set_d(x_upper, 2.0, GMP_RNDN);
+    rv = mp_odrf_mpfr_root_fsolver_set(S, &F, x_lower, x_upper);
+    validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+    for (i=0; (MP_ODRF_OK == rv) && (i < 3); ++i)
+      rv = mp_odrf_mpfr_root_fsolver_iterate(S);
+    validate(MP_ODRF_OK == rv, "error iterating: %s", mp_odrf_strerror(rv));
+    mpfr_set(root, mp_odrf_mpfr_root_fsolver_root(S), GMP_RNDN);
+  }
+  mpfr_clears(x_lower, x_upper, (mpfr_ptr)0);
+}
+static void
+test_pool_parameters (void)
+{
+  mp_odrf_pool_t *			P;
+  mp_odrf_mpfr_root_fsolver_t *		S1, * S2;
+  mpfr_t				expected, got;
+  int					rv;
+  start("pool", "released solvers forget the driver parameters");
+  P = mp_odrf_pool_alloc(1);
+  if (NULL == P) {
+    perror("error initialising pool");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits2(128, expected, got, (mpfr_ptr)0);
+  {
+    S1 = mp_odrf_pool_fsolver_acquire(P, mp_odrf_mpfr_root_fsolver_itp, 128);
+    validate(NULL != S1, "error acquiring solver");
+    itp_first_iterates(S1, expected);
+    rv = mp_odrf_mpfr_root_fsolver_itp_set_parameters(S1, 0.9, 1.1, 4);
+    validate(MP_ODRF_OK == rv, "error setting parameters: %s", mp_odrf_strerror(rv));
+    itp_first_iterates(S1, got);
+    validate(! mpfr_equal_p(expected, got), "parameters without effect");
+    mp_odrf_pool_fsolver_release(P, S1);
+
+    S2 = mp_odrf_pool_fsolver_acquire(P, mp_odrf_mpfr_root_fsolver_itp, 128);
+    validate(S1 == S2, "fsolver not reused");
+    itp_first_iterates(S2, got);
+    validate_expected_got_mpfr(expected, got);
+    mp_odrf_pool_fsolver_release(P, S2);
+  }
+  mpfr_clears(expected, got, (mpfr_ptr)0);
+  mp_odrf_pool_free(P);
+  fine();
+}
+
+
+/** --------------------------------------------------------------------
+ ** Low precision ordinates.
+ ** ----------------------------------------------------------------- */
+
+static void
+test_ordinate_prec (const mp_odrf_mpfr_root_fsolver_driver_t * T)
+/* The  ordinates are the  first "mpfr_t" members of  the driver state;
+   the abscissae that follow must keep the precision of the root. */
+{
+  mp_odrf_mpfr_root_fsolver_t *	S[2];
+  mp_prec_t	prec = mpfr_get_default_prec();
+  mpfr_ptr	V;
+  size_t	n = T->driver_state_ordinate_count;
+  int		i, rv;
+  start("ordinate precision", T->name);
+  validate(0 < n, "no ordinates");
+  validate(n < T->driver_state_mpfr_count, "no abscissae");
+  S[0] = mp_odrf_mpfr_root_fsolver_alloc(T);
+  S[1] = mp_odrf_mpfr_root_fsolver_alloc_contiguous(T);
+  if ((NULL == S[0]) || (NULL == S[1])) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  for (i=0; i<2; ++i) {
+    V  = S[i]->driver_state;
+    rv = mp_odrf_mpfr_root_fsolver_set_ordinate_prec(S[i], 24);
+    validate(MP_ODRF_OK == rv, "error setting precision: %s", mp_odrf_strerror(rv));
+    validate(24   == mpfr_get_prec(&V[0]),   "wrong precision of first ordinate");
+    validate(24   == mpfr_get_prec(&V[n-1]), "wrong precision of last ordinate");
+    validate(prec == mpfr_get_prec(&V[n]),   "wrong precision of abscissa");
+    solve_bracketing(S[i]);
+    mp_odrf_mpfr_root_fsolver_reset(S[i]);
+    validate(24 == mpfr_get_prec(&V[0]), "precision not retained by reset");
+    solve_bracketing(S[i]);
+  }
+  /* The limbs of a contiguous solver cannot grow. */
+  rv = mp_odrf_mpfr_root_fsolver_set_ordinate_prec(S[1], 2 * prec);
+  validate(MP_ODRF_ERROR_INVALID_PRECISION == rv, "wrong error code: %d", rv);
+  rv = mp_odrf_mpfr_root_fsolver_set_ordinate_prec(S[1], prec);
+  validate(MP_ODRF_OK == rv, "error restoring precision: %s", mp_odrf_strerror(rv));
+  solve_bracketing(S[1]);
+  /* The limbs of the other solvers are reallocated. */
+  rv = mp_odrf_mpfr_root_fsolver_set_ordinate_prec(S[0], 2 * prec);
+  validate(MP_ODRF_OK == rv, "error growing precision: %s", mp_odrf_strerror(rv));
+  solve_bracketing(S[0]);
+  mp_odrf_mpfr_root_fsolver_free(S[0]);
+  mp_odrf_mpfr_root_fsolver_free(S[1]);
+  fine();
+}
+
+
+/** --------------------------------------------------------------------
+ ** Solving.
+ ** ----------------------------------------------------------------- */
+
+static void
+solve_bracketing (mp_odrf_mpfr_root_fsolver_t * S)
+{
+  mp_odrf_mpfr_function_t	F = {
+    .function	= sine_function,
+    .params	= NULL
+  };
+  mpfr_t	x_lower, x_upper, epsabs, epsrel, zero;
+  int		rv, i;
+  mpfr_inits(x_lower, x_upper, epsabs, epsrel, zero, (mpfr_ptr)0);
+  {
+    mpfr_set_d(x_lower, -1.0, GMP_RNDN);
+    mpfr_set_d(x_upper,  0.5, GMP_RNDN);
+    mpfr_set_d(epsabs, 1e-10, GMP_RNDN);
+    mpfr_set_d(epsrel, 0.0,   GMP_RNDN);
+    mpfr_set_d(zero,   0.0,   GMP_RNDN);
+    rv = mp_odrf_mpfr_root_fsolver_set(S, &F, x_lower, x_upper);
+    validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+    for (i=0; (MP_ODRF_OK == rv) && (i < 1000); ++i) {
+      rv = mp_odrf_mpfr_root_fsolver_iterate(S);
+      validate(MP_ODRF_OK == rv, "error iterating: %s", mp_odrf_strerror(rv));
+      if (MP_ODRF_OK != rv) break;
+      rv = mp_odrf_mpfr_root_test_interval(mp_odrf_mpfr_root_fsolver_x_lower(S),
+					   mp_odrf_mpfr_root_fsolver_x_upper(S),
+					   epsabs, epsrel);
+      if (MP_ODRF_OK == rv) {
+	validate_expected_got_mpfr(zero, mp_odrf_mpfr_root_fsolver_root(S));
+	break;
+      } else if (MP_ODRF_CONTINUE == rv)
+	rv = MP_ODRF_OK;
+      else
+	error(mp_odrf_strerror(rv));
+    }
+  }
+  mpfr_clears(x_lower, x_upper, epsabs, epsrel, zero, (mpfr_ptr)0);
+}
+static void
+solve_polishing (mp_odrf_mpfr_root_fdfsolver_t * S)
+{
+  mp_odrf_mpfr_function_fdf_t	FDF = {
+    .f		= sine_function,
+    .df		= cosine_function,
+    .fdf	= sine_and_cosine_function,
+    .params	= NULL
+  };
+  mpfr_t	guess, x0, epsabs, epsrel, zero;
+  int		rv, i;
+  mpfr_inits(guess, x0, epsabs, epsrel, zero, (mpfr_ptr)0);
+  {
+    mpfr_set_d(guess,  0.5,   GMP_RNDN);
+    mpfr_set_d(epsabs, 1e-10, GMP_RNDN);
+    mpfr_set_d(epsrel, 0.0,   GMP_RNDN);
+    mpfr_set_d(zero,   0.0,   GMP_RNDN);
+    rv = mp_odrf_mpfr_root_fdfsolver_set(S, &FDF, guess);
+    validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+    for (i=0; (MP_ODRF_OK == rv) && (i < 1000); ++i) {
+      mpfr_set(x0, mp_odrf_mpfr_root_fdfsolver_root(S), GMP_RNDN);
+      rv = mp_odrf_mpfr_root_fdfsolver_iterate(S);
+      validate(MP_ODRF_OK == rv, "error iterating: %s", mp_odrf_strerror(rv));
+      if (MP_ODRF_OK != rv) break;
+      rv = mp_odrf_mpfr_root_test_delta(mp_odrf_mpfr_root_fdfsolver_root(S), x0,
+					epsabs, epsrel);
+      if (MP_ODRF_OK == rv) {
+	validate_expected_got_mpfr(zero, mp_odrf_mpfr_root_fdfsolver_root(S));
+	break;
+      } else if (MP_ODRF_CONTINUE == rv)
+	rv = MP_ODRF_OK;
+      else
+	error(mp_odrf_strerror(rv));
+    }
+  }
+  mpfr_clears(guess, x0, epsabs, epsrel, zero, (mpfr_ptr)0);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Math functions.
+ ** ----------------------------------------------------------------- */
+
+static int
+sine_function (mpfr_t y, mpfr_t x, void * params_ MP_ODRF_UNUSED)
+{
+  mpfr_sin(y, x, GMP_RNDN);
+  return MP_ODRF_OK;
+}
+static int
+cosine_function (mpfr_t y, mpfr_t x, void * params_ MP_ODRF_UNUSED)
+{
+  mpfr_cos(y, x, GMP_RNDN);
+  return MP_ODRF_OK;
+}
+static int
+sine_and_cosine_function (mpfr_t dy, mpfr_t y, mpfr_t x,
+			  void * params_ MP_ODRF_UNUSED)
+{
+  mpfr_sin(y,  x, GMP_RNDN);
+  mpfr_cos(dy, x, GMP_RNDN);
+  return MP_ODRF_OK;
+}
+
+/* end of file */
@@ -0,0 +1,361 @@
+/*
+   Part of: Multiple Precision One-Dimensional Root-Finding
+   Contents: tests for the bump arenas
+   Date: Fri Oct 16, 2026
+
+   Abstract
+
+	Tests for the  arenas from which GMP,  MPFR and the user callbacks
+	allocate while a solver is iterating.
+
+   Copyright (c) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+   This program is free software:  you can redistribute it and/or modify
+   it under the terms of the  GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at
+   your option) any later version.
+
+   This program is  distributed in the hope that it  will be useful, but
+   WITHOUT  ANY   WARRANTY;  without   even  the  implied   warranty  of
+   MERCHANTABILITY  or FITNESS FOR  A PARTICULAR  PURPOSE.  See  the GNU
+   General Public License for more details.
+
+   You should  have received a  copy of  the GNU General  Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#define DEBUGGING		0
+#include <mp-odrf.h>
+#include <test.h>
+#include <debug.h>
+
+/* Parameters of the math functions: they allocate a temporary number of
+   precision  "prec" and record whether  its limbs were taken  from the
+   arena. */
+typedef struct {
+  mp_odrf_arena_t *	arena;
+  mp_prec_t		prec;
+  int			routed;
+} arena_params_t;
+
+static void test_fsolver	(const mp_odrf_mpfr_root_fsolver_driver_t * T);
+static void test_fdfsolver	(const mp_odrf_mpfr_root_fdfsolver_driver_t * T);
+static void test_adaptive	(const mp_odrf_mpfr_root_fsolver_driver_t * T);
+static void test_overflow	(void);
+static void test_inactive	(void);
+
+static void solve_bracketing	(mp_odrf_mpfr_root_fsolver_t * S, arena_params_t * params);
+static void solve_polishing	(mp_odrf_mpfr_root_fdfsolver_t * S, arena_params_t * params);
+static void solve_half_pi	(mp_odrf_mpfr_root_fsolver_t * S, arena_params_t * params);
+
+static mp_odrf_mpfr_wrapped_f_t		sine_function;
+static mp_odrf_mpfr_wrapped_f_t		cosine_function;
+static mp_odrf_mpfr_wrapped_fdf_t	sine_and_cosine_function;
+
+
+/** --------------------------------------------------------------------
+ ** Main.
+ ** ----------------------------------------------------------------- */
+
+int
+main (void)
+{
+  title("solvers allocating from an arena");
+  test_fsolver(mp_odrf_mpfr_root_fsolver_bisection);
+  test_fsolver(mp_odrf_mpfr_root_fsolver_falsepos);
+  test_fsolver(mp_odrf_mpfr_root_fsolver_brent);
+  test_fdfsolver(mp_odrf_mpfr_root_fdfsolver_newton);
+  test_fdfsolver(mp_odrf_mpfr_root_fdfsolver_newton_doubling);
+  test_fdfsolver(mp_odrf_mpfr_root_fdfsolver_secant);
+  test_fdfsolver(mp_odrf_mpfr_root_fdfsolver_steffenson);
+  test_adaptive(mp_odrf_mpfr_root_fsolver_bisection);
+  test_adaptive(mp_odrf_mpfr_root_fsolver_brent);
+  test_adaptive(mp_odrf_mpfr_root_fsolver_chandrupatla);
+
+  title("arena limits");
+  test_overflow();
+  test_inactive();
+
+  exit(EXIT_SUCCESS);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Tests.
+ ** ----------------------------------------------------------------- */
+
+static void
+test_fsolver (const mp_odrf_mpfr_root_fsolver_driver_t * T)
+{
+  arena_params_t		params = { .prec = 1000, .routed = 0 };
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  start("arena fsolver", T->name);
+  params.arena	= mp_odrf_arena_alloc(1 << 16);
+  S		= mp_odrf_mpfr_root_fsolver_alloc(T);
+  if ((NULL == params.arena) || (NULL == S)) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mp_odrf_mpfr_root_fsolver_set_arena(S, params.arena);
+  solve_bracketing(S, &params);
+  validate(params.routed, "allocations not routed to the arena");
+  validate(0 == mp_odrf_arena_overflows(params.arena), "unexpected overflows");
+  /* Solve again: "set" empties the arena. */
+  solve_bracketing(S, &params);
+  mp_odrf_mpfr_root_fsolver_reset(S);
+  validate(0 == mp_odrf_arena_used(params.arena), "arena not reset");
+  mp_odrf_mpfr_root_fsolver_free(S);
+  mp_odrf_arena_free(params.arena);
+  fine();
+}
+static void
+test_fdfsolver (const mp_odrf_mpfr_root_fdfsolver_driver_t * T)
+{
+  arena_params_t			params = { .prec = 1000, .routed = 0 };
+  mp_odrf_mpfr_root_fdfsolver_t *	S;
+  start("arena fdfsolver", T->name);
+  params.arena	= mp_odrf_arena_alloc(1 << 16);
+  S		= mp_odrf_mpfr_root_fdfsolver_alloc(T);
+  if ((NULL == params.arena) || (NULL == S)) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mp_odrf_mpfr_root_fdfsolver_set_arena(S, params.arena);
+  solve_polishing(S, &params);
+  validate(params.routed, "allocations not routed to the arena");
+  solve_polishing(S, &params);
+  mp_odrf_mpfr_root_fdfsolver_reset(S);
+  validate(0 == mp_odrf_arena_used(params.arena), "arena not reset");
+  mp_odrf_mpfr_root_fdfsolver_free(S);
+  mp_odrf_arena_free(params.arena);
+  fine();
+}
+static void
+test_adaptive (const mp_odrf_mpfr_root_fsolver_driver_t * T)
+/* The escalations of the adaptive mode reallocate the limbs of the solver,
+   which must not come from the arena: they are released at the end. */
+{
+  arena_params_t		params = { .prec = 1000, .routed = 0 };
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  int				rv;
+  start("arena adaptive fsolver", T->name);
+  params.arena	= mp_odrf_arena_alloc(1 << 16);
+  S		= mp_odrf_mpfr_root_fsolver_alloc2(T, 256);
+  if ((NULL == params.arena) || (NULL == S)) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  rv = mp_odrf_mpfr_root_fsolver_set_adaptive_prec(S, 32);
+  validate(MP_ODRF_OK == rv, "error selecting adaptive mode: %s", mp_odrf_strerror(rv));
+  mp_odrf_mpfr_root_fsolver_set_arena(S, params.arena);
+  solve_half_pi(S, &params);
+  validate(params.routed, "allocations not routed to the arena");
+  validate(256 == mpfr_get_prec(mp_odrf_mpfr_root_fsolver_root(S)), "working precision not raised");
+  /* Solve again: "set" empties the arena and lowers the precision. */
+  solve_half_pi(S, &params);
+  mp_odrf_mpfr_root_fsolver_free(S);
+  mp_odrf_arena_free(params.arena);
+  fine();
+}
+static void
+test_overflow (void)
+/* Allocations that do not fit are forwarded: the solve still succeeds. */
+{
+  arena_params_t		params = { .prec = 10000, .routed = 0 };
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  start("overflow", "arena smaller than the temporaries");
+  params.arena	= mp_odrf_arena_alloc(64);
+  S		= mp_odrf_mpfr_root_fsolver_alloc(mp_odrf_mpfr_root_fsolver_brent);
+  if ((NULL == params.arena) || (NULL == S)) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mp_odrf_mpfr_root_fsolver_set_arena(S, params.arena);
+  solve_bracketing(S, &params);
+  validate(0 < mp_odrf_arena_overflows(params.arena), "no overflows recorded");
+  mp_odrf_mpfr_root_fsolver_free(S);
+  mp_odrf_arena_free(params.arena);
+  fine();
+}
+static void
+test_inactive (void)
+/* Outside the solver functions the arena is not used. */
+{
+  mp_odrf_arena_t *	arena = mp_odrf_arena_alloc(1 << 16);
+  mpfr_t		x;
+  start("inactive", "allocations outside the iterations");
+  if (NULL == arena) {
+    perror("error initialising arena");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_init2(x, 1000);
+  mpfr_set_ui(x, 1, GMP_RNDN);
+  mpfr_sin(x, x, GMP_RNDN);
+  validate(0 == mp_odrf_arena_used(arena), "arena used while inactive");
+  mpfr_clear(x);
+  mp_odrf_arena_free(arena);
+  fine();
+}
+
+
+/** --------------------------------------------------------------------
+ ** Solving.
+ ** ----------------------------------------------------------------- */
+
+static void
+solve_bracketing (mp_odrf_mpfr_root_fsolver_t * S, arena_params_t * params)
+{
+  mp_odrf_mpfr_function_t	F = {
+    .function	= sine_function,
+    .params	= params
+  };
+  mpfr_t	x_lower, x_upper, epsabs, zero;
+  int		rv, i;
+  mpfr_inits(x_lower, x_upper, epsabs, zero, (mpfr_ptr)0);
+  {
+    mpfr_set_d(x_lower, -1.0, GMP_RNDN);
+    mpfr_set_d(x_upper,  0.5, GMP_RNDN);
+    mpfr_set_d(epsabs, 1e-10, GMP_RNDN);
+    mpfr_set_d(zero,   0.0,   GMP_RNDN);
+    rv = mp_odrf_mpfr_root_fsolver_set(S, &F, x_lower, x_upper);
+    validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+    for (i=0; (MP_ODRF_OK == rv) && (i < 1000); ++i) {
+      rv = mp_odrf_mpfr_root_fsolver_iterate(S);
+      validate(MP_ODRF_OK == rv, "error iterating: %s", mp_odrf_strerror(rv));
+      if (MP_ODRF_OK != rv) break;
+      rv = mp_odrf_mpfr_root_test_interval(mp_odrf_mpfr_root_fsolver_x_lower(S),
+					   mp_odrf_mpfr_root_fsolver_x_upper(S),
+					   epsabs, zero);
+      if (MP_ODRF_OK == rv) {
+	validate_expected_got_mpfr(zero, mp_odrf_mpfr_root_fsolver_root(S));
+	break;
+      } else if (MP_ODRF_CONTINUE == rv)
+	rv = MP_ODRF_OK;
+      else
+	error(mp_odrf_strerror(rv));
+    }
+  }
+  mpfr_clears(x_lower, x_upper, epsabs, zero, (mpfr_ptr)0);
+}
+static void
+solve_half_pi (mp_odrf_mpfr_root_fsolver_t * S, arena_params_t * params)
+/* Search the root of the cosine function in [1, 2] until the bracket is
+   narrower than 2^-240 times the root. */
+{
+  mp_odrf_mpfr_function_t	F = {
+    .function	= cosine_function,
+    .params	= params
+  };
+  mpfr_t	x_lower, x_upper, epsabs, epsrel;
+  int		rv, i, converged = 0;
+  mpfr_inits2(256, x_lower, x_upper, epsabs, epsrel, (mpfr_ptr)0);
+  {
+    mpfr_set_ui(x_lower, 1, GMP_RNDN);
+    mpfr_set_ui(x_upper, 2, GMP_RNDN);
+    mpfr_set_ui(epsabs,  0, GMP_RNDN);
+    mpfr_set_ui_2exp(epsrel, 1, -240, GMP_RNDN);
+    rv = mp_odrf_mpfr_root_fsolver_set(S, &F, x_lower, x_upper);
+    validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+    for (i=0; (MP_ODRF_OK == rv) && (i < 1000); ++i) {
+      rv = mp_odrf_mpfr_root_fsolver_iterate(S);
+      validate(MP_ODRF_OK == rv, "error iterating: %s", mp_odrf_strerror(rv));
+      if (MP_ODRF_OK != rv) break;
+      rv = mp_odrf_mpfr_root_test_interval(mp_odrf_mpfr_root_fsolver_x_lower(S),
+					   mp_odrf_mpfr_root_fsolver_x_upper(S),
+					   epsabs, epsrel);
+      if (MP_ODRF_CONTINUE == rv)
+	rv = MP_ODRF_OK;
+      else if (MP_ODRF_OK == rv) {
+	converged = 1;
+	break;
+      } else
+	error(mp_odrf_strerror(rv));
+    }
+    validate(converged, "no convergence");
+  }
+  mpfr_clears(x_lower, x_upper, epsabs, epsrel, (mpfr_ptr)0);
+}
+static void
+solve_polishing (mp_odrf_mpfr_root_fdfsolver_t * S, arena_params_t * params)
+{
+  mp_odrf_mpfr_function_fdf_t	FDF = {
+    .f		= sine_function,
+    .df		= cosine_function,
+    .fdf	= sine_and_cosine_function,
+    .params	= params
+  };
+  mpfr_t	guess, x0, epsabs, zero;
+  int		rv, i;
+  mpfr_inits(guess, x0, epsabs, zero, (mpfr_ptr)0);
+  {
+    mpfr_set_d(guess,  0.5,   GMP_RNDN);
+    mpfr_set_d(epsabs, 1e-10, GMP_RNDN);
+    mpfr_set_d(zero,   0.0,   GMP_RNDN);
+    rv = mp_odrf_mpfr_root_fdfsolver_set(S, &FDF, guess);
+    validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+    for (i=0; (MP_ODRF_OK == rv) && (i < 1000); ++i) {
+      mpfr_set(x0, mp_odrf_mpfr_root_fdfsolver_root(S), GMP_RNDN);
+      rv = mp_odrf_mpfr_root_fdfsolver_iterate(S);
+      validate(MP_ODRF_OK == rv, "error iterating: %s", mp_odrf_strerror(rv));
+      if (MP_ODRF_OK != rv) break;
+      rv = mp_odrf_mpfr_root_test_delta(mp_odrf_mpfr_root_fdfsolver_root(S), x0,
+					epsabs, zero);
+      if (MP_ODRF_OK == rv) {
+	validate_expected_got_mpfr(zero, mp_odrf_mpfr_root_fdfsolver_root(S));
+	break;
+      } else if (MP_ODRF_CONTINUE == rv)
+	rv = MP_ODRF_OK;
+      else
+	error(mp_odrf_strerror(rv));
+    }
+  }
+  mpfr_clears(guess, x0, epsabs, zero, (mpfr_ptr)0);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Math functions.
+ ** ----------------------------------------------------------------- */
+
+static int
+sine_function (mpfr_t y, mpfr_t x, void * params_)
+/* Compute  the function  in  a temporary  number,  whose limbs come from
+   the arena when it is active and large enough. */
+{
+  arena_params_t *	params = params_;
+  mpfr_t		t;
+  mpfr_init2(t, params->prec);
+  if (0 < mp_odrf_arena_used(params->arena))
+    params->routed = 1;
+  mpfr_sin(t, x, GMP_RNDN);
+  mpfr_set(y, t, GMP_RNDN);
+  mpfr_clear(t);
+  return MP_ODRF_OK;
+}
+static int
+cosine_function (mpfr_t y, mpfr_t x, void * params_)
+{
+  arena_params_t *	params = params_;
+  mpfr_t		t;
+  mpfr_init2(t, params->prec);
+  if (0 < mp_odrf_arena_used(params->arena))
+    params->routed = 1;
+  mpfr_cos(t, x, GMP_RNDN);
+  mpfr_set(y, t, GMP_RNDN);
+  mpfr_clear(t);
+  return MP_ODRF_OK;
+}
+static int
+sine_and_cosine_function (mpfr_t dy, mpfr_t y, mpfr_t x, void * params_)
+{
+  sine_function(y, x, params_);
+  cosine_function(dy, x, params_);
+  return MP_ODRF_OK;
+}
+
+/* end of file */
@@ -0,0 +1,307 @@
+/*
+   Part of: Multiple Precision One-Dimensional Root-Finding
+   Contents: tests for the accuracy-hinted functions
+   Date: Fri Oct 16, 2026
+
+   Abstract
+
+	Tests  for the math functions  which receive from the  drivers the
+	number of correct bits needed at each evaluation.
+
+   Copyright (c) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+   This program is free software:  you can redistribute it and/or modify
+   it under the terms of the  GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at
+   your option) any later version.
+
+   This program is  distributed in the hope that it  will be useful, but
+   WITHOUT  ANY   WARRANTY;  without   even  the  implied   warranty  of
+   MERCHANTABILITY  or FITNESS FOR  A PARTICULAR  PURPOSE.  See  the GNU
+   General Public License for more details.
+
+   You should  have received a  copy of  the GNU General  Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#define DEBUGGING		0
+#include <mp-odrf.h>
+#include <test.h>
+#include <debug.h>
+
+/* The precision of the solvers: we search pi as root of the sine. */
+#define PREC		256
+
+/* Record the number of bits requested by the drivers. */
+typedef struct {
+  mp_prec_t	min_bits;
+  mp_prec_t	max_bits;
+  int		count;
+} hint_record_t;
+
+static void test_fsolver	(const mp_odrf_mpfr_root_fsolver_driver_t * T);
+static void test_fdfsolver	(const mp_odrf_mpfr_root_fdfsolver_driver_t * T);
+static void test_fallback	(void);
+
+static void record_init		(hint_record_t * record);
+static void validate_pi		(mpfr_srcptr root);
+
+static mp_odrf_mpfr_hinted_f_t		hinted_sine_function;
+static mp_odrf_mpfr_hinted_f_t		hinted_cosine_function;
+static mp_odrf_mpfr_hinted_fdf_t	hinted_sine_and_cosine_function;
+static mp_odrf_mpfr_wrapped_f_t		sine_function;
+
+
+/** --------------------------------------------------------------------
+ ** Main.
+ ** ----------------------------------------------------------------- */
+
+int
+main (void)
+{
+  title("root bracketing with hinted functions");
+  test_fsolver(mp_odrf_mpfr_root_fsolver_bisection);
+  test_fsolver(mp_odrf_mpfr_root_fsolver_falsepos);
+  test_fsolver(mp_odrf_mpfr_root_fsolver_brent);
+
+  title("root polishing with hinted functions");
+  test_fdfsolver(mp_odrf_mpfr_root_fdfsolver_newton);
+  test_fdfsolver(mp_odrf_mpfr_root_fdfsolver_secant);
+  test_fdfsolver(mp_odrf_mpfr_root_fdfsolver_steffenson);
+  test_fdfsolver(mp_odrf_mpfr_root_fdfsolver_newton_doubling);
+
+  title("evaluation macros");
+  test_fallback();
+
+  exit(EXIT_SUCCESS);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Tests.
+ ** ----------------------------------------------------------------- */
+
+static void
+test_fsolver (const mp_odrf_mpfr_root_fsolver_driver_t * T)
+{
+  hint_record_t			record;
+  mp_odrf_mpfr_function_t	F = {
+    .function	= NULL,
+    .params	= &record,
+    .hinted	= hinted_sine_function
+  };
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  mpfr_t			x_lower, x_upper, epsabs, epsrel;
+  int				rv, i;
+  start("hinted fsolver", T->name);
+  S = mp_odrf_mpfr_root_fsolver_alloc2(T, PREC);
+  if (NULL == S) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  record_init(&record);
+  mpfr_inits2(PREC, x_lower, x_upper, epsabs, epsrel, (mpfr_ptr)0);
+  mpfr_set_ui(x_lower, 3, GMP_RNDN);
+  mpfr_set_ui(x_upper, 4, GMP_RNDN);
+  mpfr_set_ui(epsabs,  0, GMP_RNDN);
+  mpfr_set_ui_2exp(epsrel, 1, 16 - PREC, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_set(S, &F, x_lower, x_upper);
+  validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+  for (i=0; (MP_ODRF_OK == rv) && (i < 1000); ++i) {
+    rv = mp_odrf_mpfr_root_fsolver_iterate(S);
+    validate(MP_ODRF_OK == rv, "error iterating: %s", mp_odrf_strerror(rv));
+    if (MP_ODRF_OK != rv) break;
+    rv = mp_odrf_mpfr_root_test_interval(mp_odrf_mpfr_root_fsolver_x_lower(S),
+					 mp_odrf_mpfr_root_fsolver_x_upper(S),
+					 epsabs, epsrel);
+    if (MP_ODRF_CONTINUE == rv)
+      rv = MP_ODRF_OK;
+    else
+      break;
+  }
+  validate(MP_ODRF_OK == rv, "no convergence: %s", mp_odrf_strerror(rv));
+  validate_pi(mp_odrf_mpfr_root_fsolver_root(S));
+  if (mp_odrf_mpfr_root_fsolver_bisection == T) {
+    /* Only the signs are used. */
+    validate(1 == record.max_bits,
+	     "requested %ld bits", (long)record.max_bits);
+  } else {
+    validate(record.min_bits < PREC, "always requested the full precision");
+  }
+  mpfr_clears(x_lower, x_upper, epsabs, epsrel, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(S);
+  fine();
+}
+static void
+test_fdfsolver (const mp_odrf_mpfr_root_fdfsolver_driver_t * T)
+{
+  hint_record_t			record;
+  mp_odrf_mpfr_function_fdf_t	FDF = {
+    .f		= NULL,
+    .df		= NULL,
+    .fdf	= NULL,
+    .params	= &record,
+    .hinted_f	= hinted_sine_function,
+    .hinted_df	= hinted_cosine_function,
+    .hinted_fdf	= hinted_sine_and_cosine_function
+  };
+  mp_odrf_mpfr_root_fdfsolver_t *	S;
+  mpfr_t				guess, x1, epsabs, epsrel;
+  int					rv, i;
+  start("hinted fdfsolver", T->name);
+  S = mp_odrf_mpfr_root_fdfsolver_alloc2(T, PREC);
+  if (NULL == S) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  record_init(&record);
+  mpfr_inits2(PREC, guess, x1, epsabs, epsrel, (mpfr_ptr)0);
+  mpfr_set_ui(guess, 3, GMP_RNDN);
+  mpfr_set_ui(x1,    3, GMP_RNDN);
+  mpfr_set_ui(epsabs, 0, GMP_RNDN);
+  mpfr_set_ui_2exp(epsrel, 1, 16 - PREC, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fdfsolver_set(S, &FDF, guess);
+  validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+  for (i=0; (MP_ODRF_OK == rv) && (i < 100); ++i) {
+    rv = mp_odrf_mpfr_root_fdfsolver_iterate(S);
+    validate(MP_ODRF_OK == rv, "error iterating: %s", mp_odrf_strerror(rv));
+    if (MP_ODRF_OK != rv) break;
+    rv = mp_odrf_mpfr_root_test_delta(x1, mp_odrf_mpfr_root_fdfsolver_root(S),
+				      epsabs, epsrel);
+    if (MP_ODRF_CONTINUE == rv) {
+      mpfr_set(x1, mp_odrf_mpfr_root_fdfsolver_root(S), GMP_RNDN);
+      rv = MP_ODRF_OK;
+    } else
+      break;
+  }
+  validate(MP_ODRF_OK == rv, "no convergence: %s", mp_odrf_strerror(rv));
+  validate_pi(mp_odrf_mpfr_root_fdfsolver_root(S));
+  if (mp_odrf_mpfr_root_fdfsolver_newton_doubling == T) {
+    /* The working precision starts at 53 bits: the first steps are short
+       of it. */
+    validate(record.min_bits < 53,
+	     "requested at least %ld bits", (long)record.min_bits);
+  } else {
+    validate(record.min_bits < PREC, "always requested the full precision");
+  }
+  mpfr_clears(guess, x1, epsabs, epsrel, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fdfsolver_free(S);
+  fine();
+}
+static void
+test_fallback (void)
+/* Each  evaluation macro  falls back  to the  other function  when the
+   requested one is not set; the plain macros request full precision. */
+{
+  hint_record_t			record;
+  mp_odrf_mpfr_function_t	F = {
+    .function	= NULL,
+    .params	= &record,
+    .hinted	= hinted_sine_function
+  };
+  mp_odrf_mpfr_function_t	G = {
+    .function	= sine_function,
+    .params	= &record,
+    .hinted	= NULL
+  };
+  mpfr_t	x, y;
+  int		rv;
+  start("fallback", "hinted and plain functions");
+  record_init(&record);
+  mpfr_inits2(PREC, x, y, (mpfr_ptr)0);
+  mpfr_set_ui(x, 1, GMP_RNDN);
+  rv = MP_ODRF_MPFR_FN_EVAL(&F, y, x);
+  validate(MP_ODRF_OK == rv, "error evaluating: %s", mp_odrf_strerror(rv));
+  validate(PREC == record.max_bits, "requested %ld bits", (long)record.max_bits);
+  rv = MP_ODRF_MPFR_FN_EVAL_HINTED(&F, y, x, 20);
+  validate(MP_ODRF_OK == rv, "error evaluating: %s", mp_odrf_strerror(rv));
+  validate(20 == record.min_bits, "requested %ld bits", (long)record.min_bits);
+  record_init(&record);
+  rv = MP_ODRF_MPFR_FN_EVAL_HINTED(&G, y, x, 20);
+  validate(MP_ODRF_OK == rv, "error evaluating: %s", mp_odrf_strerror(rv));
+  validate(1 == record.count, "plain function not called");
+  mpfr_clears(x, y, (mpfr_ptr)0);
+  fine();
+}
+
+
+/** --------------------------------------------------------------------
+ ** Helpers.
+ ** ----------------------------------------------------------------- */
+
+static void
+record_init (hint_record_t * record)
+{
+  record->min_bits	= MPFR_PREC_MAX;
+  record->max_bits	= 0;
+  record->count		= 0;
+}
+static void
+validate_pi (mpfr_srcptr root)
+{
+  mpfr_t	pi, tolerance;
+  mpfr_inits2(PREC, pi, tolerance, (mpfr_ptr)0);
+  mpfr_const_pi(pi, GMP_RNDN);
+  mpfr_set_ui_2exp(tolerance, 1, 16 - PREC, GMP_RNDN);
+  mpfr_reldiff(pi, pi, root, GMP_RNDN);
+  validate(mpfr_cmpabs(pi, tolerance) <= 0, "inaccurate root %.20RNf", root);
+  mpfr_clears(pi, tolerance, (mpfr_ptr)0);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Math functions.
+ ** ----------------------------------------------------------------- */
+
+/* The functions compute  the result with BITS correct bits,  then round
+   it to the precision of the output. */
+
+static int
+hinted_sine_function (mpfr_ptr y, mpfr_ptr x, mp_prec_t bits, void * params_)
+{
+  hint_record_t *	record = params_;
+  mpfr_t		t;
+  if (record->min_bits > bits)
+    record->min_bits = bits;
+  if (record->max_bits < bits)
+    record->max_bits = bits;
+  ++(record->count);
+  mpfr_init2(t, (bits < 2)? 2 : bits);
+  mpfr_sin(t, x, GMP_RNDN);
+  mpfr_set(y, t, GMP_RNDN);
+  mpfr_clear(t);
+  return MP_ODRF_OK;
+}
+static int
+hinted_cosine_function (mpfr_ptr y, mpfr_ptr x, mp_prec_t bits, void * params_ MP_ODRF_UNUSED)
+{
+  mpfr_t	t;
+  mpfr_init2(t, (bits < 2)? 2 : bits);
+  mpfr_cos(t, x, GMP_RNDN);
+  mpfr_set(y, t, GMP_RNDN);
+  mpfr_clear(t);
+  return MP_ODRF_OK;
+}
+static int
+hinted_sine_and_cosine_function (mpfr_ptr dy, mpfr_ptr y, mpfr_ptr x,
+				 mp_prec_t bits, void * params_)
+{
+  hinted_sine_function(y, x, bits, params_);
+  hinted_cosine_function(dy, x, bits, params_);
+  return MP_ODRF_OK;
+}
+static int
+sine_function (mpfr_ptr y, mpfr_ptr x, void * params_)
+{
+  hint_record_t *	record = params_;
+  ++(record->count);
+  mpfr_sin(y, x, GMP_RNDN);
+  return MP_ODRF_OK;
+}
+
+/* end of file */
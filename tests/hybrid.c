@@ -0,0 +1,278 @@
+/*
+   Part of: Multiple Precision One-Dimensional Root-Finding
+   Contents: tests for the double precision front end
+   Date: Fri Oct 16, 2026
+
+   Abstract
+
+	Tests for the "set_hybrid" functions, which compute the first bits
+	of the root with a double precision version of the math function.
+
+   Copyright (c) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+   This program is free software:  you can redistribute it and/or modify
+   it under the terms of the  GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at
+   your option) any later version.
+
+   This program is  distributed in the hope that it  will be useful, but
+   WITHOUT  ANY   WARRANTY;  without   even  the  implied   warranty  of
+   MERCHANTABILITY  or FITNESS FOR  A PARTICULAR  PURPOSE.  See  the GNU
+   General Public License for more details.
+
+   You should  have received a  copy of  the GNU General  Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#define DEBUGGING		0
+#include <mp-odrf.h>
+#include <test.h>
+#include <debug.h>
+
+/* The precision of the solvers: we search the square root of two. */
+#define PREC		256
+
+/* The parameters of the math functions: the double precision ones add
+   OFFSET to the result, to simulate a less accurate implementation. */
+typedef struct {
+  double	offset;
+  int		count;
+} params_t;
+
+static void test_fsolver	(const mp_odrf_mpfr_root_fsolver_driver_t * T, double offset);
+static void test_fdfsolver	(const mp_odrf_mpfr_root_fdfsolver_driver_t * T);
+
+static int  fsolve		(mp_odrf_mpfr_root_fsolver_t * S);
+static int  fdfsolve		(mp_odrf_mpfr_root_fdfsolver_t * S);
+static void validate_sqrt2	(mpfr_srcptr root);
+
+static mp_odrf_mpfr_wrapped_f_t	square_minus_two_function;
+static mp_odrf_mpfr_wrapped_f_t	double_x_function;
+static mp_odrf_mpfr_wrapped_fdf_t	square_minus_two_fdf_function;
+static mp_odrf_double_f_t	square_minus_two_double;
+static mp_odrf_double_fdf_t	square_minus_two_double_fdf;
+
+
+/** --------------------------------------------------------------------
+ ** Main.
+ ** ----------------------------------------------------------------- */
+
+int
+main (void)
+{
+  title("root bracketing with double precision front end");
+  test_fsolver(mp_odrf_mpfr_root_fsolver_bisection, 0.0);
+  test_fsolver(mp_odrf_mpfr_root_fsolver_brent,     0.0);
+  test_fsolver(mp_odrf_mpfr_root_fsolver_bisection, 1e-10);
+  test_fsolver(mp_odrf_mpfr_root_fsolver_brent,     1e-10);
+
+  title("root polishing with double precision front end");
+  test_fdfsolver(mp_odrf_mpfr_root_fdfsolver_newton);
+  test_fdfsolver(mp_odrf_mpfr_root_fdfsolver_steffenson);
+
+  exit(EXIT_SUCCESS);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Tests.
+ ** ----------------------------------------------------------------- */
+
+static void
+test_fsolver (const mp_odrf_mpfr_root_fsolver_driver_t * T, double offset)
+/* The  solve must  need  fewer  MPFR evaluations  than  the one  without
+   front end; with an  inaccurate double precision function the bracket
+   must still contain the root, but each widening costs two evaluations. */
+{
+  params_t			params = { offset, 0 };
+  mp_odrf_mpfr_function_t	F = {
+    .function	= square_minus_two_function,
+    .params	= &params,
+    .double_f	= square_minus_two_double
+  };
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  mpfr_t			x_lower, x_upper, tmp;
+  int				rv, plain_count;
+  start("hybrid fsolver", (0.0 == offset)? "accurate double function" : "inaccurate double function");
+  report("(%s) ", T->name);
+  S = mp_odrf_mpfr_root_fsolver_alloc2(T, PREC);
+  if (NULL == S) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits2(PREC, x_lower, x_upper, tmp, (mpfr_ptr)0);
+  mpfr_set_ui(x_lower, 1, GMP_RNDN);
+  mpfr_set_ui(x_upper, 2, GMP_RNDN);
+  /* Reference solve without front end. */
+  rv = mp_odrf_mpfr_root_fsolver_set(S, &F, x_lower, x_upper);
+  validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+  rv = fsolve(S);
+  validate(MP_ODRF_OK == rv, "no convergence: %s", mp_odrf_strerror(rv));
+  plain_count  = params.count;
+  params.count = 0;
+  /* Solve with front end. */
+  rv = mp_odrf_mpfr_root_fsolver_set_hybrid(S, &F, x_lower, x_upper);
+  validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+  mpfr_sqr(tmp, mp_odrf_mpfr_root_fsolver_x_lower(S), GMP_RNDD);
+  validate(mpfr_cmp_ui(tmp, 2) < 0, "lower bound not below the root");
+  mpfr_sqr(tmp, mp_odrf_mpfr_root_fsolver_x_upper(S), GMP_RNDU);
+  validate(mpfr_cmp_ui(tmp, 2) > 0, "upper bound not above the root");
+  mpfr_sub(tmp, mp_odrf_mpfr_root_fsolver_x_upper(S), mp_odrf_mpfr_root_fsolver_x_lower(S), GMP_RNDN);
+  validate(mpfr_cmp_d(tmp, (0.0 == offset)? 0x1p-40 : 0x1p-20) < 0, "bracket too wide");
+  rv = fsolve(S);
+  validate(MP_ODRF_OK == rv, "no convergence: %s", mp_odrf_strerror(rv));
+  validate_sqrt2(mp_odrf_mpfr_root_fsolver_root(S));
+  if (0.0 == offset)
+    validate(params.count < plain_count,
+	     "%d MPFR evaluations, %d without front end", params.count, plain_count);
+  mpfr_clears(x_lower, x_upper, tmp, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(S);
+  fine();
+}
+static void
+test_fdfsolver (const mp_odrf_mpfr_root_fdfsolver_driver_t * T)
+{
+  params_t			params = { 0.0, 0 };
+  mp_odrf_mpfr_function_fdf_t	FDF = {
+    .f		= square_minus_two_function,
+    .df		= double_x_function,
+    .fdf	= square_minus_two_fdf_function,
+    .params	= &params,
+    .double_fdf	= square_minus_two_double_fdf
+  };
+  mp_odrf_mpfr_root_fdfsolver_t *	S;
+  mpfr_t				guess;
+  int					rv, plain_count;
+  start("hybrid fdfsolver", T->name);
+  S = mp_odrf_mpfr_root_fdfsolver_alloc2(T, PREC);
+  if (NULL == S) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_init2(guess, PREC);
+  mpfr_set_ui(guess, 2, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fdfsolver_set(S, &FDF, guess);
+  validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+  rv = fdfsolve(S);
+  validate(MP_ODRF_OK == rv, "no convergence: %s", mp_odrf_strerror(rv));
+  plain_count  = params.count;
+  params.count = 0;
+  rv = mp_odrf_mpfr_root_fdfsolver_set_hybrid(S, &FDF, guess);
+  validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+  validate(fabs(mpfr_get_d(mp_odrf_mpfr_root_fdfsolver_root(S), GMP_RNDN) - 1.4142135623730951) < 1e-15,
+	   "guess not refined");
+  rv = fdfsolve(S);
+  validate(MP_ODRF_OK == rv, "no convergence: %s", mp_odrf_strerror(rv));
+  validate_sqrt2(mp_odrf_mpfr_root_fdfsolver_root(S));
+  validate(params.count < plain_count,
+	   "%d MPFR evaluations, %d without front end", params.count, plain_count);
+  mpfr_clear(guess);
+  mp_odrf_mpfr_root_fdfsolver_free(S);
+  fine();
+}
+
+
+/** --------------------------------------------------------------------
+ ** Helpers.
+ ** ----------------------------------------------------------------- */
+
+static int
+fsolve (mp_odrf_mpfr_root_fsolver_t * S)
+{
+  mpfr_t	epsabs, epsrel;
+  int		rv = MP_ODRF_OK, i;
+  mpfr_inits2(PREC, epsabs, epsrel, (mpfr_ptr)0);
+  mpfr_set_ui(epsabs, 0, GMP_RNDN);
+  mpfr_set_ui_2exp(epsrel, 1, 8 - PREC, GMP_RNDN);
+  for (i=0; i<1000; ++i) {
+    rv = mp_odrf_mpfr_root_fsolver_iterate(S);
+    if (MP_ODRF_OK != rv)
+      break;
+    rv = mp_odrf_mpfr_root_test_interval(mp_odrf_mpfr_root_fsolver_x_lower(S),
+					 mp_odrf_mpfr_root_fsolver_x_upper(S),
+					 epsabs, epsrel);
+    if (MP_ODRF_CONTINUE != rv)
+      break;
+  }
+  mpfr_clears(epsabs, epsrel, (mpfr_ptr)0);
+  return rv;
+}
+static int
+fdfsolve (mp_odrf_mpfr_root_fdfsolver_t * S)
+{
+  mpfr_t	x0, epsabs, epsrel;
+  int		rv = MP_ODRF_OK, i;
+  mpfr_inits2(PREC, x0, epsabs, epsrel, (mpfr_ptr)0);
+  mpfr_set_ui(epsabs, 0, GMP_RNDN);
+  mpfr_set_ui_2exp(epsrel, 1, 8 - PREC, GMP_RNDN);
+  mpfr_set(x0, mp_odrf_mpfr_root_fdfsolver_root(S), GMP_RNDN);
+  for (i=0; i<100; ++i) {
+    rv = mp_odrf_mpfr_root_fdfsolver_iterate(S);
+    if (MP_ODRF_OK != rv)
+      break;
+    rv = mp_odrf_mpfr_root_test_delta(mp_odrf_mpfr_root_fdfsolver_root(S), x0, epsabs, epsrel);
+    if (MP_ODRF_CONTINUE != rv)
+      break;
+    mpfr_set(x0, mp_odrf_mpfr_root_fdfsolver_root(S), GMP_RNDN);
+  }
+  mpfr_clears(x0, epsabs, epsrel, (mpfr_ptr)0);
+  return rv;
+}
+static void
+validate_sqrt2 (mpfr_srcptr root)
+{
+  mpfr_t	sqrt2, tolerance;
+  mpfr_inits2(PREC, sqrt2, tolerance, (mpfr_ptr)0);
+  mpfr_sqrt_ui(sqrt2, 2, GMP_RNDN);
+  mpfr_set_ui_2exp(tolerance, 1, 16 - PREC, GMP_RNDN);
+  mpfr_reldiff(sqrt2, sqrt2, root, GMP_RNDN);
+  validate(mpfr_cmpabs(sqrt2, tolerance) <= 0, "inaccurate root %.20RNf", root);
+  mpfr_clears(sqrt2, tolerance, (mpfr_ptr)0);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Math functions.
+ ** ----------------------------------------------------------------- */
+
+static int
+square_minus_two_function (mpfr_ptr y, mpfr_ptr x, void * params_)
+{
+  params_t *	params = params_;
+  ++(params->count);
+  mpfr_sqr(y, x, GMP_RNDN);
+  mpfr_sub_ui(y, y, 2, GMP_RNDN);
+  return MP_ODRF_OK;
+}
+static int
+double_x_function (mpfr_ptr y, mpfr_ptr x, void * params_ MP_ODRF_UNUSED)
+{
+  mpfr_mul_2ui(y, x, 1, GMP_RNDN);
+  return MP_ODRF_OK;
+}
+static int
+square_minus_two_fdf_function (mpfr_ptr dy, mpfr_ptr y, mpfr_ptr x, void * params_)
+{
+  square_minus_two_function(y, x, params_);
+  double_x_function(dy, x, params_);
+  return MP_ODRF_OK;
+}
+static double
+square_minus_two_double (double x, void * params_)
+{
+  params_t *	params = params_;
+  return x * x - 2.0 + params->offset;
+}
+static void
+square_minus_two_double_fdf (double x, void * params_, double * f, double * df)
+{
+  *f  = square_minus_two_double(x, params_);
+  *df = 2.0 * x;
+}
+
+/* end of file */
@@ -60,11 +60,60 @@ static void test_with_interval_criterion (bracket_meta_data_t data);
 static void test_with_delta_criterion    (bracket_meta_data_t data);
 static void test_with_residual_criterion (bracket_meta_data_t data);
 
+/* Tests for the tolerance of the Brent driver. */
+static void test_brent_high_precision	(void);
+static void test_brent_user_tolerance	(void);
+static int  solve_square_root_of_two	(mp_odrf_mpfr_root_fsolver_t * solver, mpfr_t epsrel,
+					 mp_prec_t * min_prec);
+
+/* Tests for the ITP driver. */
+static void test_itp_parameters		(void);
+static void test_itp_worst_case		(unsigned long n0);
+
+/* Tests for the adaptive precision mode. */
+static void test_adaptive_prec (const mp_odrf_mpfr_root_fsolver_driver_t * T, int contiguous);
+static void test_adaptive_rounded (const mp_odrf_mpfr_root_fsolver_driver_t * T);
+
+/* Tests for the sign oracle; the oracle records the working precisions
+   it is asked for. */
+typedef struct {
+  mp_prec_t	min_prec;
+  int		count;
+  int		full_count;
+} sign_record_t;
+
+static void test_sign_oracle		(void);
+static void test_sign_oracle_uncertain	(void);
+
+/* Tests for the ball functions. */
+static void test_ball (const mp_odrf_mpfr_root_fsolver_driver_t * T, int adaptive);
+
+/* Tests for the bracket exhaustion status. */
+static void test_exhausted (const mp_odrf_mpfr_root_fsolver_driver_t * T);
+
+/* Tests for the number of evaluations of the superlinear drivers. */
+static void test_evaluation_count (const mp_odrf_mpfr_root_fsolver_driver_t * T, int max_count);
+
 /* Trigonometric sine and minus  trigonometric sine functions wrapped to
    be used by the root bracketing  algorithms.  We know that the root is
    at zero. */
 static mp_odrf_mpfr_wrapped_f_t	sine_function;
 static mp_odrf_mpfr_wrapped_f_t	minus_sine_function;
+static mp_odrf_mpfr_wrapped_f_t	square_minus_two_function;
+/* Like the one above, counting the calls in an "int" referenced by the
+   parameters. */
+static mp_odrf_mpfr_wrapped_f_t	counted_square_minus_two_function;
+/* Like the one above, with the square rounded to the precision of Y: near
+   the root the sign is wrong at low precision. */
+static mp_odrf_mpfr_wrapped_f_t	rounded_square_minus_two_function;
+/* The cube is flat at its root, where false position stalls. */
+static mp_odrf_mpfr_wrapped_f_t	cube_function;
+
+/* Sign oracles for x^2 - 2: the first  rounds the square both ways at the
+   working precision, the second never decides. */
+static mp_odrf_mpfr_sign_f_t	square_minus_two_sign;
+static mp_odrf_mpfr_sign_f_t	uncertain_sign;
+static mp_odrf_mpfr_ball_f_t	square_minus_two_ball;
 
 
 /** --------------------------------------------------------------------
@@ -93,6 +142,95 @@ main (void)
   data.driver = mp_odrf_mpfr_root_fsolver_brent;
   doit(&data);
 
+  title("one dimensional root finding, itp algorithm");
+  data.driver = mp_odrf_mpfr_root_fsolver_itp;
+  doit(&data);
+
+  title("one dimensional root finding, ridders algorithm");
+  data.driver = mp_odrf_mpfr_root_fsolver_ridders;
+  doit(&data);
+
+  title("one dimensional root finding, illinois algorithm");
+  data.driver = mp_odrf_mpfr_root_fsolver_illinois;
+  doit(&data);
+
+  title("one dimensional root finding, pegasus algorithm");
+  data.driver = mp_odrf_mpfr_root_fsolver_pegasus;
+  doit(&data);
+
+  title("one dimensional root finding, anderson-bjorck algorithm");
+  data.driver = mp_odrf_mpfr_root_fsolver_anderson_bjorck;
+  doit(&data);
+
+  title("one dimensional root finding, toms748 algorithm");
+  data.driver = mp_odrf_mpfr_root_fsolver_toms748;
+  doit(&data);
+
+  title("one dimensional root finding, chandrupatla algorithm");
+  data.driver = mp_odrf_mpfr_root_fsolver_chandrupatla;
+  doit(&data);
+
+  title("one dimensional root finding, bisection sign algorithm");
+  data.driver = mp_odrf_mpfr_root_fsolver_bisection_sign;
+  doit(&data);
+  test_sign_oracle();
+  test_sign_oracle_uncertain();
+
+  title("ball functions");
+  test_ball(mp_odrf_mpfr_root_fsolver_bisection, 0);
+  test_ball(mp_odrf_mpfr_root_fsolver_falsepos,  0);
+  test_ball(mp_odrf_mpfr_root_fsolver_brent,     0);
+  test_ball(mp_odrf_mpfr_root_fsolver_bisection, 1);
+  test_ball(mp_odrf_mpfr_root_fsolver_brent,     1);
+
+  title("bracket exhaustion");
+  test_exhausted(mp_odrf_mpfr_root_fsolver_bisection);
+  test_exhausted(mp_odrf_mpfr_root_fsolver_bisection_sign);
+  test_exhausted(mp_odrf_mpfr_root_fsolver_falsepos);
+  test_exhausted(mp_odrf_mpfr_root_fsolver_brent);
+  test_exhausted(mp_odrf_mpfr_root_fsolver_itp);
+  test_exhausted(mp_odrf_mpfr_root_fsolver_ridders);
+  test_exhausted(mp_odrf_mpfr_root_fsolver_illinois);
+  test_exhausted(mp_odrf_mpfr_root_fsolver_pegasus);
+  test_exhausted(mp_odrf_mpfr_root_fsolver_anderson_bjorck);
+  test_exhausted(mp_odrf_mpfr_root_fsolver_toms748);
+  test_exhausted(mp_odrf_mpfr_root_fsolver_chandrupatla);
+
+  title("evaluation count");
+  test_evaluation_count(mp_odrf_mpfr_root_fsolver_brent,           20);
+  test_evaluation_count(mp_odrf_mpfr_root_fsolver_itp,             20);
+  test_evaluation_count(mp_odrf_mpfr_root_fsolver_ridders,         36);
+  test_evaluation_count(mp_odrf_mpfr_root_fsolver_illinois,        20);
+  test_evaluation_count(mp_odrf_mpfr_root_fsolver_pegasus,         20);
+  test_evaluation_count(mp_odrf_mpfr_root_fsolver_anderson_bjorck, 20);
+  test_evaluation_count(mp_odrf_mpfr_root_fsolver_toms748,         20);
+  test_evaluation_count(mp_odrf_mpfr_root_fsolver_chandrupatla,    20);
+
+  title("brent algorithm tolerance");
+  test_brent_high_precision();
+  test_brent_user_tolerance();
+
+  title("itp algorithm parameters");
+  test_itp_parameters();
+  test_itp_worst_case(0);
+  test_itp_worst_case(3);
+
+  title("adaptive precision");
+  test_adaptive_prec(mp_odrf_mpfr_root_fsolver_bisection, 0);
+  test_adaptive_prec(mp_odrf_mpfr_root_fsolver_falsepos,  0);
+  test_adaptive_prec(mp_odrf_mpfr_root_fsolver_brent,     0);
+  test_adaptive_prec(mp_odrf_mpfr_root_fsolver_bisection, 1);
+  test_adaptive_prec(mp_odrf_mpfr_root_fsolver_falsepos,  1);
+  test_adaptive_prec(mp_odrf_mpfr_root_fsolver_brent,     1);
+  test_adaptive_prec(mp_odrf_mpfr_root_fsolver_itp,       1);
+  test_adaptive_prec(mp_odrf_mpfr_root_fsolver_ridders,   0);
+  test_adaptive_prec(mp_odrf_mpfr_root_fsolver_pegasus,   1);
+  test_adaptive_prec(mp_odrf_mpfr_root_fsolver_toms748,   0);
+  test_adaptive_prec(mp_odrf_mpfr_root_fsolver_chandrupatla, 1);
+  test_adaptive_rounded(mp_odrf_mpfr_root_fsolver_bisection);
+  test_adaptive_rounded(mp_odrf_mpfr_root_fsolver_falsepos);
+  test_adaptive_rounded(mp_odrf_mpfr_root_fsolver_brent);
+
   exit(EXIT_SUCCESS);
 }
 
@@ -405,6 +543,530 @@ test_with_residual_criterion (bracket_meta_data_t data)
   fine();
 }
 
+
+/** --------------------------------------------------------------------
+ ** Brent tolerance.
+ ** ----------------------------------------------------------------- */
+
+static void
+test_brent_high_precision (void)
+/* With a tolerance bound to double precision the solver would step by
+   about 1e-16 once the bracket is that narrow, needing billions of
+   iterations to reach 1024 bits. */
+{
+  mp_odrf_mpfr_root_fsolver_t *	solver;
+  mpfr_t			epsrel;
+  int				count;
+  start("brent tolerance", "superlinear convergence at 1024 bits");
+  solver = mp_odrf_mpfr_root_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_brent, 1024);
+  if (NULL == solver) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_init2(epsrel, 1024);
+  mpfr_set_ui_2exp(epsrel, 1, -1000, GMP_RNDN);
+  count = solve_square_root_of_two(solver, epsrel, NULL);
+  validate((0 < count) && (count < 100), "converged in %d iterations", count);
+  mpfr_clear(epsrel);
+  mp_odrf_mpfr_root_fsolver_free(solver);
+  fine();
+}
+static void
+test_brent_user_tolerance (void)
+{
+  mp_odrf_mpfr_root_fsolver_t *	solver;
+  mpfr_t			tol, epsrel, expected;
+  int				rv, count;
+  start("brent tolerance", "user supplied tolerance");
+  solver = mp_odrf_mpfr_root_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_bisection, 256);
+  if (NULL == solver) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits2(256, tol, epsrel, expected, (mpfr_ptr)0);
+  mpfr_set_d(tol, 1e-30, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_brent_set_tolerance(solver, tol);
+  validate(MP_ODRF_ERROR_UNSUPPORTED_BY_DRIVER == rv, "wrong error code: %d", rv);
+  mp_odrf_mpfr_root_fsolver_free(solver);
+
+  solver = mp_odrf_mpfr_root_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_brent, 256);
+  if (NULL == solver) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_set_si(epsrel, -1, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_brent_set_tolerance(solver, epsrel);
+  validate(MP_ODRF_ERROR_ABSOLUTE_TOLERANCE_IS_NEGATIVE == rv, "wrong error code: %d", rv);
+  rv = mp_odrf_mpfr_root_fsolver_brent_set_tolerance(solver, tol);
+  validate(MP_ODRF_OK == rv, "wrong error code: %d", rv);
+  /* The requested relative  width is below the tolerance: the bracket
+     stops shrinking and the iterations run out. */
+  mpfr_set_ui_2exp(epsrel, 1, -200, GMP_RNDN);
+  count = solve_square_root_of_two(solver, epsrel, NULL);
+  validate(0 > count, "converged below the tolerance");
+  mpfr_sqrt_ui(expected, 2, GMP_RNDN);
+  mpfr_sub(expected, expected, mp_odrf_mpfr_root_fsolver_root(solver), GMP_RNDN);
+  validate(mpfr_cmpabs(expected, tol) <= 0, "root farther than the tolerance");
+  /* Going back to the default tolerance the solver converges. */
+  rv = mp_odrf_mpfr_root_fsolver_brent_set_tolerance(solver, NULL);
+  validate(MP_ODRF_OK == rv, "wrong error code: %d", rv);
+  count = solve_square_root_of_two(solver, epsrel, NULL);
+  validate(0 < count, "no convergence with the default tolerance");
+  /* The tolerance survives the changes of working precision of the
+     adaptive mode. */
+  rv = mp_odrf_mpfr_root_fsolver_set_adaptive_prec(solver, 32);
+  validate(MP_ODRF_OK == rv, "wrong error code: %d", rv);
+  rv = mp_odrf_mpfr_root_fsolver_brent_set_tolerance(solver, tol);
+  validate(MP_ODRF_OK == rv, "wrong error code: %d", rv);
+  count = solve_square_root_of_two(solver, epsrel, NULL);
+  validate(0 > count, "adaptive mode converged below the tolerance");
+  mpfr_sqrt_ui(expected, 2, GMP_RNDN);
+  mpfr_sub(expected, expected, mp_odrf_mpfr_root_fsolver_root(solver), GMP_RNDN);
+  validate(mpfr_cmpabs(expected, tol) <= 0, "root farther than the tolerance");
+  rv = mp_odrf_mpfr_root_fsolver_set_adaptive_prec(solver, 0);
+  validate(MP_ODRF_OK == rv, "wrong error code: %d", rv);
+  count = solve_square_root_of_two(solver, epsrel, NULL);
+  validate(0 > count, "fixed mode converged below the tolerance");
+  mpfr_clears(tol, epsrel, expected, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(solver);
+  fine();
+}
+
+
+/** --------------------------------------------------------------------
+ ** ITP parameters.
+ ** ----------------------------------------------------------------- */
+
+static void
+test_itp_parameters (void)
+/* Out of range parameters are rejected; with the defaults the solver
+   needs far fewer iterations than bisection at 256 bits. */
+{
+  mp_odrf_mpfr_root_fsolver_t *	solver;
+  mpfr_t			epsrel;
+  int				rv, count;
+  start("itp parameters", "range checks and default parameters");
+  solver = mp_odrf_mpfr_root_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_bisection, 256);
+  if (NULL == solver) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  rv = mp_odrf_mpfr_root_fsolver_itp_set_parameters(solver, 0.2, 2.0, 1);
+  validate(MP_ODRF_ERROR_UNSUPPORTED_BY_DRIVER == rv, "wrong error code: %d", rv);
+  mp_odrf_mpfr_root_fsolver_free(solver);
+
+  solver = mp_odrf_mpfr_root_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_itp, 256);
+  if (NULL == solver) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  rv = mp_odrf_mpfr_root_fsolver_itp_set_parameters(solver, 0.0, 2.0, 1);
+  validate(MP_ODRF_ERROR_INVALID_DRIVER_PARAMETER == rv, "wrong error code: %d", rv);
+  rv = mp_odrf_mpfr_root_fsolver_itp_set_parameters(solver, 0.2, 0.5, 1);
+  validate(MP_ODRF_ERROR_INVALID_DRIVER_PARAMETER == rv, "wrong error code: %d", rv);
+  rv = mp_odrf_mpfr_root_fsolver_itp_set_parameters(solver, 0.2, 3.0, 1);
+  validate(MP_ODRF_ERROR_INVALID_DRIVER_PARAMETER == rv, "wrong error code: %d", rv);
+  rv = mp_odrf_mpfr_root_fsolver_itp_set_parameters(solver, NAN, 2.0, 1);
+  validate(MP_ODRF_ERROR_INVALID_DRIVER_PARAMETER == rv, "wrong error code: %d", rv);
+  mpfr_init2(epsrel, 256);
+  mpfr_set_ui_2exp(epsrel, 1, -250, GMP_RNDN);
+  count = solve_square_root_of_two(solver, epsrel, NULL);
+  validate((0 < count) && (count < 25), "converged in %d iterations", count);
+  rv = mp_odrf_mpfr_root_fsolver_itp_set_parameters(solver, 0.1, 1.5, 2);
+  validate(MP_ODRF_OK == rv, "wrong error code: %d", rv);
+  count = solve_square_root_of_two(solver, epsrel, NULL);
+  validate((0 < count) && (count < 50), "converged in %d iterations", count);
+  mpfr_clear(epsrel);
+  mp_odrf_mpfr_root_fsolver_free(solver);
+  fine();
+}
+static void
+test_itp_worst_case (unsigned long n0)
+/* After J iterations from a bracket of width 1 the width must be at most
+   2^(N0 - J), even for a function on which false position stalls. */
+{
+  mp_odrf_mpfr_root_fsolver_t *	solver;
+  mp_odrf_mpfr_function_t	F = {
+    .function	= cube_function,
+    .params	= NULL
+  };
+  mpfr_t	x_lower, x_upper, width;
+  int		rv, j;
+  start("itp worst case", (n0)? "projection slack" : "no projection slack");
+  solver = mp_odrf_mpfr_root_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_itp, 128);
+  if (NULL == solver) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  rv = mp_odrf_mpfr_root_fsolver_itp_set_parameters(solver, 0.2, 2.0, n0);
+  validate(MP_ODRF_OK == rv, "wrong error code: %d", rv);
+  mpfr_inits2(128, x_lower, x_upper, width, (mpfr_ptr)0);
+  mpfr_set_d(x_lower, -0.25, GMP_RNDN);
+  mpfr_set_d(x_upper, +0.75, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_set(solver, &F, x_lower, x_upper);
+  validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+  for (j=1; (MP_ODRF_OK == rv) && (j <= 100); ++j) {
+    rv = mp_odrf_mpfr_root_fsolver_iterate(solver);
+    validate(MP_ODRF_OK == rv, "error iterating: %s", mp_odrf_strerror(rv));
+    mpfr_sub(width, mp_odrf_mpfr_root_fsolver_x_upper(solver),
+	     mp_odrf_mpfr_root_fsolver_x_lower(solver), GMP_RNDN);
+    validate(mpfr_cmp_si_2exp(width, 1, (long)n0 - j) <= 0,
+	     "bracket wider than 2^%ld after %d iterations", (long)n0 - j, j);
+  }
+  mpfr_clears(x_lower, x_upper, width, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(solver);
+  fine();
+}
+static void
+test_adaptive_prec (const mp_odrf_mpfr_root_fsolver_driver_t * T, int contiguous)
+/* Start at 32 bits and reach 512: the early evaluations of the function
+   must happen at low precision, the result must have full precision. */
+{
+  mp_odrf_mpfr_root_fsolver_t *	solver;
+  mpfr_t			epsrel, expected;
+  mp_prec_t			min_prec = 512;
+  int				rv, count;
+  void *			buffer = NULL;
+  start("adaptive precision", (contiguous)? "single memory block" : "separate blocks");
+  report("(%s) ", T->name);
+  if (contiguous) {
+    buffer = aligned_alloc(MP_ODRF_SOLVER_ALIGNMENT, mp_odrf_mpfr_root_fsolver_sizeof(T, 512));
+    solver = (buffer)? mp_odrf_mpfr_root_fsolver_init_in_place(buffer, T, 512) : NULL;
+  } else
+    solver = mp_odrf_mpfr_root_fsolver_alloc2(T, 512);
+  if (NULL == solver) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits2(512, epsrel, expected, (mpfr_ptr)0);
+  rv = mp_odrf_mpfr_root_fsolver_set_adaptive_prec(solver, 32);
+  validate(MP_ODRF_OK == rv, "wrong error code: %d", rv);
+  mpfr_set_ui_2exp(epsrel, 1, -500, GMP_RNDN);
+  count = solve_square_root_of_two(solver, epsrel, &min_prec);
+  validate(0 < count, "no convergence");
+  validate(32 == min_prec, "function evaluated at %ld bits at least", (long)min_prec);
+  validate(512 == mpfr_get_prec(mp_odrf_mpfr_root_fsolver_root(solver)), "wrong final precision");
+  mpfr_sqrt_ui(expected, 2, GMP_RNDN);
+  mpfr_reldiff(expected, expected, mp_odrf_mpfr_root_fsolver_root(solver), GMP_RNDN);
+  mpfr_mul_2ui(epsrel, epsrel, 1, GMP_RNDN);
+  validate(mpfr_cmpabs(expected, epsrel) <= 0, "inaccurate root");
+  /* Back to the fixed precision. */
+  rv = mp_odrf_mpfr_root_fsolver_set_adaptive_prec(solver, 0);
+  validate(MP_ODRF_OK == rv, "wrong error code: %d", rv);
+  min_prec = 512;
+  mpfr_set_ui_2exp(epsrel, 1, -500, GMP_RNDN);
+  count = solve_square_root_of_two(solver, epsrel, &min_prec);
+  validate((0 < count) && (512 == min_prec), "fixed precision not restored");
+  mpfr_clears(epsrel, expected, (mpfr_ptr)0);
+  if (contiguous) {
+    mp_odrf_mpfr_root_fsolver_fini_in_place(solver);
+    free(buffer);
+  } else
+    mp_odrf_mpfr_root_fsolver_free(solver);
+  fine();
+}
+static void
+test_adaptive_rounded (const mp_odrf_mpfr_root_fsolver_driver_t * T)
+/* Start at 32 bits and reach 256 with a function whose sign is wrong near
+   the root at low precision: when the precision is raised the bounds may
+   not straddle the root anymore. */
+{
+  mp_odrf_mpfr_function_t	F = {
+    .function	= rounded_square_minus_two_function,
+    .params	= NULL
+  };
+  mp_odrf_mpfr_root_fsolver_t *	solver;
+  mpfr_t			x_lower, x_upper, epsabs, epsrel, expected;
+  int				rv, i;
+  start("adaptive precision", "rounded function");
+  report("(%s) ", T->name);
+  solver = mp_odrf_mpfr_root_fsolver_alloc2(T, 256);
+  if (NULL == solver) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits2(256, x_lower, x_upper, epsabs, epsrel, expected, (mpfr_ptr)0);
+  rv = mp_odrf_mpfr_root_fsolver_set_adaptive_prec(solver, 32);
+  validate(MP_ODRF_OK == rv, "wrong error code: %d", rv);
+  mpfr_set_ui(x_lower, 1, GMP_RNDN);
+  mpfr_set_ui(x_upper, 2, GMP_RNDN);
+  mpfr_set_ui(epsabs,  0, GMP_RNDN);
+  mpfr_set_ui_2exp(epsrel, 1, -240, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_set(solver, &F, x_lower, x_upper);
+  validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+  for (i=0; (MP_ODRF_OK == rv) && (i < 1000); ++i) {
+    rv = mp_odrf_mpfr_root_fsolver_iterate(solver);
+    validate(MP_ODRF_OK == rv, "error iterating: %s", mp_odrf_strerror(rv));
+    if (MP_ODRF_OK != rv) break;
+    rv = mp_odrf_mpfr_root_test_interval(mp_odrf_mpfr_root_fsolver_x_lower(solver),
+					 mp_odrf_mpfr_root_fsolver_x_upper(solver),
+					 epsabs, epsrel);
+    if (MP_ODRF_CONTINUE == rv)
+      rv = MP_ODRF_OK;
+    else
+      break;
+  }
+  validate(MP_ODRF_OK == rv, "no convergence: %s", mp_odrf_strerror(rv));
+  mpfr_sqrt_ui(expected, 2, GMP_RNDN);
+  mpfr_reldiff(expected, expected, mp_odrf_mpfr_root_fsolver_root(solver), GMP_RNDN);
+  mpfr_mul_2ui(epsrel, epsrel, 1, GMP_RNDN);
+  validate(mpfr_cmpabs(expected, epsrel) <= 0, "inaccurate root");
+  mpfr_clears(x_lower, x_upper, epsabs, epsrel, expected, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(solver);
+  fine();
+}
+static int
+solve_square_root_of_two (mp_odrf_mpfr_root_fsolver_t * solver, mpfr_t epsrel,
+			  mp_prec_t * min_prec)
+/* Solve x^2 = 2 in [1, 2] until the bracket is narrower than EPSREL
+   times the root;  return the number of iterations,  or -1 if they
+   exceed a limit.  If MIN_PREC is not NULL: it is lowered to the least
+   precision at which the function is evaluated. */
+{
+  mp_odrf_mpfr_function_t	F = {
+    .function	= square_minus_two_function,
+    .params	= min_prec
+  };
+  mpfr_t	x_lower, x_upper, epsabs;
+  int		rv, count = -1, i;
+  mpfr_inits2(mpfr_get_prec(epsrel), x_lower, x_upper, epsabs, (mpfr_ptr)0);
+  mpfr_set_ui(x_lower, 1, GMP_RNDN);
+  mpfr_set_ui(x_upper, 2, GMP_RNDN);
+  mpfr_set_ui(epsabs,  0, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_set(solver, &F, x_lower, x_upper);
+  validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+  for (i=1; (MP_ODRF_OK == rv) && (i <= 1000); ++i) {
+    rv = mp_odrf_mpfr_root_fsolver_iterate(solver);
+    validate(MP_ODRF_OK == rv, "error iterating: %s", mp_odrf_strerror(rv));
+    if (MP_ODRF_OK != rv) break;
+    rv = mp_odrf_mpfr_root_test_interval(mp_odrf_mpfr_root_fsolver_x_lower(solver),
+					 mp_odrf_mpfr_root_fsolver_x_upper(solver),
+					 epsabs, epsrel);
+    if (MP_ODRF_OK == rv) {
+      count = i;
+      break;
+    } else if (MP_ODRF_CONTINUE == rv)
+      rv = MP_ODRF_OK;
+    else
+      error(mp_odrf_strerror(rv));
+  }
+  mpfr_clears(x_lower, x_upper, epsabs, (mpfr_ptr)0);
+  return count;
+}
+static void
+test_sign_oracle (void)
+/* Find the square root of 2 at 256 bits only asking for signs: the far
+   ones must be decided at the starting precision of 32 bits. */
+{
+  mp_odrf_mpfr_root_fsolver_t *	solver;
+  sign_record_t			record = { 256, 0, 0 };
+  mp_odrf_mpfr_function_t	F = {
+    .function	= NULL,
+    .params	= &record,
+    .hinted	= NULL,
+    .sign	= square_minus_two_sign
+  };
+  mpfr_t	x_lower, x_upper, epsabs, epsrel, expected;
+  int		rv, i;
+  start("sign oracle", "square root of two at 256 bits");
+  solver = mp_odrf_mpfr_root_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_bisection_sign, 256);
+  if (NULL == solver) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits2(256, x_lower, x_upper, epsabs, epsrel, expected, (mpfr_ptr)0);
+  mpfr_set_ui(x_lower, 1, GMP_RNDN);
+  mpfr_set_ui(x_upper, 2, GMP_RNDN);
+  mpfr_set_ui(epsabs,  0, GMP_RNDN);
+  mpfr_set_ui_2exp(epsrel, 1, -240, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_set(solver, &F, x_lower, x_upper);
+  validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+  for (i=0; (MP_ODRF_OK == rv) && (i < 1000); ++i) {
+    rv = mp_odrf_mpfr_root_fsolver_iterate(solver);
+    validate(MP_ODRF_OK == rv, "error iterating: %s", mp_odrf_strerror(rv));
+    if (MP_ODRF_OK != rv) break;
+    rv = mp_odrf_mpfr_root_test_interval(mp_odrf_mpfr_root_fsolver_x_lower(solver),
+					 mp_odrf_mpfr_root_fsolver_x_upper(solver),
+					 epsabs, epsrel);
+    if (MP_ODRF_CONTINUE == rv)
+      rv = MP_ODRF_OK;
+    else
+      break;
+  }
+  validate(MP_ODRF_OK == rv, "no convergence: %s", mp_odrf_strerror(rv));
+  validate(32 == record.min_prec, "oracle asked at %ld bits at least", (long)record.min_prec);
+  validate(record.full_count < record.count / 2,
+	   "%d of %d signs at full precision", record.full_count, record.count);
+  mpfr_sqrt_ui(expected, 2, GMP_RNDN);
+  mpfr_reldiff(expected, expected, mp_odrf_mpfr_root_fsolver_root(solver), GMP_RNDN);
+  validate(mpfr_cmpabs(expected, epsrel) <= 0, "inaccurate root");
+  mpfr_clears(x_lower, x_upper, epsabs, epsrel, expected, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(solver);
+  fine();
+}
+static void
+test_ball (const mp_odrf_mpfr_root_fsolver_driver_t * T, int adaptive)
+/* Iterate with no  stop criterion at 128 bits: the solve must end  when a
+   sign becomes uncertain, with a bracket proven to contain the root. */
+{
+  mp_odrf_mpfr_root_fsolver_t *	solver;
+  mp_odrf_mpfr_function_t	F = {
+    .function	= square_minus_two_function,
+    .params	= NULL,
+    .hinted	= NULL,
+    .sign	= NULL,
+    .ball	= square_minus_two_ball
+  };
+  mpfr_t	x_lower, x_upper, square, width;
+  int		rv, i;
+  start("ball function", (adaptive)? "adaptive precision" : "fixed precision");
+  report("(%s) ", T->name);
+  solver = mp_odrf_mpfr_root_fsolver_alloc2(T, 128);
+  if (NULL == solver) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  if (adaptive)
+    mp_odrf_mpfr_root_fsolver_set_adaptive_prec(solver, 32);
+  mpfr_inits2(128, x_lower, x_upper, width, (mpfr_ptr)0);
+  mpfr_init2(square, 256);
+  mpfr_set_ui(x_lower, 1, GMP_RNDN);
+  mpfr_set_ui(x_upper, 2, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_set(solver, &F, x_lower, x_upper);
+  validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+  for (i=0; (MP_ODRF_OK == rv) && (i < 1000); ++i)
+    rv = mp_odrf_mpfr_root_fsolver_iterate(solver);
+  validate(MP_ODRF_ERROR_SIGN_IS_UNCERTAIN == rv, "expected %s, got %s",
+	   mp_odrf_strerror(MP_ODRF_ERROR_SIGN_IS_UNCERTAIN), mp_odrf_strerror(rv));
+  validate(128 == mpfr_get_prec(mp_odrf_mpfr_root_fsolver_root(solver)), "wrong final precision");
+  /* The squares are exact at 256 bits. */
+  mpfr_sqr(square, mp_odrf_mpfr_root_fsolver_x_lower(solver), GMP_RNDN);
+  validate(mpfr_cmp_ui(square, 2) < 0, "lower bound not below the root");
+  mpfr_sqr(square, mp_odrf_mpfr_root_fsolver_x_upper(solver), GMP_RNDN);
+  validate(mpfr_cmp_ui(square, 2) > 0, "upper bound not above the root");
+  mpfr_sub(width, mp_odrf_mpfr_root_fsolver_x_upper(solver),
+	   mp_odrf_mpfr_root_fsolver_x_lower(solver), GMP_RNDN);
+  validate(mpfr_cmp_d(width, 0x1p-100) < 0, "bracket too wide");
+  mpfr_clears(x_lower, x_upper, square, width, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(solver);
+  fine();
+}
+static void
+test_exhausted (const mp_odrf_mpfr_root_fsolver_driver_t * T)
+/* Iterate with no stop criterion at 64 bits: the solve must end when the
+   bounds are adjacent, and iterating again must not evaluate. */
+{
+  mp_odrf_mpfr_root_fsolver_t *	solver;
+  int				count = 0;
+  mp_odrf_mpfr_function_t	F = {
+    .function	= counted_square_minus_two_function,
+    .params	= &count,
+    .hinted	= NULL,
+    .sign	= NULL,
+    .ball	= NULL
+  };
+  mpfr_t	x_lower, x_upper;
+  mpfr_ptr	root;
+  int		rv, i;
+  start("bracket exhaustion", "square root of two");
+  report("(%s) ", T->name);
+  solver = mp_odrf_mpfr_root_fsolver_alloc2(T, 64);
+  if (NULL == solver) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits2(64, x_lower, x_upper, (mpfr_ptr)0);
+  mpfr_set_ui(x_lower, 1, GMP_RNDN);
+  mpfr_set_ui(x_upper, 2, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_set(solver, &F, x_lower, x_upper);
+  validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+  for (i=0; (MP_ODRF_OK == rv) && (i < 1000); ++i)
+    rv = mp_odrf_mpfr_root_fsolver_iterate(solver);
+  validate(MP_ODRF_BRACKET_EXHAUSTED == rv, "expected %s, got %s",
+	   mp_odrf_strerror(MP_ODRF_BRACKET_EXHAUSTED), mp_odrf_strerror(rv));
+  mpfr_set(x_lower, mp_odrf_mpfr_root_fsolver_x_lower(solver), GMP_RNDN);
+  mpfr_nextabove(x_lower);
+  validate(mpfr_equal_p(x_lower, mp_odrf_mpfr_root_fsolver_x_upper(solver)),
+	   "bounds not adjacent");
+  root = mp_odrf_mpfr_root_fsolver_root(solver);
+  validate(mpfr_equal_p(root, mp_odrf_mpfr_root_fsolver_x_lower(solver)) ||
+	   mpfr_equal_p(root, mp_odrf_mpfr_root_fsolver_x_upper(solver)),
+	   "root is not a bound");
+  i  = count;
+  rv = mp_odrf_mpfr_root_fsolver_iterate(solver);
+  validate(MP_ODRF_BRACKET_EXHAUSTED == rv, "exhaustion not repeated");
+  validate(i == count, "function evaluated after exhaustion");
+  mpfr_clears(x_lower, x_upper, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(solver);
+  fine();
+}
+static void
+test_evaluation_count (const mp_odrf_mpfr_root_fsolver_driver_t * T, int max_count)
+/* Solve x^2 = 2 at 256 bits until the bracket is exhausted: the false
+   position algorithm needs hundreds of evaluations, being stuck on the
+   upper bound. */
+{
+  mp_odrf_mpfr_root_fsolver_t *	solver;
+  int				count = 0;
+  mp_odrf_mpfr_function_t	F = {
+    .function	= counted_square_minus_two_function,
+    .params	= &count
+  };
+  mpfr_t	x_lower, x_upper;
+  int		rv, i;
+  start("evaluation count", "square root of two at 256 bits");
+  report("(%s) ", T->name);
+  solver = mp_odrf_mpfr_root_fsolver_alloc2(T, 256);
+  if (NULL == solver) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits2(256, x_lower, x_upper, (mpfr_ptr)0);
+  mpfr_set_ui(x_lower, 1, GMP_RNDN);
+  mpfr_set_ui(x_upper, 2, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_set(solver, &F, x_lower, x_upper);
+  validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+  for (i=0; (MP_ODRF_OK == rv) && (i < 1000); ++i)
+    rv = mp_odrf_mpfr_root_fsolver_iterate(solver);
+  validate(MP_ODRF_BRACKET_EXHAUSTED == rv, "expected %s, got %s",
+	   mp_odrf_strerror(MP_ODRF_BRACKET_EXHAUSTED), mp_odrf_strerror(rv));
+  validate(count <= max_count, "%d evaluations", count);
+  mpfr_clears(x_lower, x_upper, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(solver);
+  fine();
+}
+static void
+test_sign_oracle_uncertain (void)
+/* A sign that cannot be decided at the solver's precision is an error. */
+{
+  mp_odrf_mpfr_root_fsolver_t *	solver;
+  sign_record_t			record = { 128, 0, 0 };
+  mp_odrf_mpfr_function_t	F = {
+    .function	= NULL,
+    .params	= &record,
+    .hinted	= NULL,
+    .sign	= uncertain_sign
+  };
+  mpfr_t	x_lower, x_upper;
+  int		rv;
+  start("sign oracle", "uncertain sign");
+  solver = mp_odrf_mpfr_root_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_bisection_sign, 128);
+  if (NULL == solver) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits2(128, x_lower, x_upper, (mpfr_ptr)0);
+  mpfr_set_ui(x_lower, 1, GMP_RNDN);
+  mpfr_set_ui(x_upper, 2, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_set(solver, &F, x_lower, x_upper);
+  validate(MP_ODRF_ERROR_SIGN_IS_UNCERTAIN == rv, "wrong error code: %d", rv);
+  /* Asked at 32, 64 and 128 bits. */
+  validate(3 == record.count, "oracle called %d times", record.count);
+  mpfr_clears(x_lower, x_upper, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(solver);
+  fine();
+}
+
 
 /** --------------------------------------------------------------------
  ** Math functions.
@@ -426,5 +1088,93 @@ minus_sine_function (mpfr_t y, mpfr_t x, void * params_ MP_ODRF_UNUSED)
   mpfr_neg(y, y, GMP_RNDN);
   return MP_ODRF_OK;
 }
+static int
+square_minus_two_function (mpfr_t y, mpfr_t x, void * params_)
+/* The square is  computed exactly, so the sign of  the result is right
+   whatever the precision of Y. */
+{
+  mp_prec_t *	min_prec = params_;
+  mpfr_t	t;
+  if (min_prec && (mpfr_get_prec(y) < *min_prec))
+    *min_prec = mpfr_get_prec(y);
+  mpfr_init2(t, 2 * mpfr_get_prec(x));
+  mpfr_sqr(t, x, GMP_RNDN);
+  mpfr_sub_ui(y, t, 2, GMP_RNDN);
+  mpfr_clear(t);
+  return MP_ODRF_OK;
+}
+static int
+rounded_square_minus_two_function (mpfr_t y, mpfr_t x, void * params_ MP_ODRF_UNUSED)
+{
+  mpfr_sqr(y, x, GMP_RNDN);
+  mpfr_sub_ui(y, y, 2, GMP_RNDN);
+  return MP_ODRF_OK;
+}
+static int
+cube_function (mpfr_t y, mpfr_t x, void * params_ MP_ODRF_UNUSED)
+{
+  mpfr_pow_ui(y, x, 3, GMP_RNDN);
+  return MP_ODRF_OK;
+}
+static int
+counted_square_minus_two_function (mpfr_t y, mpfr_t x, void * params_)
+{
+  int *	count = params_;
+  ++(*count);
+  return square_minus_two_function(y, x, NULL);
+}
+static int
+square_minus_two_sign (int * sign, mpfr_ptr x, mp_prec_t prec, void * params_)
+{
+  sign_record_t *	record = params_;
+  mpfr_t		lo, hi;
+  ++(record->count);
+  if (mpfr_get_prec(x) == prec)
+    ++(record->full_count);
+  if (prec < record->min_prec)
+    record->min_prec = prec;
+  mpfr_inits2(prec, lo, hi, (mpfr_ptr)0);
+  mpfr_sqr(lo, x, GMP_RNDD);
+  mpfr_sqr(hi, x, GMP_RNDU);
+  if (mpfr_cmp_ui(lo, 2) > 0)
+    *sign = +1;
+  else if (mpfr_cmp_ui(hi, 2) < 0)
+    *sign = -1;
+  else if (mpfr_equal_p(lo, hi))
+    *sign = 0;
+  else
+    *sign = MP_ODRF_SIGN_UNCERTAIN;
+  mpfr_clears(lo, hi, (mpfr_ptr)0);
+  return MP_ODRF_OK;
+}
+static int
+square_minus_two_ball (mpfr_ptr mid, mpfr_ptr rad, mpfr_ptr x, void * params_ MP_ODRF_UNUSED)
+/* Two roundings  to nearest at the  precision of MID: the error  is at
+   most half a unit in the last place of each result. */
+{
+  mp_prec_t	prec = mpfr_get_prec(mid);
+  mpfr_t	t;
+  mpfr_init2(t, prec);
+  mpfr_sqr(t, x, GMP_RNDN);
+  mpfr_sub_ui(mid, t, 2, GMP_RNDN);
+  mpfr_set_ui_2exp(rad, 1, mpfr_get_exp(t) - prec - 1, GMP_RNDU);
+  if (! mpfr_zero_p(mid)) {
+    mpfr_t	half_ulp;
+    mpfr_init2(half_ulp, 2);
+    mpfr_set_ui_2exp(half_ulp, 1, mpfr_get_exp(mid) - prec - 1, GMP_RNDU);
+    mpfr_add(rad, rad, half_ulp, GMP_RNDU);
+    mpfr_clear(half_ulp);
+  }
+  mpfr_clear(t);
+  return MP_ODRF_OK;
+}
+static int
+uncertain_sign (int * sign, mpfr_ptr x MP_ODRF_UNUSED, mp_prec_t prec MP_ODRF_UNUSED, void * params_)
+{
+  sign_record_t *	record = params_;
+  ++(record->count);
+  *sign = MP_ODRF_SIGN_UNCERTAIN;
+  return MP_ODRF_OK;
+}
 
 /* end of file */
@@ -63,6 +63,18 @@ static void subdoit (polish_meta_data_t data);
 static void test_with_delta_criterion (polish_meta_data_t data);
 static void test_with_residual_criterion (polish_meta_data_t data);
 
+/* Solve at high precision with  the newton doubling driver, checking the
+   precision at which the function is evaluated. */
+static void test_newton_doubling (int contiguous);
+
+/* Record the precisions at which "counting_sine_and_cosine_function()" is
+   evaluated. */
+typedef struct {
+  mp_prec_t	final_prec;
+  mp_prec_t	min_prec;
+  int		final_count;
+} eval_counter_t;
+
 /* Trigonometric sine function wrapped to  be used by the root polishing
    algorithm.  This is the target function;  we know that the root is at
    zero. */
@@ -77,6 +89,7 @@ static mp_odrf_mpfr_wrapped_f_t		cosine_function;
    root  polishing algorithm.   This function  computes both  the target
    function and its derivative. */
 static mp_odrf_mpfr_wrapped_fdf_t	sine_and_cosine_function;
+static mp_odrf_mpfr_wrapped_fdf_t	counting_sine_and_cosine_function;
 
 
 /** --------------------------------------------------------------------
@@ -105,6 +118,12 @@ main (void)
   data.driver = mp_odrf_mpfr_root_fdfsolver_steffenson;
   doit(&data);
 
+  title("one dimensional root finding, newton doubling algorithm");
+  data.driver = mp_odrf_mpfr_root_fdfsolver_newton_doubling;
+  doit(&data);
+  test_newton_doubling(0);
+  test_newton_doubling(1);
+
   exit(EXIT_SUCCESS);
 }
 
@@ -310,6 +329,74 @@ test_with_residual_criterion (polish_meta_data_t data)
   fine();
 }
 
+
+/** --------------------------------------------------------------------
+ ** Precision doubling.
+ ** ----------------------------------------------------------------- */
+
+static void
+test_newton_doubling (int contiguous)
+/* Find pi as root of the sine at 20000 bits starting from 3. */
+{
+  const mp_prec_t			prec = 20000;
+  mp_odrf_mpfr_root_fdfsolver_t *	solver;
+  mpfr_t				guess, x1, epsabs, epsrel, pi;
+  eval_counter_t			counter = { prec, prec, 0 };
+  int					rv, i;
+  void *				buffer = NULL;
+  mp_odrf_mpfr_function_fdf_t	FDF = {
+    .f		= sine_function,
+    .df		= cosine_function,
+    .fdf	= counting_sine_and_cosine_function,
+    .params	= &counter
+  };
+  start("precision doubling", (contiguous)? "single memory block" : "separate blocks");
+  if (contiguous) {
+    const mp_odrf_mpfr_root_fdfsolver_driver_t *	T = mp_odrf_mpfr_root_fdfsolver_newton_doubling;
+    buffer = aligned_alloc(MP_ODRF_SOLVER_ALIGNMENT, mp_odrf_mpfr_root_fdfsolver_sizeof(T, prec));
+    solver = (buffer)? mp_odrf_mpfr_root_fdfsolver_init_in_place(buffer, T, prec) : NULL;
+  } else
+    solver = mp_odrf_mpfr_root_fdfsolver_alloc2(mp_odrf_mpfr_root_fdfsolver_newton_doubling, prec);
+  if (NULL == solver) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits2(prec, guess, x1, epsabs, epsrel, pi, (mpfr_ptr)0);
+  mpfr_set_ui(guess, 3, GMP_RNDN);
+  mpfr_set_ui(x1,    3, GMP_RNDN);
+  mpfr_set_ui(epsabs, 0, GMP_RNDN);
+  mpfr_set_ui_2exp(epsrel, 1, 10 - prec, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fdfsolver_set(solver, &FDF, guess);
+  validate(MP_ODRF_OK == rv, "error setting: %s", mp_odrf_strerror(rv));
+  for (i=0; (MP_ODRF_OK == rv) && (i < 100); ++i) {
+    rv = mp_odrf_mpfr_root_fdfsolver_iterate(solver);
+    validate(MP_ODRF_OK == rv, "error iterating: %s", mp_odrf_strerror(rv));
+    if (MP_ODRF_OK != rv) break;
+    rv = mp_odrf_mpfr_root_test_delta(x1, mp_odrf_mpfr_root_fdfsolver_root(solver),
+				      epsabs, epsrel);
+    if (MP_ODRF_CONTINUE == rv) {
+      mpfr_set(x1, mp_odrf_mpfr_root_fdfsolver_root(solver), GMP_RNDN);
+      rv = MP_ODRF_OK;
+    } else
+      break;
+  }
+  validate(MP_ODRF_OK == rv, "no convergence: %s", mp_odrf_strerror(rv));
+  validate(53 == counter.min_prec, "first evaluation at %ld bits", (long)counter.min_prec);
+  /* The solve ends with  the evaluation reaching full precision and the
+     one detecting convergence. */
+  validate(counter.final_count <= 3, "%d evaluations at full precision", counter.final_count);
+  mpfr_const_pi(pi, GMP_RNDN);
+  mpfr_reldiff(pi, pi, mp_odrf_mpfr_root_fdfsolver_root(solver), GMP_RNDN);
+  validate(mpfr_cmpabs(pi, epsrel) <= 0, "inaccurate root");
+  mpfr_clears(guess, x1, epsabs, epsrel, pi, (mpfr_ptr)0);
+  if (contiguous) {
+    mp_odrf_mpfr_root_fdfsolver_fini_in_place(solver);
+    free(buffer);
+  } else
+    mp_odrf_mpfr_root_fdfsolver_free(solver);
+  fine();
+}
+
 
 /** --------------------------------------------------------------------
  ** Math functions.
@@ -338,5 +425,15 @@ sine_and_cosine_function (mpfr_t dy, mpfr_t y, mpfr_t x,
   mpfr_cos(dy, x, GMP_RNDN);
   return MP_ODRF_OK;
 }
+static int
+counting_sine_and_cosine_function (mpfr_t dy, mpfr_t y, mpfr_t x, void * params_)
+{
+  eval_counter_t *	counter = params_;
+  if (mpfr_get_prec(y) < counter->min_prec)
+    counter->min_prec = mpfr_get_prec(y);
+  if (mpfr_get_prec(y) == counter->final_prec)
+    ++(counter->final_count);
+  return sine_and_cosine_function(dy, y, x, NULL);
+}
 
 /* end of file */
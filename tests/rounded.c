@@ -0,0 +1,338 @@
+/*
+   Part of: Multiple Precision One-Dimensional Root-Finding
+   Contents: tests for the correctly rounded roots
+   Date: Fri Oct 16, 2026
+
+   Abstract
+
+	Tests  for the  solves  storing the root  correctly  rounded to  the
+	precision of the output, with the ternary value of MPFR.
+
+   Copyright (c) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+   This program is free software:  you can redistribute it and/or modify
+   it under the terms of the  GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at
+   your option) any later version.
+
+   This program is  distributed in the hope that it  will be useful, but
+   WITHOUT  ANY   WARRANTY;  without   even  the  implied   warranty  of
+   MERCHANTABILITY  or FITNESS FOR  A PARTICULAR  PURPOSE.  See  the GNU
+   General Public License for more details.
+
+   You should  have received a  copy of  the GNU General  Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#define DEBUGGING		0
+#include <mp-odrf.h>
+#include <test.h>
+#include <debug.h>
+
+/* The precision of the solvers and the one of the rounded roots. */
+#define PREC		256
+#define TARGET		53
+
+/* Record the highest precision the function is evaluated at. */
+typedef struct {
+  mp_prec_t	max_prec;
+} prec_record_t;
+
+static void test_square_root	(const mp_odrf_mpfr_root_fsolver_driver_t * T, mp_rnd_t rnd);
+static void test_exact_root	(const mp_odrf_mpfr_root_fsolver_driver_t * T);
+static void test_hard_case	(mp_prec_t prec);
+static void test_arena		(const mp_odrf_mpfr_root_fsolver_driver_t * T);
+static void test_minimum_step	(void);
+
+static int  sign_of		(int ternary);
+
+static mp_odrf_mpfr_wrapped_f_t	square_minus_two_function;
+static mp_odrf_mpfr_wrapped_f_t	minus_constant_function;
+
+static const mp_rnd_t	rounding_modes[] = { GMP_RNDN, GMP_RNDZ, GMP_RNDU, GMP_RNDD };
+static const char *	rounding_names[] = { "RNDN", "RNDZ", "RNDU", "RNDD" };
+
+
+/** --------------------------------------------------------------------
+ ** Main.
+ ** ----------------------------------------------------------------- */
+
+int
+main (void)
+{
+  int	i;
+
+  title("correctly rounded square root of two");
+  for (i=0; i<4; ++i) {
+    subtitle("rounding mode %s", rounding_names[i]);
+    test_square_root(mp_odrf_mpfr_root_fsolver_bisection,      rounding_modes[i]);
+    test_square_root(mp_odrf_mpfr_root_fsolver_bisection_sign, rounding_modes[i]);
+    test_square_root(mp_odrf_mpfr_root_fsolver_falsepos,       rounding_modes[i]);
+    test_square_root(mp_odrf_mpfr_root_fsolver_brent,          rounding_modes[i]);
+    test_square_root(mp_odrf_mpfr_root_fsolver_itp,            rounding_modes[i]);
+    test_square_root(mp_odrf_mpfr_root_fsolver_ridders,        rounding_modes[i]);
+    test_square_root(mp_odrf_mpfr_root_fsolver_illinois,       rounding_modes[i]);
+    test_square_root(mp_odrf_mpfr_root_fsolver_pegasus,        rounding_modes[i]);
+    test_square_root(mp_odrf_mpfr_root_fsolver_anderson_bjorck, rounding_modes[i]);
+    test_square_root(mp_odrf_mpfr_root_fsolver_toms748,        rounding_modes[i]);
+    test_square_root(mp_odrf_mpfr_root_fsolver_chandrupatla,   rounding_modes[i]);
+  }
+
+  title("correctly rounded exact root");
+  test_exact_root(mp_odrf_mpfr_root_fsolver_bisection);
+  test_exact_root(mp_odrf_mpfr_root_fsolver_falsepos);
+  test_exact_root(mp_odrf_mpfr_root_fsolver_brent);
+
+  title("correctly rounded hard case");
+  test_hard_case(16);
+  test_hard_case(40);
+
+  title("correctly rounded root with an arena");
+  test_arena(mp_odrf_mpfr_root_fsolver_bisection);
+  test_arena(mp_odrf_mpfr_root_fsolver_brent);
+
+  title("correctly rounded root with a minimum step");
+  test_minimum_step();
+
+  exit(EXIT_SUCCESS);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Tests.
+ ** ----------------------------------------------------------------- */
+
+static void
+test_square_root (const mp_odrf_mpfr_root_fsolver_driver_t * T, mp_rnd_t rnd)
+/* The result must be the one of "mpfr_sqrt()", computed with much less
+   than twice the target precision. */
+{
+  prec_record_t			record = { 0 };
+  mp_odrf_mpfr_function_t	F = {
+    .function	= square_minus_two_function,
+    .params	= &record
+  };
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  mpfr_t			x_lower, x_upper, rop, expected;
+  int				rv, ternary, expected_ternary;
+  start("square root", T->name);
+  S = mp_odrf_mpfr_root_fsolver_alloc2(T, PREC);
+  if (NULL == S) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits2(PREC, x_lower, x_upper, (mpfr_ptr)0);
+  mpfr_inits2(TARGET, rop, expected, (mpfr_ptr)0);
+  mpfr_set_ui(x_lower, 1, GMP_RNDN);
+  mpfr_set_ui(x_upper, 2, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_solve_rounded(S, &F, x_lower, x_upper, rop, &ternary, rnd);
+  validate(MP_ODRF_OK == rv, "error solving: %s", mp_odrf_strerror(rv));
+  expected_ternary = mpfr_sqrt_ui(expected, 2, rnd);
+  validate(mpfr_equal_p(expected, rop), "wrong root %.20RNf", rop);
+  validate(sign_of(expected_ternary) == sign_of(ternary), "wrong ternary value %d", ternary);
+  validate(record.max_prec < 2 * TARGET, "evaluated at %ld bits", (long)record.max_prec);
+  mpfr_clears(x_lower, x_upper, rop, expected, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(S);
+  fine();
+}
+static void
+test_exact_root (const mp_odrf_mpfr_root_fsolver_driver_t * T)
+/* The root 3/4 is found exactly, so the ternary value is zero. */
+{
+  mpfr_t			constant;
+  mp_odrf_mpfr_function_t	F = {
+    .function	= minus_constant_function,
+    .params	= constant
+  };
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  mpfr_t			x_lower, x_upper, rop;
+  int				rv, ternary;
+  start("exact root", T->name);
+  S = mp_odrf_mpfr_root_fsolver_alloc2(T, PREC);
+  if (NULL == S) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits2(PREC, constant, x_lower, x_upper, (mpfr_ptr)0);
+  mpfr_init2(rop, TARGET);
+  mpfr_set_d(constant, 0.75, GMP_RNDN);
+  mpfr_set_ui(x_lower, 0, GMP_RNDN);
+  mpfr_set_ui(x_upper, 1, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_solve_rounded(S, &F, x_lower, x_upper, rop, &ternary, GMP_RNDN);
+  validate(MP_ODRF_OK == rv, "error solving: %s", mp_odrf_strerror(rv));
+  validate(0 == mpfr_cmp_d(rop, 0.75), "wrong root %.20RNf", rop);
+  validate(0 == ternary, "wrong ternary value %d", ternary);
+  mpfr_clears(constant, x_lower, x_upper, rop, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(S);
+  fine();
+}
+static void
+test_hard_case (mp_prec_t prec)
+/* The root 1 + 2^-8 + 2^-30 is very close to the middle of two numbers
+   with 8 bits, so rounding to the nearest needs more than 30 bits. */
+{
+  mpfr_t			constant;
+  mp_odrf_mpfr_function_t	F = {
+    .function	= minus_constant_function,
+    .params	= constant
+  };
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  mpfr_t			x_lower, x_upper, rop;
+  int				rv, ternary;
+  start("hard case", (prec < 30)? "low solver precision" : "high solver precision");
+  S = mp_odrf_mpfr_root_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_bisection, prec);
+  if (NULL == S) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_init2(constant, 64);
+  mpfr_inits2(prec, x_lower, x_upper, (mpfr_ptr)0);
+  mpfr_init2(rop, 8);
+  mpfr_set_ui_2exp(constant, 1, -30, GMP_RNDN);
+  mpfr_add_d(constant, constant, 1.00390625, GMP_RNDN);
+  mpfr_set_ui(x_lower, 1, GMP_RNDN);
+  mpfr_set_ui(x_upper, 2, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_solve_rounded(S, &F, x_lower, x_upper, rop, &ternary, GMP_RNDN);
+  if (prec < 30) {
+    validate(MP_ODRF_ERROR_ROUNDING_IS_UNDECIDED == rv, "expected %s, got %s",
+	     mp_odrf_strerror(MP_ODRF_ERROR_ROUNDING_IS_UNDECIDED), mp_odrf_strerror(rv));
+  } else {
+    validate(MP_ODRF_OK == rv, "error solving: %s", mp_odrf_strerror(rv));
+    validate(0 == mpfr_cmp_d(rop, 1.0078125), "wrong root %.20RNf", rop);
+    validate(0 < ternary, "wrong ternary value %d", ternary);
+  }
+  mpfr_clears(constant, x_lower, x_upper, rop, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(S);
+  fine();
+}
+static void
+test_arena (const mp_odrf_mpfr_root_fsolver_driver_t * T)
+/* The root 1 + 2^-53 + 2^-100 needs more than 100 bits to be rounded to
+   53: the working precision is raised  beyond one limb, and the limbs
+   must not come from the arena. */
+{
+  mpfr_t			constant;
+  mp_odrf_mpfr_function_t	F = {
+    .function	= minus_constant_function,
+    .params	= constant
+  };
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  mp_odrf_arena_t *		arena;
+  mpfr_t			x_lower, x_upper, rop, expected;
+  int				rv, ternary;
+  start("arena", T->name);
+  arena	= mp_odrf_arena_alloc(1 << 16);
+  S	= mp_odrf_mpfr_root_fsolver_alloc2(T, PREC);
+  if ((NULL == arena) || (NULL == S)) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mp_odrf_mpfr_root_fsolver_set_arena(S, arena);
+  mpfr_inits2(PREC, constant, x_lower, x_upper, (mpfr_ptr)0);
+  mpfr_inits2(TARGET, rop, expected, (mpfr_ptr)0);
+  mpfr_set_ui_2exp(constant, 1, -100, GMP_RNDN);
+  mpfr_add_ui(constant, constant, 1, GMP_RNDN);
+  mpfr_set_ui_2exp(expected, 1, -53, GMP_RNDN);
+  mpfr_add(constant, constant, expected, GMP_RNDN);
+  mpfr_set_ui_2exp(expected, 1, -52, GMP_RNDN);
+  mpfr_add_ui(expected, expected, 1, GMP_RNDN);
+  mpfr_set_ui(x_lower, 1, GMP_RNDN);
+  mpfr_set_ui(x_upper, 2, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_solve_rounded(S, &F, x_lower, x_upper, rop, &ternary, GMP_RNDN);
+  validate(MP_ODRF_OK == rv, "error solving: %s", mp_odrf_strerror(rv));
+  validate(mpfr_equal_p(expected, rop), "wrong root %.20RNf", rop);
+  validate(0 < ternary, "wrong ternary value %d", ternary);
+  /* Solve again from the starting precision. */
+  rv = mp_odrf_mpfr_root_fsolver_solve_rounded(S, &F, x_lower, x_upper, rop, &ternary, GMP_RNDN);
+  validate(MP_ODRF_OK == rv, "error solving: %s", mp_odrf_strerror(rv));
+  validate(mpfr_equal_p(expected, rop), "wrong root %.20RNf", rop);
+  mpfr_clears(constant, x_lower, x_upper, rop, expected, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(S);
+  mp_odrf_arena_free(arena);
+  fine();
+}
+static void
+test_minimum_step (void)
+/* With a tolerance  of 2^-20 Brent's driver stops  narrowing the bracket
+   long before it can be rounded to 64 bits: the solve must not loop. */
+{
+  prec_record_t			record = { 0 };
+  mp_odrf_mpfr_function_t	F = {
+    .function	= square_minus_two_function,
+    .params	= &record
+  };
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  mpfr_t			x_lower, x_upper, tol, rop, expected;
+  int				rv, ternary;
+  start("minimum step", mp_odrf_mpfr_root_fsolver_brent->name);
+  S = mp_odrf_mpfr_root_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_brent, PREC);
+  if (NULL == S) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits2(PREC, x_lower, x_upper, tol, (mpfr_ptr)0);
+  mpfr_inits2(64, rop, expected, (mpfr_ptr)0);
+  mpfr_set_ui_2exp(tol, 1, -20, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_brent_set_tolerance(S, tol);
+  validate(MP_ODRF_OK == rv, "error setting the tolerance: %s", mp_odrf_strerror(rv));
+  mpfr_set_ui(x_lower, 1, GMP_RNDN);
+  mpfr_set_ui(x_upper, 2, GMP_RNDN);
+  rv = mp_odrf_mpfr_root_fsolver_solve_rounded(S, &F, x_lower, x_upper, rop, &ternary, GMP_RNDN);
+  if (MP_ODRF_OK == rv) {
+    mpfr_sqrt_ui(expected, 2, GMP_RNDN);
+    validate(mpfr_equal_p(expected, rop), "wrong root %.20RNf", rop);
+  } else {
+    validate(MP_ODRF_ERROR_ROUNDING_IS_UNDECIDED == rv, "expected %s, got %s",
+	     mp_odrf_strerror(MP_ODRF_ERROR_ROUNDING_IS_UNDECIDED), mp_odrf_strerror(rv));
+  }
+  mpfr_clears(x_lower, x_upper, tol, rop, expected, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(S);
+  fine();
+}
+
+
+/** --------------------------------------------------------------------
+ ** Helpers.
+ ** ----------------------------------------------------------------- */
+
+static int
+sign_of (int ternary)
+{
+  return (ternary > 0) - (ternary < 0);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Math functions.
+ ** ----------------------------------------------------------------- */
+
+static int
+square_minus_two_function (mpfr_t y, mpfr_t x, void * params_)
+/* The square is  computed exactly, so the sign of  the result is right
+   whatever the precision of Y. */
+{
+  prec_record_t *	record = params_;
+  mpfr_t		t;
+  if (record->max_prec < mpfr_get_prec(x))
+    record->max_prec = mpfr_get_prec(x);
+  mpfr_init2(t, 2 * mpfr_get_prec(x));
+  mpfr_sqr(t, x, GMP_RNDN);
+  mpfr_sub_ui(y, t, 2, GMP_RNDN);
+  mpfr_clear(t);
+  return MP_ODRF_OK;
+}
+static int
+minus_constant_function (mpfr_t y, mpfr_t x, void * params_)
+/* The subtraction is correctly rounded, so the sign is right. */
+{
+  mpfr_ptr	constant = params_;
+  mpfr_sub(y, x, constant, GMP_RNDN);
+  return MP_ODRF_OK;
+}
+
+/* end of file */
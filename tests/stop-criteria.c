@@ -0,0 +1,508 @@
+/*
+   Part of: Multiple Precision One-Dimensional Root-Finding
+   Contents: tests for the convergence tests and stop criteria
+   Date: Fri Oct 16, 2026
+
+   Abstract
+
+	Tests for the convergence tests and the stop criterion objects.
+
+   Copyright (c) 2014 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+   This program is free software:  you can redistribute it and/or modify
+   it under the terms of the  GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at
+   your option) any later version.
+
+   This program is  distributed in the hope that it  will be useful, but
+   WITHOUT  ANY   WARRANTY;  without   even  the  implied   warranty  of
+   MERCHANTABILITY  or FITNESS FOR  A PARTICULAR  PURPOSE.  See  the GNU
+   General Public License for more details.
+
+   You should  have received a  copy of  the GNU General  Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#define DEBUGGING		0
+#include <mp-odrf.h>
+#include <test.h>
+#include <debug.h>
+
+static void test_interval	(void);
+static void test_delta		(void);
+static void test_residual	(void);
+static void test_non_finite	(void);
+static void test_fsolver_stop	(const mp_odrf_mpfr_root_fsolver_driver_t * T,
+				 mp_odrf_stop_kind_t kind, const char * description);
+static void test_fdfsolver_stop	(const mp_odrf_mpfr_root_fdfsolver_driver_t * T,
+				 mp_odrf_stop_kind_t kind, const char * description);
+static void test_adaptive_delta	(void);
+static void test_max_iterations	(void);
+static void test_ball_residual	(void);
+
+static mp_odrf_mpfr_wrapped_f_t		sine_function;
+static mp_odrf_mpfr_ball_f_t		sine_ball_function;
+static mp_odrf_mpfr_wrapped_f_t		cosine_function;
+static mp_odrf_mpfr_wrapped_fdf_t	sine_and_cosine_function;
+
+
+/** --------------------------------------------------------------------
+ ** Main.
+ ** ----------------------------------------------------------------- */
+
+int
+main (void)
+{
+  title("convergence tests");
+  test_interval();
+  test_delta();
+  test_residual();
+  test_non_finite();
+
+  title("stop criteria");
+  test_fsolver_stop(mp_odrf_mpfr_root_fsolver_bisection, MP_ODRF_STOP_INTERVAL, "bisection, interval");
+  test_fsolver_stop(mp_odrf_mpfr_root_fsolver_falsepos,  MP_ODRF_STOP_DELTA,    "falsepos, delta");
+  test_fsolver_stop(mp_odrf_mpfr_root_fsolver_brent,     MP_ODRF_STOP_RESIDUAL, "brent, residual");
+  test_fsolver_stop(mp_odrf_mpfr_root_fsolver_brent,     MP_ODRF_STOP_INTERVAL, "brent, interval");
+  test_fdfsolver_stop(mp_odrf_mpfr_root_fdfsolver_newton,     MP_ODRF_STOP_DELTA,    "newton, delta");
+  test_fdfsolver_stop(mp_odrf_mpfr_root_fdfsolver_secant,     MP_ODRF_STOP_RESIDUAL, "secant, residual");
+  test_fdfsolver_stop(mp_odrf_mpfr_root_fdfsolver_steffenson, MP_ODRF_STOP_DELTA,    "steffenson, delta");
+  test_adaptive_delta();
+  test_max_iterations();
+  test_ball_residual();
+
+  exit(EXIT_SUCCESS);
+}
+
+
+/** --------------------------------------------------------------------
+ ** Convergence tests.
+ ** ----------------------------------------------------------------- */
+
+#define CHECK(EXPECTED, EXPR)						\
+  do {									\
+    int	rv = (EXPR);							\
+    validate((EXPECTED) == rv, "%s: expected %s, got %s", #EXPR,	\
+	     mp_odrf_strerror(EXPECTED), mp_odrf_strerror(rv));		\
+  } while (0)
+
+static void
+test_interval (void)
+{
+  mpfr_t	lo, up, epsabs, epsrel;
+  start("interval", "exponents and arithmetic");
+  mpfr_inits(lo, up, epsabs, epsrel, (mpfr_ptr)0);
+  {
+    mpfr_set_d(epsabs, 1e-3, GMP_RNDN);
+    mpfr_set_d(epsrel, 0.0,  GMP_RNDN);
+    /* Straddling, decided by the exponents. */
+    mpfr_set_d(lo, -1e-5, GMP_RNDN);
+    mpfr_set_d(up,  1e-5, GMP_RNDN);
+    CHECK(MP_ODRF_OK,       mp_odrf_mpfr_root_test_interval(lo, up, epsabs, epsrel));
+    mpfr_set_d(lo, -1.0, GMP_RNDN);
+    CHECK(MP_ODRF_CONTINUE, mp_odrf_mpfr_root_test_interval(lo, up, epsabs, epsrel));
+    /* Straddling, decided by the arithmetic. */
+    mpfr_set_d(lo, -0.0004, GMP_RNDN);
+    mpfr_set_d(up,  0.0004, GMP_RNDN);
+    CHECK(MP_ODRF_OK,       mp_odrf_mpfr_root_test_interval(lo, up, epsabs, epsrel));
+    mpfr_set_d(up,  0.0007, GMP_RNDN);
+    CHECK(MP_ODRF_CONTINUE, mp_odrf_mpfr_root_test_interval(lo, up, epsabs, epsrel));
+    /* Same sign, relative tolerance. */
+    mpfr_set_d(epsabs, 0.0,   GMP_RNDN);
+    mpfr_set_d(epsrel, 1e-6,  GMP_RNDN);
+    mpfr_set_d(lo, 1000.0,    GMP_RNDN);
+    mpfr_set_d(up, 1000.0005, GMP_RNDN);
+    CHECK(MP_ODRF_OK,       mp_odrf_mpfr_root_test_interval(lo, up, epsabs, epsrel));
+    mpfr_set_d(up, 1000.002,  GMP_RNDN);
+    CHECK(MP_ODRF_CONTINUE, mp_odrf_mpfr_root_test_interval(lo, up, epsabs, epsrel));
+    /* Errors. */
+    CHECK(MP_ODRF_ERROR_LOWER_BOUND_LARGER_THAN_UPPER_BOUND,
+	  mp_odrf_mpfr_root_test_interval(up, lo, epsabs, epsrel));
+    mpfr_set_d(epsrel, -1.0, GMP_RNDN);
+    CHECK(MP_ODRF_ERROR_RELATIVE_TOLERANCE_IS_NEGATIVE,
+	  mp_odrf_mpfr_root_test_interval(lo, up, epsabs, epsrel));
+  }
+  mpfr_clears(lo, up, epsabs, epsrel, (mpfr_ptr)0);
+  fine();
+}
+static void
+test_delta (void)
+{
+  mpfr_t	x1, x0, epsabs, epsrel;
+  start("delta", "exponents and arithmetic");
+  mpfr_inits(x1, x0, epsabs, epsrel, (mpfr_ptr)0);
+  {
+    mpfr_set_d(epsabs, 1e-3, GMP_RNDN);
+    mpfr_set_d(epsrel, 1e-6, GMP_RNDN);
+    mpfr_set_d(x1,  1.0, GMP_RNDN);
+    mpfr_set_d(x0,  1.0, GMP_RNDN);
+    CHECK(MP_ODRF_OK,       mp_odrf_mpfr_root_test_delta(x1, x0, epsabs, epsrel));
+    mpfr_set_d(x0, -1.0, GMP_RNDN);
+    CHECK(MP_ODRF_CONTINUE, mp_odrf_mpfr_root_test_delta(x1, x0, epsabs, epsrel));
+    mpfr_set_d(x1,  0.0001, GMP_RNDN);
+    mpfr_set_d(x0, -0.0001, GMP_RNDN);
+    CHECK(MP_ODRF_OK,       mp_odrf_mpfr_root_test_delta(x1, x0, epsabs, epsrel));
+    mpfr_set_d(x1,  2.0,    GMP_RNDN);
+    mpfr_set_d(x0,  2.0009, GMP_RNDN);
+    CHECK(MP_ODRF_OK,       mp_odrf_mpfr_root_test_delta(x1, x0, epsabs, epsrel));
+    mpfr_set_d(x0,  2.0011, GMP_RNDN);
+    CHECK(MP_ODRF_CONTINUE, mp_odrf_mpfr_root_test_delta(x1, x0, epsabs, epsrel));
+    mpfr_set_d(epsabs, -1.0, GMP_RNDN);
+    CHECK(MP_ODRF_ERROR_ABSOLUTE_TOLERANCE_IS_NEGATIVE,
+	  mp_odrf_mpfr_root_test_delta(x1, x0, epsabs, epsrel));
+  }
+  mpfr_clears(x1, x0, epsabs, epsrel, (mpfr_ptr)0);
+  fine();
+}
+static void
+test_residual (void)
+{
+  mpfr_t	f, epsabs;
+  start("residual", "exponents and arithmetic");
+  mpfr_inits(f, epsabs, (mpfr_ptr)0);
+  {
+    mpfr_set_d(epsabs, 0.75, GMP_RNDN);
+    mpfr_set_d(f, 0.0,   GMP_RNDN);
+    CHECK(MP_ODRF_OK,       mp_odrf_mpfr_root_test_residual(f, epsabs));
+    mpfr_set_d(f, -0.25, GMP_RNDN);
+    CHECK(MP_ODRF_OK,       mp_odrf_mpfr_root_test_residual(f, epsabs));
+    mpfr_set_d(f, -0.7,  GMP_RNDN);
+    CHECK(MP_ODRF_OK,       mp_odrf_mpfr_root_test_residual(f, epsabs));
+    mpfr_set_d(f,  0.75, GMP_RNDN);
+    CHECK(MP_ODRF_CONTINUE, mp_odrf_mpfr_root_test_residual(f, epsabs));
+    mpfr_set_d(f,  1.5,  GMP_RNDN);
+    CHECK(MP_ODRF_CONTINUE, mp_odrf_mpfr_root_test_residual(f, epsabs));
+  }
+  mpfr_clears(f, epsabs, (mpfr_ptr)0);
+  fine();
+}
+static void
+test_non_finite (void)
+/* NaN and infinities must not reach the exponent shortcuts. */
+{
+  mpfr_t	a, b, epsabs, epsrel;
+  start("non-finite", "NaN and infinities");
+  mpfr_inits(a, b, epsabs, epsrel, (mpfr_ptr)0);
+  {
+    mpfr_set_d(epsabs, 1e-3, GMP_RNDN);
+    mpfr_set_d(epsrel, 1e-6, GMP_RNDN);
+    /* Interval. */
+    mpfr_set_inf(a, -1);
+    mpfr_set_d(b, 1.0, GMP_RNDN);
+    CHECK(MP_ODRF_CONTINUE, mp_odrf_mpfr_root_test_interval(a, b, epsabs, epsrel));
+    mpfr_set_nan(a);
+    CHECK(MP_ODRF_CONTINUE, mp_odrf_mpfr_root_test_interval(a, b, epsabs, epsrel));
+    mpfr_set_nan(b);
+    CHECK(MP_ODRF_CONTINUE, mp_odrf_mpfr_root_test_interval(a, b, epsabs, epsrel));
+    mpfr_set_d(a, -1e-5, GMP_RNDN);
+    mpfr_set_d(b,  1e-5, GMP_RNDN);
+    mpfr_set_inf(epsabs, +1);
+    CHECK(MP_ODRF_OK,       mp_odrf_mpfr_root_test_interval(a, b, epsabs, epsrel));
+    mpfr_set_d(epsabs, 1e-3, GMP_RNDN);
+    /* Delta. */
+    mpfr_set_inf(a, +1);
+    mpfr_set_d(b, -1.0, GMP_RNDN);
+    CHECK(MP_ODRF_CONTINUE, mp_odrf_mpfr_root_test_delta(a, b, epsabs, epsrel));
+    mpfr_set_nan(a);
+    CHECK(MP_ODRF_CONTINUE, mp_odrf_mpfr_root_test_delta(a, b, epsabs, epsrel));
+    CHECK(MP_ODRF_CONTINUE, mp_odrf_mpfr_root_test_delta(a, a, epsabs, epsrel));
+    /* Residual. */
+    mpfr_set_nan(a);
+    CHECK(MP_ODRF_CONTINUE, mp_odrf_mpfr_root_test_residual(a, epsabs));
+    mpfr_set_inf(a, +1);
+    CHECK(MP_ODRF_CONTINUE, mp_odrf_mpfr_root_test_residual(a, epsabs));
+    mpfr_set_inf(a, -1);
+    CHECK(MP_ODRF_CONTINUE, mp_odrf_mpfr_root_test_residual(a, epsabs));
+    mpfr_set_d(a, 1e6, GMP_RNDN);
+    mpfr_set_inf(epsabs, +1);
+    CHECK(MP_ODRF_OK,       mp_odrf_mpfr_root_test_residual(a, epsabs));
+  }
+  mpfr_clears(a, b, epsabs, epsrel, (mpfr_ptr)0);
+  fine();
+}
+
+
+/** --------------------------------------------------------------------
+ ** Stop criteria.
+ ** ----------------------------------------------------------------- */
+
+static void
+test_fsolver_stop (const mp_odrf_mpfr_root_fsolver_driver_t * T,
+		   mp_odrf_stop_kind_t kind, const char * description)
+{
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  mp_odrf_stop_t		C;
+  mp_odrf_mpfr_function_t	F = {
+    .function	= sine_function,
+    .params	= NULL
+  };
+  mpfr_t	x_lower, x_upper, epsabs, epsrel, zero;
+  int		rv, round;
+  start("fsolver", description);
+  S = mp_odrf_mpfr_root_fsolver_alloc(T);
+  if (NULL == S) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits(x_lower, x_upper, epsabs, epsrel, zero, (mpfr_ptr)0);
+  mpfr_set_d(x_lower, -1.0,  GMP_RNDN);
+  mpfr_set_d(x_upper,  0.5,  GMP_RNDN);
+  mpfr_set_d(epsabs,   1e-12, GMP_RNDN);
+  mpfr_set_d(epsrel,   0.0,  GMP_RNDN);
+  mpfr_set_d(zero,     0.0,  GMP_RNDN);
+  rv = mp_odrf_stop_init(&C, kind, epsabs, epsrel, 1000);
+  validate(MP_ODRF_OK == rv, "error initialising criterion: %s", mp_odrf_strerror(rv));
+  /* Solve twice to exercise the reset. */
+  for (round=0; (MP_ODRF_OK == rv) && (round < 2); ++round) {
+    mp_odrf_stop_reset(&C);
+    rv = mp_odrf_mpfr_root_fsolver_set(S, &F, x_lower, x_upper);
+    while (MP_ODRF_OK == rv) {
+      rv = mp_odrf_mpfr_root_fsolver_iterate(S);
+      if (MP_ODRF_OK == rv)
+	rv = mp_odrf_stop_fsolver(&C, S);
+      if (MP_ODRF_CONTINUE == rv)
+	rv = MP_ODRF_OK;
+      else
+	break;
+    }
+    validate(MP_ODRF_OK == rv, "error solving: %s", mp_odrf_strerror(rv));
+    validate_expected_got_mpfr(zero, mp_odrf_mpfr_root_fsolver_root(S));
+  }
+  mp_odrf_stop_clear(&C);
+  mpfr_clears(x_lower, x_upper, epsabs, epsrel, zero, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(S);
+  fine();
+}
+static void
+test_adaptive_delta (void)
+/* In adaptive mode the root of the previous iteration must follow the
+   working precision, else  the  differences never fall below a relative
+   tolerance finer than the starting precision. */
+{
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  mp_odrf_stop_t		C;
+  mp_odrf_mpfr_function_t	F = {
+    .function	= cosine_function,
+    .params	= NULL
+  };
+  mpfr_t	x_lower, x_upper, epsabs, epsrel;
+  int		rv, count = 0;
+  start("fsolver", "bisection, delta, adaptive precision");
+  S = mp_odrf_mpfr_root_fsolver_alloc2(mp_odrf_mpfr_root_fsolver_bisection, 256);
+  if (NULL == S) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  rv = mp_odrf_mpfr_root_fsolver_set_adaptive_prec(S, 32);
+  validate(MP_ODRF_OK == rv, "error selecting adaptive mode: %s", mp_odrf_strerror(rv));
+  mpfr_inits2(256, x_lower, x_upper, epsabs, epsrel, (mpfr_ptr)0);
+  mpfr_set_ui(x_lower, 1, GMP_RNDN);
+  mpfr_set_ui(x_upper, 2, GMP_RNDN);
+  mpfr_set_ui(epsabs,  0, GMP_RNDN);
+  mpfr_set_ui_2exp(epsrel, 1, -100, GMP_RNDN);
+  rv = mp_odrf_stop_init(&C, MP_ODRF_STOP_DELTA, epsabs, epsrel, 1000);
+  validate(MP_ODRF_OK == rv, "error initialising criterion: %s", mp_odrf_strerror(rv));
+  rv = mp_odrf_mpfr_root_fsolver_set(S, &F, x_lower, x_upper);
+  while (MP_ODRF_OK == rv) {
+    rv = mp_odrf_mpfr_root_fsolver_iterate(S);
+    ++count;
+    if (MP_ODRF_OK == rv)
+      rv = mp_odrf_stop_fsolver(&C, S);
+    if (MP_ODRF_CONTINUE == rv)
+      rv = MP_ODRF_OK;
+    else
+      break;
+  }
+  validate(MP_ODRF_OK == rv, "error solving: %s", mp_odrf_strerror(rv));
+  validate(count < 110, "stopped after %d iterations", count);
+  mp_odrf_stop_clear(&C);
+  mpfr_clears(x_lower, x_upper, epsabs, epsrel, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(S);
+  fine();
+}
+static void
+test_fdfsolver_stop (const mp_odrf_mpfr_root_fdfsolver_driver_t * T,
+		     mp_odrf_stop_kind_t kind, const char * description)
+{
+  mp_odrf_mpfr_root_fdfsolver_t *	S;
+  mp_odrf_stop_t			C;
+  mp_odrf_mpfr_function_fdf_t	FDF = {
+    .f		= sine_function,
+    .df		= cosine_function,
+    .fdf	= sine_and_cosine_function,
+    .params	= NULL
+  };
+  mpfr_t	guess, epsabs, zero;
+  int		rv;
+  start("fdfsolver", description);
+  S = mp_odrf_mpfr_root_fdfsolver_alloc(T);
+  if (NULL == S) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits(guess, epsabs, zero, (mpfr_ptr)0);
+  mpfr_set_d(guess,  0.5,   GMP_RNDN);
+  mpfr_set_d(epsabs, 1e-12, GMP_RNDN);
+  mpfr_set_d(zero,   0.0,   GMP_RNDN);
+  rv = mp_odrf_stop_init(&C, kind, epsabs, NULL, 1000);
+  validate(MP_ODRF_OK == rv, "error initialising criterion: %s", mp_odrf_strerror(rv));
+  if (MP_ODRF_OK == rv) {
+    mp_odrf_stop_reset(&C);
+    rv = mp_odrf_mpfr_root_fdfsolver_set(S, &FDF, guess);
+    while (MP_ODRF_OK == rv) {
+      rv = mp_odrf_mpfr_root_fdfsolver_iterate(S);
+      if (MP_ODRF_OK == rv)
+	rv = mp_odrf_stop_fdfsolver(&C, S);
+      if (MP_ODRF_CONTINUE == rv)
+	rv = MP_ODRF_OK;
+      else
+	break;
+    }
+    validate(MP_ODRF_OK == rv, "error solving: %s", mp_odrf_strerror(rv));
+    validate_expected_got_mpfr(zero, mp_odrf_mpfr_root_fdfsolver_root(S));
+    mp_odrf_stop_clear(&C);
+  }
+  mpfr_clears(guess, epsabs, zero, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fdfsolver_free(S);
+  fine();
+}
+static void
+test_max_iterations (void)
+{
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  mp_odrf_stop_t		C;
+  mp_odrf_mpfr_function_t	F = {
+    .function	= sine_function,
+    .params	= NULL
+  };
+  mpfr_t	x_lower, x_upper, epsabs;
+  int		rv;
+  start("max iterations", "bisection with zero tolerance");
+  S = mp_odrf_mpfr_root_fsolver_alloc(mp_odrf_mpfr_root_fsolver_bisection);
+  if (NULL == S) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits(x_lower, x_upper, epsabs, (mpfr_ptr)0);
+  mpfr_set_d(x_lower, -1.0, GMP_RNDN);
+  mpfr_set_d(x_upper,  0.5, GMP_RNDN);
+  mpfr_set_d(epsabs,   0.0, GMP_RNDN);
+  rv = mp_odrf_stop_init(&C, MP_ODRF_STOP_INTERVAL, epsabs, NULL, 10);
+  validate(MP_ODRF_OK == rv, "error initialising criterion: %s", mp_odrf_strerror(rv));
+  rv = mp_odrf_mpfr_root_fsolver_set(S, &F, x_lower, x_upper);
+  while (MP_ODRF_OK == rv) {
+    rv = mp_odrf_mpfr_root_fsolver_iterate(S);
+    if (MP_ODRF_OK == rv)
+      rv = mp_odrf_stop_fsolver(&C, S);
+    if (MP_ODRF_CONTINUE == rv)
+      rv = MP_ODRF_OK;
+  }
+  validate(MP_ODRF_ERROR_MAX_ITERATIONS_REACHED == rv, "expected %s, got %s",
+	   mp_odrf_strerror(MP_ODRF_ERROR_MAX_ITERATIONS_REACHED), mp_odrf_strerror(rv));
+  validate(10 == C.iterations, "expected 10 iterations, got %lu", C.iterations);
+  mpfr_set_d(epsabs, -1.0, GMP_RNDN);
+  validate(MP_ODRF_ERROR_ABSOLUTE_TOLERANCE_IS_NEGATIVE ==
+	   mp_odrf_stop_init(&C, MP_ODRF_STOP_RESIDUAL, epsabs, NULL, 0),
+	   "negative tolerance accepted");
+  mp_odrf_stop_clear(&C);
+  mpfr_clears(x_lower, x_upper, epsabs, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(S);
+  fine();
+}
+static void
+test_ball_residual (void)
+/* With a ball function the residual must be  proven: |mid|+rad below the
+   tolerance.  A tolerance below the radius is never reached: the sign
+   becomes uncertain first. */
+{
+  mp_odrf_mpfr_root_fsolver_t *	S;
+  mp_odrf_stop_t		C;
+  mp_odrf_mpfr_function_t	F = {
+    .function	= sine_function,
+    .params	= NULL,
+    .hinted	= NULL,
+    .sign	= NULL,
+    .ball	= sine_ball_function
+  };
+  mpfr_t	x_lower, x_upper, epsabs, bound;
+  int		rv, i;
+  start("ball residual", "bisection with a ball function");
+  S = mp_odrf_mpfr_root_fsolver_alloc(mp_odrf_mpfr_root_fsolver_bisection);
+  if (NULL == S) {
+    perror("error initialising solver");
+    exit(EXIT_FAILURE);
+  }
+  mpfr_inits(x_lower, x_upper, epsabs, bound, (mpfr_ptr)0);
+  mpfr_set_d(x_lower, -1.0, GMP_RNDN);
+  mpfr_set_d(x_upper,  0.5, GMP_RNDN);
+  for (i=0; i<2; ++i) {
+    mpfr_set_ui_2exp(epsabs, 1, (0 == i)? -10 : -30, GMP_RNDN);
+    rv = mp_odrf_stop_init(&C, MP_ODRF_STOP_RESIDUAL, epsabs, NULL, 1000);
+    validate(MP_ODRF_OK == rv, "error initialising criterion: %s", mp_odrf_strerror(rv));
+    rv = mp_odrf_mpfr_root_fsolver_set(S, &F, x_lower, x_upper);
+    while (MP_ODRF_OK == rv) {
+      rv = mp_odrf_mpfr_root_fsolver_iterate(S);
+      if (MP_ODRF_OK == rv)
+	rv = mp_odrf_stop_fsolver(&C, S);
+      if (MP_ODRF_CONTINUE == rv)
+	rv = MP_ODRF_OK;
+      else
+	break;
+    }
+    if (0 == i) {
+      validate(MP_ODRF_OK == rv, "error solving: %s", mp_odrf_strerror(rv));
+      mpfr_sin(bound, mp_odrf_mpfr_root_fsolver_root(S), GMP_RNDN);
+      mpfr_abs(bound, bound, GMP_RNDU);
+      mpfr_add_d(bound, bound, 0x1p-20, GMP_RNDU);
+      validate(mpfr_less_p(bound, epsabs), "residual not proven");
+    } else {
+      validate(MP_ODRF_ERROR_SIGN_IS_UNCERTAIN == rv, "expected %s, got %s",
+	       mp_odrf_strerror(MP_ODRF_ERROR_SIGN_IS_UNCERTAIN), mp_odrf_strerror(rv));
+    }
+    mp_odrf_stop_clear(&C);
+  }
+  mpfr_clears(x_lower, x_upper, epsabs, bound, (mpfr_ptr)0);
+  mp_odrf_mpfr_root_fsolver_free(S);
+  fine();
+}
+
+
+/** --------------------------------------------------------------------
+ ** Math functions.
+ ** ----------------------------------------------------------------- */
+
+static int
+sine_function (mpfr_t y, mpfr_t x, void * params_ MP_ODRF_UNUSED)
+{
+  mpfr_sin(y, x, GMP_RNDN);
+  return MP_ODRF_OK;
+}
+static int
+sine_ball_function (mpfr_ptr mid, mpfr_ptr rad, mpfr_ptr x, void * params_ MP_ODRF_UNUSED)
+/* A pessimistic ball: the radius is always 2^-20. */
+{
+  mpfr_sin(mid, x, GMP_RNDN);
+  mpfr_set_ui_2exp(rad, 1, -20, GMP_RNDU);
+  return MP_ODRF_OK;
+}
+static int
+cosine_function (mpfr_t y, mpfr_t x, void * params_ MP_ODRF_UNUSED)
+{
+  mpfr_cos(y, x, GMP_RNDN);
+  return MP_ODRF_OK;
+}
+static int
+sine_and_cosine_function (mpfr_t dy, mpfr_t y, mpfr_t x,
+			  void * params_ MP_ODRF_UNUSED)
+{
+  mpfr_sin(y,  x, GMP_RNDN);
+  mpfr_cos(dy, x, GMP_RNDN);
+  return MP_ODRF_OK;
+}
+
+/* end of file */